@@ -21,12 +21,13 @@ bool CPlugin_001(CPlugin::Function function, struct EventStruct *event, String&
     case CPlugin::Function::CPLUGIN_PROTOCOL_ADD:
     {
       ProtocolStruct& proto = getProtocolStruct(event->idx); //      = CPLUGIN_ID_001;
-      proto.usesMQTT     = false;
-      proto.usesAccount  = true;
-      proto.usesPassword = true;
-      proto.usesExtCreds = true;
-      proto.defaultPort  = 8080;
-      proto.usesID       = true;
+      proto.usesMQTT        = false;
+      proto.usesAccount     = true;
+      proto.usesPassword    = true;
+      proto.usesExtCreds    = true;
+      proto.defaultPort     = 8080;
+      proto.usesID          = true;
+      proto.allowsBatchSend = true;
       break;
     }
 
@@ -100,7 +101,7 @@ bool CPlugin_001(CPlugin::Function function, struct EventStruct *event, String&
           url += mapVccToDomoticz();
             # endif // if FEATURE_ADC_VCC
 
-          std::unique_ptr<C001_queue_element> element(new C001_queue_element(event->ControllerIndex, event->TaskIndex, std::move(url)));
+          std::unique_ptr<C001_queue_element> element(new (C001_DelayHandler->pool) C001_queue_element(event->ControllerIndex, event->TaskIndex, std::move(url)));
 
           success = C001_DelayHandler->addToQueue(std::move(element));
           Scheduler.scheduleNextDelayQueue(SchedulerIntervalTimer_e::TIMER_C001_DELAY_QUEUE,
@@ -18,11 +18,12 @@ bool CPlugin_003(CPlugin::Function function, struct EventStruct *event, String&
     case CPlugin::Function::CPLUGIN_PROTOCOL_ADD:
     {
       ProtocolStruct& proto = getProtocolStruct(event->idx); //      = CPLUGIN_ID_003;
-      proto.usesMQTT     = false;
-      proto.usesAccount  = false;
-      proto.usesPassword = true;
-      proto.defaultPort  = 23;
-      proto.usesID       = true;
+      proto.usesMQTT        = false;
+      proto.usesAccount     = false;
+      proto.usesPassword    = true;
+      proto.defaultPort     = 23;
+      proto.usesID          = true;
+      proto.allowsBatchSend = true;
       break;
     }
 
@@ -59,7 +60,7 @@ bool CPlugin_003(CPlugin::Function function, struct EventStruct *event, String&
         event->idx,
         formatUserVarNoCheck(event, 0).c_str());
       std::unique_ptr<C003_queue_element> element(
-        new C003_queue_element(
+        new (C003_DelayHandler->pool) C003_queue_element(
           event->ControllerIndex, 
           event->TaskIndex, 
           std::move(url)));
@@ -3,6 +3,7 @@
 
 # include "src/Commands/ExecuteCommand.h"
 # include "src/Globals/EventQueue.h"
+# include "src/Helpers/ControllerTopicCache.h"
 # include "src/Helpers/PeriodicalActions.h"
 # include "src/Helpers/StringParser.h"
 # include "_Plugin_Helper.h"
@@ -18,6 +19,9 @@
 String CPlugin_005_pubname;
 bool   CPlugin_005_mqtt_retainFlag = false;
 
+// Publish topic per task value, compiled at init
+ControllerTopicCache C005_topicCache;
+
 bool C005_parse_command(struct EventStruct *event);
 
 bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String& string)
@@ -29,13 +33,14 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
     case CPlugin::Function::CPLUGIN_PROTOCOL_ADD:
     {
       ProtocolStruct& proto = getProtocolStruct(event->idx); //      = CPLUGIN_ID_005;
-      proto.usesMQTT     = true;
-      proto.usesTemplate = true;
-      proto.usesAccount  = true;
-      proto.usesPassword = true;
-      proto.usesExtCreds = true;
-      proto.defaultPort  = 1883;
-      proto.usesID       = false;
+      proto.usesMQTT        = true;
+      proto.usesTemplate    = true;
+      proto.usesAccount     = true;
+      proto.usesPassword    = true;
+      proto.usesExtCreds    = true;
+      proto.defaultPort     = 1883;
+      proto.usesID          = false;
+      proto.allowsBatchSend = true;
       break;
     }
 
@@ -48,12 +53,18 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
     case CPlugin::Function::CPLUGIN_INIT:
     {
       success = init_mqtt_delay_queue(event->ControllerIndex, CPlugin_005_pubname, CPlugin_005_mqtt_retainFlag);
+
+      if (success) {
+        C005_topicCache.setTemplate(event->ControllerIndex, CPlugin_005_pubname);
+        C005_topicCache.fill(event->ControllerIndex);
+      }
       break;
     }
 
     case CPlugin::Function::CPLUGIN_EXIT:
     {
       exit_mqtt_delay_queue();
+      C005_topicCache.clear();
       break;
     }
 
@@ -81,11 +92,11 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
       }
 
 
-      String pubname         = CPlugin_005_pubname;
+      // Only used when the topic cannot be taken from the topic cache.
+      String pubname;
+      bool   pubname_parsed  = false;
       bool   mqtt_retainFlag = CPlugin_005_mqtt_retainFlag;
 
-      parseControllerVariables(pubname, event, false);
-
       uint8_t valueCount = getValueCountForTask(event->TaskIndex);
 
       for (uint8_t x = 0; x < valueCount; x++)
@@ -95,8 +106,17 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
           continue; // we skip values with empty labels
         }
 
-        String tmppubname = pubname;
-        parseSingleControllerVariable(tmppubname, event, x, false);
+        String tmppubname;
+
+        if (!C005_topicCache.render(event, x, tmppubname)) {
+          if (!pubname_parsed) {
+            pubname = CPlugin_005_pubname;
+            parseControllerVariables(pubname, event, false);
+            pubname_parsed = true;
+          }
+          tmppubname = pubname;
+          parseSingleControllerVariable(tmppubname, event, x, false);
+        }
         String value;
         if (event->sensorType == Sensor_VType::SENSOR_TYPE_STRING) {
           value = event->String2.substring(0, 20); // For the log
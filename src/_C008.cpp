@@ -19,13 +19,14 @@ bool CPlugin_008(CPlugin::Function function, struct EventStruct *event, String&
     case CPlugin::Function::CPLUGIN_PROTOCOL_ADD:
     {
       ProtocolStruct& proto = getProtocolStruct(event->idx); //      = CPLUGIN_ID_008;
-      proto.usesMQTT     = false;
-      proto.usesTemplate = true;
-      proto.usesAccount  = true;
-      proto.usesPassword = true;
-      proto.usesExtCreds = true;
-      proto.defaultPort  = 80;
-      proto.usesID       = true;
+      proto.usesMQTT        = false;
+      proto.usesTemplate    = true;
+      proto.usesAccount     = true;
+      proto.usesPassword    = true;
+      proto.usesExtCreds    = true;
+      proto.defaultPort     = 80;
+      proto.usesID          = true;
+      proto.allowsBatchSend = true;
       break;
     }
 
@@ -78,50 +79,49 @@ bool CPlugin_008(CPlugin::Function function, struct EventStruct *event, String&
       }
 
       uint8_t valueCount = getValueCountForTask(event->TaskIndex);
-      std::unique_ptr<C008_queue_element> element(new C008_queue_element(event, valueCount));
-      success = C008_DelayHandler->addToQueue(std::move(element));
+      std::unique_ptr<C008_queue_element> element(new (C008_DelayHandler->pool) C008_queue_element(event, valueCount));
 
-      if (success) {
-        // Element was added.
-        // Now we try to append to the existing element
-        // and thus preventing the need to create a long string only to copy it to a queue element.
-        C008_queue_element& element = static_cast<C008_queue_element&>(*(C008_DelayHandler->sendQueue.back()));
+      if (!element) {
+        break;
+      }
 
-        // Collect the values at the same run, to make sure all are from the same sample
-        //LoadTaskSettings(event->TaskIndex); // FIXME TD-er: This can probably be removed
-        parseControllerVariables(pubname, event, true);
+      // Fill in the element before adding it to the queue,
+      // as it may not end up at the back of the RAM queue (e.g. spilled to flash).
+      // Collect the values at the same run, to make sure all are from the same sample
+      //LoadTaskSettings(event->TaskIndex); // FIXME TD-er: This can probably be removed
+      parseControllerVariables(pubname, event, true);
 
-        for (uint8_t x = 0; x < valueCount; x++)
-        {
-          bool   isvalid;
-          const String formattedValue = formatUserVar(event, x , isvalid);
+      for (uint8_t x = 0; x < valueCount; x++)
+      {
+        bool   isvalid;
+        const String formattedValue = formatUserVar(event, x , isvalid);
 
-          if (isvalid) {
-            // First store in a temporary string, so we can use move_special to allocate on the best heap
-            String txt;
-            txt += '/';
-            txt += pubname;
-            parseSingleControllerVariable(txt, event, x, true);
+        if (isvalid) {
+          // First store in a temporary string, so we can use move_special to allocate on the best heap
+          String txt;
+          txt += '/';
+          txt += pubname;
+          parseSingleControllerVariable(txt, event, x, true);
 
 # ifndef BUILD_NO_DEBUG
-            if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-              addLog(LOG_LEVEL_DEBUG, strformat(
-                F("C008 : pubname: %s value: %s"),
-                pubname.c_str(),
-                formattedValue.c_str()
-              ));
-            }
+          if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+            addLog(LOG_LEVEL_DEBUG, strformat(
+              F("C008 : pubname: %s value: %s"),
+              pubname.c_str(),
+              formattedValue.c_str()
+            ));
+          }
 #endif
-            txt.replace(F("%value%"), formattedValue);
-            move_special(element.txt[x], std::move(txt));
+          txt.replace(F("%value%"), formattedValue);
+          move_special(element->txt[x], std::move(txt));
 # ifndef BUILD_NO_DEBUG
-            if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE)) {
-              addLog(LOG_LEVEL_DEBUG_MORE, concat(F("C008 : "), element.txt[x]));
-            }
-# endif // ifndef BUILD_NO_DEBUG
+          if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE)) {
+            addLog(LOG_LEVEL_DEBUG_MORE, concat(F("C008 : "), element->txt[x]));
           }
+# endif // ifndef BUILD_NO_DEBUG
         }
       }
+      success = C008_DelayHandler->addToQueue(std::move(element));
       Scheduler.scheduleNextDelayQueue(SchedulerIntervalTimer_e::TIMER_C008_DELAY_QUEUE, C008_DelayHandler->getNextScheduleTime());
       break;
     }
@@ -80,7 +80,7 @@ bool CPlugin_009(CPlugin::Function function, struct EventStruct *event, String&
           break;
         }
 
-        std::unique_ptr<C009_queue_element> element(new C009_queue_element(event));
+        std::unique_ptr<C009_queue_element> element(new (C009_DelayHandler->pool) C009_queue_element(event));
         success = C009_DelayHandler->addToQueue(std::move(element));
         Scheduler.scheduleNextDelayQueue(SchedulerIntervalTimer_e::TIMER_C009_DELAY_QUEUE, C009_DelayHandler->getNextScheduleTime());
       }
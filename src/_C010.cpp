@@ -18,12 +18,13 @@ bool CPlugin_010(CPlugin::Function function, struct EventStruct *event, String&
     case CPlugin::Function::CPLUGIN_PROTOCOL_ADD:
     {
       ProtocolStruct& proto = getProtocolStruct(event->idx); //      = CPLUGIN_ID_010;
-      proto.usesMQTT     = false;
-      proto.usesTemplate = true;
-      proto.usesAccount  = false;
-      proto.usesPassword = false;
-      proto.defaultPort  = 514;
-      proto.usesID       = false;
+      proto.usesMQTT        = false;
+      proto.usesTemplate    = true;
+      proto.usesAccount     = false;
+      proto.usesPassword    = false;
+      proto.defaultPort     = 514;
+      proto.usesID          = false;
+      proto.allowsBatchSend = true;
       break;
     }
 
@@ -69,7 +70,7 @@ bool CPlugin_010(CPlugin::Function function, struct EventStruct *event, String&
 
       //LoadTaskSettings(event->TaskIndex); // FIXME TD-er: This can probably be removed
 
-      std::unique_ptr<C010_queue_element> element(new C010_queue_element(event, valueCount));
+      std::unique_ptr<C010_queue_element> element(new (C010_DelayHandler->pool) C010_queue_element(event, valueCount));
 
 
       {
@@ -38,6 +38,7 @@ bool load_C011_ConfigStruct(controllerIndex_t ControllerIndex, String& HttpMetho
 boolean Create_schedule_HTTP_C011(struct EventStruct *event);
 void DeleteNotNeededValues(String& s, uint8_t numberOfValuesWanted);
 void ReplaceTokenByValue(String& s, struct EventStruct *event, bool sendBinary);
+size_t do_process_c011_delay_queue_batch(int controller_number, const std::vector<const Queue_element_base *>& batch, ControllerSettingsStruct& ControllerSettings, bool& failed);
 
 
 
@@ -50,12 +51,13 @@ bool CPlugin_011(CPlugin::Function function, struct EventStruct *event, String&
     case CPlugin::Function::CPLUGIN_PROTOCOL_ADD:
     {
       ProtocolStruct& proto = getProtocolStruct(event->idx); //      = CPLUGIN_ID_011;
-      proto.usesMQTT     = false;
-      proto.usesAccount  = true;
-      proto.usesPassword = true;
-      proto.usesExtCreds = true;
-      proto.defaultPort  = 80;
-      proto.usesID       = false;
+      proto.usesMQTT        = false;
+      proto.usesAccount     = true;
+      proto.usesPassword    = true;
+      proto.usesExtCreds    = true;
+      proto.defaultPort     = 80;
+      proto.usesID          = false;
+      proto.allowsBatchSend = true;
       break;
     }
 
@@ -76,6 +78,10 @@ bool CPlugin_011(CPlugin::Function function, struct EventStruct *event, String&
         }
       }
       success = init_c011_delay_queue(event->ControllerIndex);
+
+      if (success) {
+        C011_DelayHandler->setBatchFunction(do_process_c011_delay_queue_batch);
+      }
       break;
     }
 
@@ -119,6 +125,8 @@ bool CPlugin_011(CPlugin::Function function, struct EventStruct *event, String&
         {
           htmlEscape(HttpBody);
           addFormTextArea(F("Body"), F("P011httpbody"), HttpBody, C011_HTTP_BODY_MAX_LEN - 1, 8, 50);
+          addFormNote(F("With Batch Send, the bodies of queued requests are sent in one request, one body per line. "
+                        "The server must accept this, e.g. newline delimited JSON, as it is no valid single JSON document."));
         }
       }
       {
@@ -218,6 +226,86 @@ bool do_process_c011_delay_queue(int controller_number, const Queue_element_base
   return httpCode >= 100 && httpCode < 300;
 }
 
+// Send the bodies of consecutive queued requests with the same method, URI and header
+// as a single request, one body per line.
+// N.B. The bodies are not merged in any other way, so JSON bodies result in newline delimited JSON,
+// which is not a valid single JSON document. Only enable batch send when the server accepts this.
+size_t do_process_c011_delay_queue_batch(int controller_number, const std::vector<const Queue_element_base *>& batch, ControllerSettingsStruct& ControllerSettings, bool& failed) {
+  failed = false;
+
+  if (!NetworkConnected()) {
+    failed = true;
+    return 0;
+  }
+
+  size_t nrProcessed = 0;
+
+  while (nrProcessed < batch.size()) {
+    if ((nrProcessed != 0) && Scheduler.sliceBudgetExceeded()) {
+      break;
+    }
+    const C011_queue_element& first = static_cast<const C011_queue_element&>(*batch[nrProcessed]);
+    size_t nrCombined = 1;
+
+    if (!C011_sendBinary && !first.postStr.isEmpty()) {
+      while ((nrProcessed + nrCombined) < batch.size()) {
+        const C011_queue_element& element = static_cast<const C011_queue_element&>(*batch[nrProcessed + nrCombined]);
+
+        if (element.postStr.isEmpty() ||
+            !element.HttpMethod.equals(first.HttpMethod) ||
+            !element.uri.equals(first.uri) ||
+            !element.header.equals(first.header)) {
+          break;
+        }
+        ++nrCombined;
+      }
+    }
+
+    bool success = false;
+
+    if (nrCombined == 1) {
+      success = do_process_c011_delay_queue(controller_number, first, ControllerSettings);
+    } else {
+      String postStr;
+      size_t totalSize = 0;
+
+      for (size_t i = 0; i < nrCombined; ++i) {
+        totalSize += static_cast<const C011_queue_element&>(*batch[nrProcessed + i]).postStr.length() + 1;
+      }
+
+      if (!postStr.reserve(totalSize)) {
+        // Not enough memory to combine, just send the first one.
+        nrCombined = 1;
+        success    = do_process_c011_delay_queue(controller_number, first, ControllerSettings);
+      } else {
+        for (size_t i = 0; i < nrCombined; ++i) {
+          if (i != 0) { postStr += '\n'; }
+          postStr += static_cast<const C011_queue_element&>(*batch[nrProcessed + i]).postStr;
+        }
+        int httpCode = -1;
+
+        send_via_http(
+          controller_number,
+          ControllerSettings,
+          first._controller_idx,
+          first.uri,
+          first.HttpMethod,
+          first.header,
+          postStr,
+          httpCode);
+        success = httpCode >= 100 && httpCode < 300;
+      }
+    }
+
+    if (!success) {
+      failed = true;
+      break;
+    }
+    nrProcessed += nrCombined;
+  }
+  return nrProcessed;
+}
+
 bool load_C011_ConfigStruct(controllerIndex_t ControllerIndex, String& HttpMethod, String& HttpUri, String& HttpHeader, String& HttpBody) {
   // Just copy the needed strings and destruct the C011_ConfigStruct as soon as possible
   std::shared_ptr<C011_ConfigStruct> customConfig(new (std::nothrow) C011_ConfigStruct);
@@ -245,39 +333,37 @@ boolean Create_schedule_HTTP_C011(struct EventStruct *event)
   }
   //LoadTaskSettings(event->TaskIndex); // FIXME TD-er: This can probably be removed
 
-  // Add a new element to the queue with the minimal payload
-  std::unique_ptr<C011_queue_element> element(new C011_queue_element(event));
-  bool success = C011_DelayHandler->addToQueue(std::move(element));
-
-  if (success) {
-    // Element was added.
-    // Now we try to append to the existing element
-    // and thus preventing the need to create a long string only to copy it to a queue element.
-    C011_queue_element& element = static_cast<C011_queue_element&>(*(C011_DelayHandler->sendQueue.back()));
+  // Create the element and fill it in before adding it to the queue,
+  // as it may not end up at the back of the RAM queue (e.g. spilled to flash).
+  std::unique_ptr<C011_queue_element> element(new (C011_DelayHandler->pool) C011_queue_element(event));
 
+  if (!element) {
+    return false;
+  }
 
-    if (!load_C011_ConfigStruct(event->ControllerIndex, element.HttpMethod, element.uri, element.header, element.postStr))
-    {
-      if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-        addLogMove(LOG_LEVEL_ERROR, strformat(
-          F("C011   : %s %s %s %s"),
-          element.HttpMethod.c_str(),
-          element.uri.c_str(),
-          element.header.c_str(),
-          element.postStr.c_str()));
-      }
-      C011_DelayHandler->sendQueue.pop_back();
-      return false;
+  if (!load_C011_ConfigStruct(event->ControllerIndex, element->HttpMethod, element->uri, element->header, element->postStr))
+  {
+    if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+      addLogMove(LOG_LEVEL_ERROR, strformat(
+        F("C011   : %s %s %s %s"),
+        element->HttpMethod.c_str(),
+        element->uri.c_str(),
+        element->header.c_str(),
+        element->postStr.c_str()));
     }
+    return false;
+  }
 
-    ReplaceTokenByValue(element.uri,    event, false);
-    ReplaceTokenByValue(element.header, event, false);
+  ReplaceTokenByValue(element->uri,    event, false);
+  ReplaceTokenByValue(element->header, event, false);
 
-    if (element.postStr.length() > 0)
-    {
-      ReplaceTokenByValue(element.postStr, event, C011_sendBinary);
-    }
-  } else {
+  if (element->postStr.length() > 0)
+  {
+    ReplaceTokenByValue(element->postStr, event, C011_sendBinary);
+  }
+  const bool success = C011_DelayHandler->addToQueue(std::move(element));
+
+  if (!success) {
     addLog(LOG_LEVEL_ERROR, F("C011  : Could not add to delay handler"));
   }
 
@@ -184,58 +184,57 @@ bool CPlugin_015(CPlugin::Function function, struct EventStruct *event, String&
       // Collect the values at the same run, to make sure all are from the same sample
       uint8_t valueCount = getValueCountForTask(event->TaskIndex);
 
-      std::unique_ptr<C015_queue_element> element(new C015_queue_element(event, valueCount));
-      success = C015_DelayHandler->addToQueue(std::move(element));
+      std::unique_ptr<C015_queue_element> element(new (C015_DelayHandler->pool) C015_queue_element(event, valueCount));
 
-      if (success) {
-        // Element was added.
-        // Now we try to append to the existing element
-        // and thus preventing the need to create a long string only to copy it to a queue element.
-        C015_queue_element& element = static_cast<C015_queue_element&>(*(C015_DelayHandler->sendQueue.back()));
+      if (!element) {
+        break;
+      }
 
-        for (uint8_t x = 0; x < valueCount; x++)
-        {
-          bool   isvalid;
-          String formattedValue = formatUserVar(event, x, isvalid);
+      // Fill in the element before adding it to the queue,
+      // as it may not end up at the back of the RAM queue.
+      for (uint8_t x = 0; x < valueCount; x++)
+      {
+        bool   isvalid;
+        String formattedValue = formatUserVar(event, x, isvalid);
 
-          if (!isvalid) {
-            // send empty string to Blynk in case of error
-            formattedValue = String();
-          }
+        if (!isvalid) {
+          // send empty string to Blynk in case of error
+          formattedValue = String();
+        }
 
-          const String valueName = getTaskValueName(event->TaskIndex, x);
-          const String valueFullName = strformat(
-            F("%s.%s"),          
-            getTaskDeviceName(event->TaskIndex).c_str(),
-            valueName.c_str());
-          const String vPinNumberStr = valueName.substring(1, 4);
-          int    vPinNumber    = vPinNumberStr.toInt();
+        const String valueName = getTaskValueName(event->TaskIndex, x);
+        const String valueFullName = strformat(
+          F("%s.%s"),          
+          getTaskDeviceName(event->TaskIndex).c_str(),
+          valueName.c_str());
+        const String vPinNumberStr = valueName.substring(1, 4);
+        int    vPinNumber    = vPinNumberStr.toInt();
 
-          if ((vPinNumber < 0) || (vPinNumber > 255)) {
-            vPinNumber = -1;
-          }
-          if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-            String log           = F(C015_LOG_PREFIX);
-            log += Blynk.connected() ? F("(online): ") : F("(offline): ");
-
-            if ((vPinNumber > 0) && (vPinNumber < 256)) {
-              log += strformat(
-                F("send %s = %s to blynk pin v%d"),
-                valueFullName.c_str(),
-                formattedValue.c_str(),
-                vPinNumber);
-            } else {
-              log += strformat(
-              F("error got vPin number for %s, got not valid value: %s"),
+        if ((vPinNumber < 0) || (vPinNumber > 255)) {
+          vPinNumber = -1;
+        }
+        if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+          String log           = F(C015_LOG_PREFIX);
+          log += Blynk.connected() ? F("(online): ") : F("(offline): ");
+
+          if ((vPinNumber > 0) && (vPinNumber < 256)) {
+            log += strformat(
+              F("send %s = %s to blynk pin v%d"),
               valueFullName.c_str(),
-              vPinNumberStr.c_str());
-            }
-            addLogMove(LOG_LEVEL_INFO, log);
+              formattedValue.c_str(),
+              vPinNumber);
+          } else {
+            log += strformat(
+            F("error got vPin number for %s, got not valid value: %s"),
+            valueFullName.c_str(),
+            vPinNumberStr.c_str());
           }
-          element.vPin[x] = vPinNumber;
-          move_special(element.txt[x], std::move(formattedValue));
+          addLogMove(LOG_LEVEL_INFO, log);
         }
+        element->vPin[x] = vPinNumber;
+        move_special(element->txt[x], std::move(formattedValue));
       }
+      success = C015_DelayHandler->addToQueue(std::move(element));
       Scheduler.scheduleNextDelayQueue(SchedulerIntervalTimer_e::TIMER_C015_DELAY_QUEUE, C015_DelayHandler->getNextScheduleTime());
       break;
     }
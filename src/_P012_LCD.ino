@@ -27,9 +27,6 @@
 # define PLUGIN_NAME_012       "Display - LCD2004"
 # define PLUGIN_VALUENAME1_012 "LCD"
 
-# define P12_Nlines 4 // The number of different lines which can be displayed
-# define P12_Nchars 80
-
 # define P012_I2C_ADDR    PCONFIG(0)
 # define P012_SIZE        PCONFIG(1)
 # define P012_TIMER       PCONFIG(2)
@@ -212,17 +209,15 @@ boolean Plugin_012(uint8_t function, struct EventStruct *event, String& string)
         static_cast<P012_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if (nullptr != P012_data) {
-        // FIXME TD-er: This is a huge stack allocated object.
-        char deviceTemplate[P12_Nlines][P12_Nchars];
-        LoadCustomTaskSettings(event->TaskIndex, reinterpret_cast<uint8_t *>(&deviceTemplate), sizeof(deviceTemplate));
+        P012_data->loadLineTemplates(event->TaskIndex);
 
-        for (uint8_t x = 0; x < P012_data->Plugin_012_rows; x++)
+        for (uint8_t x = 0; x < P012_data->Plugin_012_rows && x < P12_Nlines; x++)
         {
-          String tmpString = deviceTemplate[x];
+          CompiledTemplate& lineTemplate = P012_data->lineTemplates[x];
 
-          if (tmpString.length())
+          if (lineTemplate.source().length())
           {
-            String newString = P012_data->P012_parseTemplate(tmpString, P012_data->Plugin_012_cols);
+            String newString = P012_data->P012_parseTemplate(lineTemplate, P012_data->Plugin_012_cols);
             P012_data->lcdWrite(newString, 0, x);
           }
         }
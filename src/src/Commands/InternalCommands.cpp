@@ -51,14 +51,15 @@
 #include "../Helpers/StringParser.h"
 
 
-bool checkNrArguments(const char *cmd, const String& Line, int nrArguments) {
+bool checkNrArguments(const char *cmd, const ArgumentTokenizer& tokens, int nrArguments) {
   if (nrArguments < 0) { return true; }
 
   // 0 arguments means argument on pos1 is valid (the command) and argpos 2 should not be there.
-  if (HasArgv(Line.c_str(), nrArguments + 2)) {
+  if (tokens.hasArgument(nrArguments + 2)) {
     #ifndef BUILD_NO_DEBUG
 
     if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+      const char *Line = tokens.c_str();
       String log;
 
       if (log.reserve(128)) {
@@ -99,10 +100,10 @@ bool checkNrArguments(const char *cmd, const String& Line, int nrArguments) {
           }
         }
         log += F(" lineLength=");
-        log += Line.length();
+        log += strlen(Line);
         addLogMove(LOG_LEVEL_ERROR, log);
       }
-      addLogMove(LOG_LEVEL_ERROR, strformat(F("Line: _%s_"), Line.c_str()));
+      addLogMove(LOG_LEVEL_ERROR, strformat(F("Line: _%s_"), Line));
 
       addLogMove(LOG_LEVEL_ERROR, concat(Settings.TolerantLastArgParse() ?
                                          F("Command executed, but may fail.") : F("Command not executed!"),
@@ -127,7 +128,7 @@ bool checkSourceFlags(EventValueSource::Enum source, EventValueSourceGroup::Enum
 }
 
 command_case_data::command_case_data(const char *cmd, struct EventStruct *event, const char *line) :
-  cmd(cmd), event(event), line(line)
+  cmd(cmd), event(event), line(line), tokens(this->line.c_str())
 {
   cmd_lc = cmd;
   cmd_lc.toLowerCase();
@@ -185,7 +186,7 @@ bool do_command_case_check(command_case_data         & data,
   const bool mustCheckNrArguments = data.event->Source != EventValueSource::Enum::VALUE_SOURCE_MQTT;
 
   if (mustCheckNrArguments) {
-    if (!checkNrArguments(data.cmd, data.line, nrArguments)) {
+    if (!checkNrArguments(data.cmd, data.tokens, nrArguments)) {
       data.status = return_incorrect_nr_arguments();
 
       // data.retval = false;
@@ -205,6 +206,7 @@ bool InternalCommands::do_command_case(command_case_data         & data,
     // It has been handled, check if we need to execute it.
     // FIXME TD-er: Must change command function signature to use const String&
     START_TIMER;
+    const ArgumentTokenizer::ActiveScope activeTokens(data.tokens);
     data.status = pFunc(data.event, data.line.c_str());
     STOP_TIMER(COMMAND_EXEC_INTERNAL);
     return true;
@@ -221,6 +223,7 @@ bool InternalCommands::do_command_case(command_case_data         & data,
     // It has been handled, check if we need to execute it.
     // FIXME TD-er: Must change command function signature to use const String&
     START_TIMER;
+    const ArgumentTokenizer::ActiveScope activeTokens(data.tokens);
     data.status = pFunc(data.event, data.line.c_str());
     STOP_TIMER(COMMAND_EXEC_INTERNAL);
     return true;
@@ -302,6 +305,9 @@ bool InternalCommands::executeInternalCommand()
     case ESPEasy_cmd_e::erasesdkwifi:               COMMAND_CASE_R(Command_WiFi_Erase,     0);               // WiFi.h
     case ESPEasy_cmd_e::event:                      COMMAND_CASE_A(Command_Rules_Events,  -1);               // Rule.h
     case ESPEasy_cmd_e::executerules:               COMMAND_CASE_A(Command_Rules_Execute, -1);               // Rule.h
+#if FEATURE_SETTINGS_WRITE_BACK
+    case ESPEasy_cmd_e::flushsettings:              COMMAND_CASE_R(Command_Settings_Flush, 0);               // Settings.h
+#endif // if FEATURE_SETTINGS_WRITE_BACK
     case ESPEasy_cmd_e::gateway:                    COMMAND_CASE_R(Command_Gateway,     1);                  // Network Command
     case ESPEasy_cmd_e::gpio:                       COMMAND_CASE_A(Command_GPIO,        2);                  // Gpio.h
     case ESPEasy_cmd_e::gpiotoggle:                 COMMAND_CASE_A(Command_GPIO_Toggle, 1);                  // Gpio.h
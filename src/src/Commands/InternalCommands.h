@@ -5,6 +5,7 @@
 
 #include "../DataStructs/ESPEasy_EventStruct.h"
 #include "../Globals/Plugins.h"
+#include "../Helpers/ArgumentTokenizer.h"
 
 
 // Simple struct to be used in handling commands.
@@ -15,11 +16,17 @@ struct command_case_data {
                     struct EventStruct *event,
                     const char         *line);
 
+  // Tokenizer refers to the line, so this struct must not be copied.
+  command_case_data(const command_case_data& other) = delete;
+
 
   String              cmd_lc;
   const char         *cmd;
   struct EventStruct *event;
   const String        line;
+
+  // Argument positions in line, parsed once for the nr. of arguments check and the command itself.
+  const ArgumentTokenizer tokens;
   String              status;
   bool                retval = false;
 };
@@ -4,17 +4,14 @@
 #include "../Helpers/StringConverter.h"
 
 // Keep the order of elements in ESPEasy_cmd_e enum
-// the same as in the PROGMEM strings below
+// the same as in the PROGMEM string below.
 //
-// The first item in the PROGMEM strings below should be an enum
-// which is always included in each build as it is used to set an offset
-// to compute the final enum value.
-//
-// Keep the offset used in match_ESPEasy_internal_command in sync
-// when adding new commands
+// Commands are looked up via a perfect hash table, which is generated
+// at compile time from this list. Thus it only contains the commands
+// included in the build.
 
 
-const char Internal_commands_ab[] PROGMEM =
+constexpr char Internal_commands[] PROGMEM =
   "accessinfo|"
   "asyncevent|"
   "build|"
@@ -27,10 +24,7 @@ const char Internal_commands_ab[] PROGMEM =
 #ifdef USES_C015
   "blynkset|"
 #endif // #ifdef USES_C015
-;
 
-#define Int_cmd_c_offset ESPEasy_cmd_e::clearaccessblock
-const char Internal_commands_c[] PROGMEM =
   "clearaccessblock|"
   "clearpassword|"
   "clearrtcram|"
@@ -41,10 +35,7 @@ const char Internal_commands_c[] PROGMEM =
   "config|"
   "controllerdisable|"
   "controllerenable|"
-;
 
-#define Int_cmd_d_offset ESPEasy_cmd_e::datetime
-const char Internal_commands_d[] PROGMEM =
   "datetime|"
   "debug|"
   "dec|"
@@ -55,10 +46,7 @@ const char Internal_commands_d[] PROGMEM =
 #endif // #if FEATURE_PLUGIN_PRIORITY
   "dns|"
   "dst|"
-;
 
-#define Int_cmd_e_offset ESPEasy_cmd_e::erasesdkwifi
-const char Internal_commands_e[] PROGMEM =
   "erasesdkwifi|"
   "event|"
   "executerules|"
@@ -76,10 +64,10 @@ const char Internal_commands_e[] PROGMEM =
   "ethdisconnect|"
   "ethwifimode|"
 #endif // FEATURE_ETHERNET
-;
+#if FEATURE_SETTINGS_WRITE_BACK
+  "flushsettings|"
+#endif // if FEATURE_SETTINGS_WRITE_BACK
 
-#define Int_cmd_ghij_offset ESPEasy_cmd_e::gateway
-const char Internal_commands_ghij[] PROGMEM =
   "gateway|"
   "gpio|"
   "gpiotoggle|"
@@ -93,10 +81,7 @@ const char Internal_commands_ghij[] PROGMEM =
 #ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
   "jsonportstatus|"
 #endif // ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
-;
 
-#define Int_cmd_l_offset ESPEasy_cmd_e::let
-const char Internal_commands_l[] PROGMEM =
   "let|"
   "load|"
   "logentry|"
@@ -108,10 +93,7 @@ const char Internal_commands_l[] PROGMEM =
   "logportstatus|"
   "lowmem|"
 #endif // ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
-;
 
-#define Int_cmd_m_offset ESPEasy_cmd_e::monitor
-const char Internal_commands_m[] PROGMEM =
   "monitor|"
   "monitorrange|"
 #ifdef USES_P009
@@ -130,20 +112,14 @@ const char Internal_commands_m[] PROGMEM =
   "meminfo|"
   "meminfodetail|"
 #endif // ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
-;
 
-#define Int_cmd_n_offset ESPEasy_cmd_e::name
-const char Internal_commands_n[] PROGMEM =
   "name|"
   "nosleep|"
 #if FEATURE_NOTIFIER
   "notify|"
 #endif // #if FEATURE_NOTIFIER
   "ntphost|"
-;
 
-#define Int_cmd_p_offset ESPEasy_cmd_e::password
-const char Internal_commands_p[] PROGMEM =
   "password|"
 #ifdef USES_P019
   "pcfgpio|"
@@ -181,20 +157,14 @@ const char Internal_commands_p[] PROGMEM =
   "puttohttp|"
 #endif // #if FEATURE_PUT_TO_HTTP
   "pwm|"
-;
 
-#define Int_cmd_r_offset ESPEasy_cmd_e::reboot
-const char Internal_commands_r[] PROGMEM =
   "reboot|"
   "reset|"
   "resetflashwritecounter|"
   "restart|"
   "rtttl|"
   "rules|"
-;
 
-#define Int_cmd_s_offset ESPEasy_cmd_e::save
-const char Internal_commands_s[] PROGMEM =
   "save|"
   "scheduletaskrun|"
 #if FEATURE_SD
@@ -223,10 +193,7 @@ const char Internal_commands_s[] PROGMEM =
 #ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
   "sysload|"
 #endif // ifndef BUILD_NO_DIAGNOSTIC_COMMANDS
-;
 
-#define Int_cmd_t_offset ESPEasy_cmd_e::taskclear
-const char Internal_commands_t[] PROGMEM =
   "taskclear|"
   "taskclearall|"
   "taskdisable|"
@@ -242,10 +209,7 @@ const char Internal_commands_t[] PROGMEM =
   "timerset_ms|"
   "timezone|"
   "tone|"
-;
 
-#define Int_cmd_u_offset ESPEasy_cmd_e::udpport
-const char Internal_commands_u[] PROGMEM =
   "udpport|"
 #if FEATURE_ESPEASY_P2P
   "udptest|"
@@ -254,10 +218,7 @@ const char Internal_commands_u[] PROGMEM =
   "unmonitor|"
   "unmonitorrange|"
   "usentp|"
-;
 
-#define Int_cmd_w_offset ESPEasy_cmd_e::wifiallowap
-const char Internal_commands_w[] PROGMEM =
   "wifiallowap|"
   "wifiapmode|"
   "wificonnect|"
@@ -275,80 +236,182 @@ const char Internal_commands_w[] PROGMEM =
 #endif // ifndef LIMIT_BUILD_SIZE
 ;
 
-const char* getInternalCommand_Haystack_Offset(const char firstLetter, int& offset)
+
+/*********************************************************************************************\
+   Perfect hash of all internal commands.
+
+   Hash of the command (FNV-1a over the lower case characters) selects a bucket.
+   Each bucket has a seed, which is mixed with the hash to compute the slot.
+   Seeds are chosen at compile time so no 2 commands map to the same slot.
+   A lookup is thus just a single probe + a string compare to check for a match.
+\*********************************************************************************************/
+
+constexpr uint8_t Int_cmd_nr_commands = static_cast<uint8_t>(ESPEasy_cmd_e::NotMatched);
+
+// Marker for an empty slot, thus the number of commands must be less than this.
+#define INT_CMD_EMPTY_SLOT      0xFF
+
+// Max. number of commands in a bucket
+#define INT_CMD_MAX_BUCKET_SIZE 16
+
+static_assert(Int_cmd_nr_commands < INT_CMD_EMPTY_SLOT, "Too many internal commands for the perfect hash table");
+
+constexpr uint8_t Int_cmd_nr_slot_bits(unsigned nrCommands) {
+  // Load factor of at most 2/3
+  uint8_t bits = 4;
+
+  while ((1u << bits) < (nrCommands + (nrCommands / 2))) {
+    ++bits;
+  }
+  return bits;
+}
+
+constexpr uint8_t  Int_cmd_slot_bits    = Int_cmd_nr_slot_bits(Int_cmd_nr_commands);
+constexpr uint16_t Int_cmd_nr_slots     = 1u << Int_cmd_slot_bits;
+constexpr uint16_t Int_cmd_nr_buckets   = Int_cmd_nr_slots / 4;
+
+constexpr uint32_t Int_cmd_hash(const char *str, size_t length) {
+  uint32_t hash = 0x811c9dc5u;
+
+  for (size_t i = 0; i < length; ++i) {
+    char c = str[i];
+
+    if ((c >= 'A') && (c <= 'Z')) {
+      c += 'a' - 'A';
+    }
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x01000193u;
+  }
+  return hash;
+}
+
+constexpr uint16_t Int_cmd_bucket(uint32_t hash) {
+  return hash % Int_cmd_nr_buckets;
+}
+
+constexpr uint16_t Int_cmd_slot(uint32_t hash, uint8_t seed) {
+  // Multiplicative hashing, use the upper bits as they are the best mixed ones.
+  return ((hash ^ (seed * 0x9E3779B1u)) * 0x85EBCA6Bu) >> (32 - Int_cmd_slot_bits);
+}
+
+struct Int_cmd_hash_table_t {
+  // Seed per bucket
+  uint8_t seeds[Int_cmd_nr_buckets]{};
+
+  // Command index per slot, INT_CMD_EMPTY_SLOT when not used.
+  uint8_t slots[Int_cmd_nr_slots]{};
+
+  // Offset of each command in Internal_commands.
+  // Last element is the offset to the end of the string, so the length of a command can be computed.
+  uint16_t offsets[Int_cmd_nr_commands + 1]{};
+
+  uint8_t nrCommands{};
+  bool    valid{};
+};
+
+constexpr Int_cmd_hash_table_t Int_cmd_create_hash_table()
 {
-  const char *haystack = nullptr;
-
-  offset = static_cast<int>(ESPEasy_cmd_e::NotMatched);
-
-  // Keep the offset in sync when adding new commands
-  switch (firstLetter)
-  {
-    case 'a':
-    case 'b':
-      offset   = 0;
-      haystack = Internal_commands_ab;
-      break;
-    case 'c':
-      offset   = static_cast<int>(Int_cmd_c_offset);
-      haystack = Internal_commands_c;
-      break;
-    case 'd':
-      offset   = static_cast<int>(Int_cmd_d_offset);
-      haystack = Internal_commands_d;
-      break;
-    case 'e':
-      offset   = static_cast<int>(Int_cmd_e_offset);
-      haystack = Internal_commands_e;
-      break;
-    case 'g':
-    case 'h':
-    case 'i':
-    case 'j':
-      offset   = static_cast<int>(Int_cmd_ghij_offset);
-      haystack = Internal_commands_ghij;
-      break;
-    case 'l':
-      offset   = static_cast<int>(Int_cmd_l_offset);
-      haystack = Internal_commands_l;
-      break;
-    case 'm':
-      offset   = static_cast<int>(Int_cmd_m_offset);
-      haystack = Internal_commands_m;
-      break;
-    case 'n':
-      offset   = static_cast<int>(Int_cmd_n_offset);
-      haystack = Internal_commands_n;
-      break;
-    case 'p':
-      offset   = static_cast<int>(Int_cmd_p_offset);
-      haystack = Internal_commands_p;
-      break;
-    case 'r':
-      offset   = static_cast<int>(Int_cmd_r_offset);
-      haystack = Internal_commands_r;
-      break;
-    case 's':
-      offset   = static_cast<int>(Int_cmd_s_offset);
-      haystack = Internal_commands_s;
-      break;
-    case 't':
-      offset   = static_cast<int>(Int_cmd_t_offset);
-      haystack = Internal_commands_t;
-      break;
-    case 'u':
-      offset   = static_cast<int>(Int_cmd_u_offset);
-      haystack = Internal_commands_u;
-      break;
-    case 'w':
-      offset   = static_cast<int>(Int_cmd_w_offset);
-      haystack = Internal_commands_w;
-      break;
-
-    default:
-      return nullptr;
+  Int_cmd_hash_table_t res{};
+  uint32_t hashes[Int_cmd_nr_commands + 1]{};
+
+  // Split the list of commands
+  uint16_t pos = 0;
+
+  while (Internal_commands[pos] != '\0' && res.nrCommands < Int_cmd_nr_commands) {
+    const uint16_t start = pos;
+
+    while (Internal_commands[pos] != '|' && Internal_commands[pos] != '\0') {
+      ++pos;
+    }
+    res.offsets[res.nrCommands] = start;
+    hashes[res.nrCommands]      = Int_cmd_hash(Internal_commands + start, pos - start);
+    ++res.nrCommands;
+
+    if (Internal_commands[pos] == '|') {
+      ++pos;
+    }
+  }
+  res.offsets[res.nrCommands] = pos;
+
+  if ((res.nrCommands != Int_cmd_nr_commands) || (Internal_commands[pos] != '\0')) {
+    // Mismatch between the number of commands and the enum
+    return res;
+  }
+
+  // Collect the commands per bucket
+  uint8_t bucketSize[Int_cmd_nr_buckets]{};
+  uint8_t bucketCommands[Int_cmd_nr_buckets][INT_CMD_MAX_BUCKET_SIZE]{};
+
+  for (uint8_t i = 0; i < Int_cmd_nr_commands; ++i) {
+    const uint16_t bucket = Int_cmd_bucket(hashes[i]);
+
+    if (bucketSize[bucket] >= INT_CMD_MAX_BUCKET_SIZE) {
+      return res;
+    }
+    bucketCommands[bucket][bucketSize[bucket]] = i;
+    ++bucketSize[bucket];
+  }
+
+  for (uint16_t slot = 0; slot < Int_cmd_nr_slots; ++slot) {
+    res.slots[slot] = INT_CMD_EMPTY_SLOT;
+  }
+
+  // Place the largest buckets first, as those are the hardest to fit.
+  for (uint8_t size = INT_CMD_MAX_BUCKET_SIZE; size > 0; --size) {
+    for (uint16_t bucket = 0; bucket < Int_cmd_nr_buckets; ++bucket) {
+      if (bucketSize[bucket] != size) { continue; }
+
+      bool placed = false;
+
+      for (uint16_t seed = 0; seed <= 0xFF && !placed; ++seed) {
+        uint16_t slots[INT_CMD_MAX_BUCKET_SIZE]{};
+        placed = true;
+
+        for (uint8_t i = 0; i < size && placed; ++i) {
+          slots[i] = Int_cmd_slot(hashes[bucketCommands[bucket][i]], seed);
+
+          if (res.slots[slots[i]] != INT_CMD_EMPTY_SLOT) {
+            placed = false;
+          }
+
+          for (uint8_t j = 0; j < i && placed; ++j) {
+            if (slots[j] == slots[i]) {
+              placed = false;
+            }
+          }
+        }
+
+        if (placed) {
+          res.seeds[bucket] = seed;
+
+          for (uint8_t i = 0; i < size; ++i) {
+            res.slots[slots[i]] = bucketCommands[bucket][i];
+          }
+        }
+      }
+
+      if (!placed) {
+        return res;
+      }
+    }
   }
-  return haystack;
+  res.valid = true;
+  return res;
+}
+
+constexpr Int_cmd_hash_table_t Int_cmd_hash_table PROGMEM = Int_cmd_create_hash_table();
+
+static_assert(Int_cmd_hash_table.nrCommands == Int_cmd_nr_commands, "Number of internal commands does not match ESPEasy_cmd_e");
+static_assert(Int_cmd_hash_table.valid, "Could not generate perfect hash table for internal commands");
+
+
+uint16_t Int_cmd_offset(uint8_t index, uint16_t& length)
+{
+  const uint16_t offset = pgm_read_word(&Int_cmd_hash_table.offsets[index]);
+
+  // Subtract 1 for the separator
+  length = pgm_read_word(&Int_cmd_hash_table.offsets[index + 1]) - offset - 1;
+  return offset;
 }
 
 ESPEasy_cmd_e match_ESPEasy_internal_command(const String& cmd)
@@ -356,39 +419,26 @@ ESPEasy_cmd_e match_ESPEasy_internal_command(const String& cmd)
   START_TIMER;
   ESPEasy_cmd_e res = ESPEasy_cmd_e::NotMatched;
 
-  if (cmd.length() < 2) {
-    // No commands less than 2 characters
-    return res;
-  }
-
-  int offset           = 0;
-  const char *haystack = getInternalCommand_Haystack_Offset(cmd[0], offset);
+  const size_t cmd_length = cmd.length();
 
-  if (haystack == nullptr) {
-/*
-    addLog(LOG_LEVEL_ERROR, strformat(
-             F("Internal command: No Haystack/offset '%s', offset: %d"),
-             cmd.c_str(),
-             offset));
-*/
+  if (cmd_length < 2) {
+    // No commands less than 2 characters
     return res;
   }
 
+  const uint32_t hash  = Int_cmd_hash(cmd.c_str(), cmd_length);
+  const uint8_t  seed  = pgm_read_byte(&Int_cmd_hash_table.seeds[Int_cmd_bucket(hash)]);
+  const uint8_t  index = pgm_read_byte(&Int_cmd_hash_table.slots[Int_cmd_slot(hash, seed)]);
 
-  if (haystack != nullptr) {
-    const int command_i = GetCommandCode(cmd.c_str(), haystack);
+  if (index < Int_cmd_nr_commands) {
+    // Any string may map to a used slot, so check if it really is the same command.
+    uint16_t length{};
+    const uint16_t offset = Int_cmd_offset(index, length);
 
-    if (command_i != -1) {
-      res = static_cast<ESPEasy_cmd_e>(command_i + offset);
-    }
-/*
-    else {
-      addLog(LOG_LEVEL_ERROR, strformat(
-               F("Internal command: Not found '%s', haystack: %s"),
-               cmd.c_str(),
-               String(haystack).c_str()));
+    if ((length == cmd_length) &&
+        (strncasecmp_P(cmd.c_str(), Internal_commands + offset, length) == 0)) {
+      res = static_cast<ESPEasy_cmd_e>(index);
     }
-*/
   }
   STOP_TIMER(COMMAND_DECODE_INTERNAL);
   return res;
@@ -400,40 +450,17 @@ bool toString(ESPEasy_cmd_e cmd, String& str)
   if (cmd == ESPEasy_cmd_e::NotMatched) {
     return false;
   }
-  char c     = 'z';
-  bool found = false;
-  int  offset;
-  const char *haystack = nullptr;
-
-  while (!found && c >= 'a') {
-    haystack = getInternalCommand_Haystack_Offset(c, offset);
-
-    if (haystack != nullptr) {
-      if (offset <= static_cast<int>(cmd)) {
-        found = true;
-      }
-    }
-    --c;
-  }
+  uint16_t length{};
+  const uint16_t offset = Int_cmd_offset(static_cast<uint8_t>(cmd), length);
 
-  if (found) {
-    const int index = static_cast<int>(cmd) - offset;
-/*
-    addLog(LOG_LEVEL_INFO, strformat(
-             F("Internal command: cmd=%d offset=%d index=%d"),
-             static_cast<int>(cmd),
-             offset,
-             index));
-*/
+  str = String();
 
-    if ((index >= 0) && (haystack != nullptr)) {
-      // Likely long enough to parse any command
-      char temp[32]{};
-      str = GetTextIndexed(temp, sizeof(temp), index, haystack);
-      return !str.isEmpty();
+  if (str.reserve(length)) {
+    for (uint16_t i = 0; i < length; ++i) {
+      str += static_cast<char>(pgm_read_byte(Internal_commands + offset + i));
     }
   }
-  return false;
+  return !str.isEmpty();
 }
 
 bool checkAll_internalCommands()
@@ -58,6 +58,9 @@ enum class ESPEasy_cmd_e : uint8_t {
   ethdisconnect,
   ethwifimode,
 #endif // FEATURE_ETHERNET
+#if FEATURE_SETTINGS_WRITE_BACK
+  flushsettings,
+#endif // if FEATURE_SETTINGS_WRITE_BACK
 
   gateway,
   gpio,
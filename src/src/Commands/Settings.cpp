@@ -11,6 +11,7 @@
 
 #include "../Globals/SecuritySettings.h"
 #include "../Globals/Settings.h"
+#include "../Globals/SettingsWriteBack.h"
 
 #include "../Helpers/ESPEasy_FactoryDefault.h"
 #include "../Helpers/ESPEasy_Storage.h"
@@ -81,6 +82,16 @@ const __FlashStringHelper * Command_Settings_Save(struct EventStruct *event, con
 	return return_command_success_flashstr();
 }
 
+#if FEATURE_SETTINGS_WRITE_BACK
+const __FlashStringHelper * Command_Settings_Flush(struct EventStruct *event, const char* Line)
+{
+	if (!settingsWriteBack.flush().isEmpty()) {
+		return return_command_failed_flashstr();
+	}
+	return return_command_success_flashstr();
+}
+#endif // if FEATURE_SETTINGS_WRITE_BACK
+
 const __FlashStringHelper * Command_Settings_Load(struct EventStruct *event, const char* Line)
 {
 	LoadSettings();
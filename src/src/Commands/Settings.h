@@ -9,6 +9,9 @@ String Command_Settings_Name(struct EventStruct *event, const char* Line);
 String Command_Settings_Password(struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_Settings_Password_Clear(struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_Settings_Save(struct EventStruct *event, const char* Line);
+#if FEATURE_SETTINGS_WRITE_BACK
+const __FlashStringHelper * Command_Settings_Flush(struct EventStruct *event, const char* Line);
+#endif // if FEATURE_SETTINGS_WRITE_BACK
 const __FlashStringHelper * Command_Settings_Load(struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_Settings_Print(struct EventStruct *event, const char* Line);
 const __FlashStringHelper * Command_Settings_Reset(struct EventStruct *event, const char* Line);
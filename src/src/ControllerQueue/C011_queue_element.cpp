@@ -23,6 +23,16 @@ size_t C011_queue_element::getSize() const {
   return total;
 }
 
+uint32_t C011_queue_element::computeHash() const {
+  // The request is set after the element was added to the queue.
+  uint32_t hash = Queue_element_base::computeHash();
+
+  hash = addToHash(hash, static_cast<uint32_t>(_taskIndex));
+  hash = addToHash(hash, static_cast<uint32_t>(sensorType));
+  hash = addToHash(hash, static_cast<uint32_t>(idx));
+  return hash;
+}
+
 bool C011_queue_element::isDuplicate(const Queue_element_base& other) const {
   const C011_queue_element& oth = static_cast<const C011_queue_element&>(other);
 
@@ -39,6 +39,12 @@ public:
 
   bool                      isDuplicate(const Queue_element_base& other) const;
 
+  uint32_t                  computeHash() const;
+
+  uint8_t                   getNrValuesSent() const {
+    return valuesSent;
+  }
+
   const UnitMessageCount_t* getUnitMessageCount() const {
     return nullptr;
   }
@@ -59,6 +59,16 @@ size_t C016_queue_element::getSize() const {
   return sizeof(*this);
 }
 
+uint32_t C016_queue_element::computeHash() const {
+  // Float values are compared with some tolerance, so not included.
+  uint32_t hash = Queue_element_base::computeHash();
+
+  hash = addToHash(hash, static_cast<uint32_t>(_taskIndex));
+  hash = addToHash(hash, static_cast<uint32_t>(sensorType));
+  hash = addToHash(hash, static_cast<uint32_t>(valueCount));
+  return hash;
+}
+
 bool C016_queue_element::isDuplicate(const Queue_element_base& other) const {
   const C016_queue_element& oth = static_cast<const C016_queue_element&>(other);
 
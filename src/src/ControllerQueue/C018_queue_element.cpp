@@ -17,9 +17,7 @@ C018_queue_element::C018_queue_element(struct EventStruct *event, uint8_t sample
   # if FEATURE_PACKED_RAW_DATA
   move_special(packed, getPackedFromPlugin(event, sampleSetCount));
 
-  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-    addLogMove(LOG_LEVEL_INFO, concat(F("C018 queue element: "), packed));
-  }
+  addLogFormat(LOG_LEVEL_INFO, F("C018 queue element: %s"), packed.c_str());
   # endif // if FEATURE_PACKED_RAW_DATA
 }
 
@@ -27,6 +25,14 @@ size_t C018_queue_element::getSize() const {
   return sizeof(*this) + packed.length();
 }
 
+uint32_t C018_queue_element::computeHash() const {
+  uint32_t hash = Queue_element_base::computeHash();
+
+  hash = addToHash(hash, static_cast<uint32_t>(_taskIndex));
+  hash = addToHash(hash, packed);
+  return hash;
+}
+
 bool C018_queue_element::isDuplicate(const Queue_element_base& other) const {
   const C018_queue_element& oth = static_cast<const C018_queue_element&>(other);
 
@@ -34,6 +34,8 @@ public:
 
   bool                      isDuplicate(const Queue_element_base& other) const;
 
+  uint32_t                  computeHash() const;
+
   const UnitMessageCount_t* getUnitMessageCount() const {
     return nullptr;
   }
@@ -11,7 +11,13 @@ ControllerDelayHandlerStruct::ControllerDelayHandlerStruct() :
   delete_oldest(false),
   must_check_reply(false),
   deduplicate(false),
-  useLocalSystemTime(false) {}
+  useLocalSystemTime(false),
+  batch_send(false),
+  batch_func(nullptr),
+  adaptive_send_rate(false),
+  adaptiveBatchSize(1),
+  adaptiveDelay(0),
+  avgSendDuration(0) {}
 
 bool ControllerDelayHandlerStruct::cacheControllerSettings(controllerIndex_t ControllerIndex)
 {
@@ -21,6 +27,9 @@ bool ControllerDelayHandlerStruct::cacheControllerSettings(controllerIndex_t Con
     return false;
   }
   LoadControllerSettings(ControllerIndex, *ControllerSettings);
+  #if FEATURE_CONTROLLER_QUEUE_SPILL
+  spill.init(ControllerIndex);
+  #endif // if FEATURE_CONTROLLER_QUEUE_SPILL
   cacheControllerSettings(*ControllerSettings);
   return true;
 }
@@ -33,6 +42,11 @@ void ControllerDelayHandlerStruct::cacheControllerSettings(const ControllerSetti
   must_check_reply       = settings.MustCheckReply;
   deduplicate            = settings.deduplicate();
   useLocalSystemTime     = settings.useLocalSystemTime();
+  batch_send             = settings.batchSend();
+  adaptive_send_rate     = settings.adaptiveSendRate();
+  #if FEATURE_CONTROLLER_QUEUE_SPILL
+  spill.setMaxSegments(settings.spillSegments());
+  #endif // if FEATURE_CONTROLLER_QUEUE_SPILL
 
   if (settings.allowExpire()) {
     expire_timeout = max_queue_depth * max_retries * (minTimeBetweenMessages + settings.ClientTimeout);
@@ -53,6 +67,28 @@ void ControllerDelayHandlerStruct::cacheControllerSettings(const ControllerSetti
 
   // No less than 10 msec between messages.
   if (minTimeBetweenMessages < 10) { minTimeBetweenMessages = 10; }
+
+  // Keep the adaptive state within the (possibly changed) limits.
+  if (!adaptive_send_rate || (adaptiveDelay < minTimeBetweenMessages)) {
+    adaptiveDelay = minTimeBetweenMessages;
+  }
+
+  if (adaptiveDelay > CONTROLLER_ADAPTIVE_MAX_DELAY) {
+    adaptiveDelay = CONTROLLER_ADAPTIVE_MAX_DELAY;
+  }
+
+  if (!adaptive_send_rate || (adaptiveBatchSize == 0)) {
+    adaptiveBatchSize = 1;
+  }
+
+  // One extra, as a new element is created before the oldest may be removed when the queue is full.
+  pool.setNrRecords(max_queue_depth + 1);
+  {
+    #ifdef USE_SECOND_HEAP
+    HeapSelectDram ephemeral;
+    #endif // ifdef USE_SECOND_HEAP
+    sendQueue.reserve(max_queue_depth + 1);
+  }
 }
 
 bool ControllerDelayHandlerStruct::readyToProcess(const Queue_element_base& element) const {
@@ -95,18 +131,11 @@ bool ControllerDelayHandlerStruct::queueFull(controllerIndex_t controller_idx) c
   }
 #ifndef BUILD_NO_DEBUG
 
-  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-    String log = F("Controller-");
-    log += controller_idx + 1;
-    log += F(" : Memory used: ");
-    log += getQueueMemorySize();
-    log += F(" bytes ");
-    log += sendQueue.size();
-    log += F(" items ");
-    log += freeHeap;
-    log += F(" free");
-    addLogMove(LOG_LEVEL_DEBUG, log);
-  }
+  addLogFormat(LOG_LEVEL_DEBUG, F("Controller-%d : Memory used: %u bytes %u items %d free"),
+               controller_idx + 1,
+               getQueueMemorySize(),
+               sendQueue.size(),
+               freeHeap);
 #endif // ifndef BUILD_NO_DEBUG
   return true;
 }
@@ -124,18 +153,17 @@ bool ControllerDelayHandlerStruct::isDuplicate(const Queue_element_base& element
   unitLastMessageCount.add(element.getUnitMessageCount());
 
   // the setting 'deduplicate' does look at the content of the message and only compares it to messages in the queue.
-  if (deduplicate && !sendQueue.empty()) {
-    // Use reverse iterator here, as it is more likely a duplicate is added shortly after another.
-    auto it = sendQueue.rbegin(); // Same as back()
+  // Only compare the content of elements with the same content hash.
+  if (deduplicate && (sendQueue.countHash(element._hash) != 0)) {
+    // Iterate from the back here, as it is more likely a duplicate is added shortly after another.
+    for (size_t i = sendQueue.size(); i > 0; --i) {
+      const Queue_element_base *queued = sendQueue[i - 1].get();
 
-    for (; it != sendQueue.rend(); ++it) {
-      if (element.isDuplicate(*(it->get()))) {
+      if ((queued->_hash == element._hash) && element.isDuplicate(*queued)) {
 #ifndef BUILD_NO_DEBUG
 
-        if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-          const cpluginID_t cpluginID = getCPluginID_from_ControllerIndex(it->get()->_controller_idx);
-          addLogMove(LOG_LEVEL_DEBUG, concat(get_formatted_Controller_number(cpluginID), F(" : Remove duplicate")));
-        }
+        addLogFormat(LOG_LEVEL_DEBUG, F("C%03d : Remove duplicate"),
+                     getCPluginID_from_ControllerIndex(queued->_controller_idx));
 #endif // ifndef BUILD_NO_DEBUG
         return true;
       }
@@ -150,10 +178,32 @@ bool ControllerDelayHandlerStruct::addToQueue(std::unique_ptr<Queue_element_base
   if (!element) { 
     return false;
   }
+  element->_hash = element->computeHash();
+
   if (isDuplicate(*element)) {
     return true;
   }
 
+  #if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  // Keep the order: once elements are spilled, new elements must be spilled too.
+  if (!spill.empty() || (spill.enabled() && queueFull(element->_controller_idx))) {
+    if (spill.write(*element, delete_oldest)) {
+      return true;
+    }
+
+    if (!spill.empty()) {
+      // Flash budget used up and not allowed to delete the oldest.
+      # ifndef BUILD_NO_DEBUG
+
+      addLogFormat(LOG_LEVEL_DEBUG, F("C%03d : queue full, also on flash"),
+                   getCPluginID_from_ControllerIndex(element->_controller_idx));
+      # endif // ifndef BUILD_NO_DEBUG
+      return false;
+    }
+  }
+  #endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
   if (delete_oldest) {
     // Force add to the queue.
     // If max buffer is reached, the oldest in the queue (first to be served) will be removed.
@@ -165,7 +215,7 @@ bool ControllerDelayHandlerStruct::addToQueue(std::unique_ptr<Queue_element_base
 
   if (!queueFull(element->_controller_idx)) {
     #ifdef USE_SECOND_HEAP
-    // Do not store in 2nd heap, std::list cannot handle 2nd heap well
+    // Do not store in 2nd heap, in case the ring buffer must grow.
     HeapSelectDram ephemeral;
     #endif // ifdef USE_SECOND_HEAP
 
@@ -175,17 +225,25 @@ bool ControllerDelayHandlerStruct::addToQueue(std::unique_ptr<Queue_element_base
   }
 #ifndef BUILD_NO_DEBUG
 
-  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-    const cpluginID_t cpluginID = getCPluginID_from_ControllerIndex((*element)._controller_idx);
-    addLogMove(LOG_LEVEL_DEBUG, concat(get_formatted_Controller_number(cpluginID), F(" : queue full")));
-  }
+  addLogFormat(LOG_LEVEL_DEBUG, F("C%03d : queue full"),
+               getCPluginID_from_ControllerIndex(element->_controller_idx));
 #endif // ifndef BUILD_NO_DEBUG
   return false;
 }
 
+size_t ControllerDelayHandlerStruct::getNrQueued() const {
+  #if FEATURE_CONTROLLER_QUEUE_SPILL
+  return sendQueue.size() + spill.size();
+  #else // if FEATURE_CONTROLLER_QUEUE_SPILL
+  return sendQueue.size();
+  #endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+}
+
 // Get the next element.
 // Remove front element when max_retries is reached.
 Queue_element_base * ControllerDelayHandlerStruct::getNext() {
+  refillFromSpill();
+
   if (sendQueue.empty()) { return nullptr; }
 
   if (attempt > max_retries) {
@@ -202,6 +260,7 @@ Queue_element_base * ControllerDelayHandlerStruct::getNext() {
       } else {
         sendQueue.pop_front();
         attempt = 0;
+        refillFromSpill();
       }
     }
   }
@@ -220,6 +279,7 @@ unsigned long ControllerDelayHandlerStruct::markProcessed(bool remove_from_queue
     sendQueue.pop_front();
     attempt  = 0;
     lastSend = millis();
+    refillFromSpill();
   } else {
     ++attempt;
   }
@@ -228,7 +288,16 @@ unsigned long ControllerDelayHandlerStruct::markProcessed(bool remove_from_queue
 
 unsigned long ControllerDelayHandlerStruct::getNextScheduleTime() const {
   if (sendQueue.empty()) { return 0; }
-  unsigned long nextTime = lastSend + minTimeBetweenMessages;
+  unsigned long nextTime = lastSend + getEffectiveTimeBetweenMessages();
+
+  if (!batchReady()) {
+    // Wait for the batch to fill up, or the first element to wait too long.
+    const unsigned long batchTime = sendQueue.front()->_timestamp + CONTROLLER_BATCH_MAX_WAIT;
+
+    if (timeDiff(nextTime, batchTime) > 0) {
+      nextTime = batchTime;
+    }
+  }
 
   if (timePassedSince(nextTime) > 0) {
     nextTime = millis();
@@ -239,6 +308,39 @@ unsigned long ControllerDelayHandlerStruct::getNextScheduleTime() const {
   return nextTime;
 }
 
+size_t ControllerDelayHandlerStruct::getBatchSize() const {
+  if (!batch_send) { return 1; }
+
+  const size_t batchSize = adaptive_send_rate ? adaptiveBatchSize : CONTROLLER_BATCH_MAX_ELEMENTS;
+
+  if (max_queue_depth < batchSize) {
+    // Batch would never fill up when the queue cannot hold it.
+    return max_queue_depth;
+  }
+  return batchSize;
+}
+
+unsigned int ControllerDelayHandlerStruct::getEffectiveTimeBetweenMessages() const {
+  return adaptive_send_rate ? adaptiveDelay : minTimeBetweenMessages;
+}
+
+float ControllerDelayHandlerStruct::getEffectiveSendRate() const {
+  const size_t batchSize = getBatchSize();
+  const float  runTime   = getEffectiveTimeBetweenMessages() + batchSize * avgSendDuration;
+
+  if (runTime <= 0.0f) { return 0.0f; }
+  return (1000.0f * batchSize) / runTime;
+}
+
+bool ControllerDelayHandlerStruct::batchReady() const {
+  if (!batch_send || sendQueue.empty()) { return true; }
+
+  if (sendQueue.size() >= getBatchSize()) { return true; }
+
+  return sendQueue.front() &&
+         timePassedSince(sendQueue.front()->_timestamp) >= CONTROLLER_BATCH_MAX_WAIT;
+}
+
 // Set the "lastSend" to "now" + some additional delay.
 // This will cause the next schedule time to be delayed to
 // msecFromNow + minTimeBetweenMessages
@@ -247,11 +349,15 @@ void ControllerDelayHandlerStruct::setAdditionalDelay(unsigned long msecFromNow)
 }
 
 size_t ControllerDelayHandlerStruct::getQueueMemorySize() const {
-  size_t totalSize = 0;
+  size_t totalSize = sendQueue.getMemorySize() + pool.getUsedSize();
+
+  if (pool.getNrHeapAllocated() != 0) {
+    for (size_t i = 0; i < sendQueue.size(); ++i) {
+      const Queue_element_base *element = sendQueue[i].get();
 
-  for (auto it = sendQueue.begin(); it != sendQueue.end(); ++it) {
-    if (it->get() != nullptr) {
-      totalSize += it->get()->getSize();
+      if ((element != nullptr) && !pool.owns(element)) {
+        totalSize += Queue_element_pool::headerSize() + element->getSize();
+      }
     }
   }
   return totalSize;
@@ -267,14 +373,26 @@ void ControllerDelayHandlerStruct::process(
 
   if (element == nullptr) { return; }
 
-  if (readyToProcess(*element)) {
+  if (batchReady() && readyToProcess(*element)) {
     MakeControllerSettings(ControllerSettings);
 
     if (AllocatedControllerSettings()) {
       LoadControllerSettings(element->_controller_idx, *ControllerSettings);
       cacheControllerSettings(*ControllerSettings);
       START_TIMER;
-      markProcessed(func(controller_number, *element, *ControllerSettings));
+      const unsigned long start = millis();
+      size_t nrSent             = 0;
+      bool   failed             = false;
+
+      if (batch_send) {
+        nrSent = processBatch(controller_number, func, *ControllerSettings, failed);
+      } else {
+        markProcessed(func(controller_number, *element, *ControllerSettings));
+      }
+
+      if (adaptive_send_rate) {
+        updateAdaptiveRate(failed, timePassedSince(start), nrSent);
+      }
       #if FEATURE_TIMING_STATS
       STOP_TIMER_VAR(timerstats_id);
       #endif
@@ -282,3 +400,139 @@ void ControllerDelayHandlerStruct::process(
   }
   Scheduler.scheduleNextDelayQueue(timerID, getNextScheduleTime());
 }
+
+void ControllerDelayHandlerStruct::refillFromSpill() {
+  #if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  if (spill.empty()) { return; }
+  # ifdef USE_SECOND_HEAP
+  HeapSelectDram ephemeral;
+  # endif // ifdef USE_SECOND_HEAP
+
+  while (!spill.empty() && (sendQueue.empty() || !queueFull(sendQueue.front()->_controller_idx))) {
+    std::unique_ptr<Queue_element_base> element = spill.read(pool);
+
+    if (!element) { return; }
+
+    // Already checked for duplicates when spilled.
+    element->_hash = element->computeHash();
+    sendQueue.push_back(std::move(element));
+  }
+  #endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+}
+
+size_t ControllerDelayHandlerStruct::processBatch(
+  int                       controller_number,
+  do_process_function       func,
+  ControllerSettingsStruct& ControllerSettings,
+  bool                    & failed)
+{
+  std::vector<const Queue_element_base *> batch;
+  const size_t batchSize = getBatchSize();
+
+  batch.reserve(batchSize);
+
+  for (size_t i = 0; i < sendQueue.size() && batch.size() < batchSize; ++i) {
+    batch.push_back(sendQueue[i].get());
+  }
+
+  size_t nrProcessed = 0;
+  bool   stopped     = false;
+
+  failed = false;
+
+  // Only called with batch send enabled, so the batch function may combine messages.
+  if (batch_func != nullptr) {
+    nrProcessed = batch_func(controller_number, batch, ControllerSettings, failed);
+
+    if (nrProcessed >= batch.size()) {
+      nrProcessed = batch.size();
+      failed      = false;
+    }
+
+    // Elements not tried as the batch function ran out of time are no failed attempt.
+    stopped = failed;
+  } else {
+    // No batch handler for this controller, so handle the elements back-to-back.
+    // Leave the rest for the next run when running out of time in this scheduler slice.
+    while (!stopped && nrProcessed < batch.size()) {
+      if ((nrProcessed != 0) && Scheduler.sliceBudgetExceeded()) {
+        break;
+      }
+      const uint8_t nrValuesSent = batch[nrProcessed]->getNrValuesSent();
+
+      if (func(controller_number, *batch[nrProcessed], ControllerSettings)) {
+        ++nrProcessed;
+      } else {
+        // Element may be partially sent, e.g. one value per call.
+        stopped = true;
+        failed  = batch[nrProcessed]->getNrValuesSent() == nrValuesSent;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < nrProcessed; ++i) {
+    markProcessed(true);
+  }
+
+  if (stopped) {
+    // Count the attempt for the first element not processed.
+    markProcessed(false);
+  }
+#ifndef BUILD_NO_DEBUG
+
+  if (nrProcessed > 1) {
+    addLogFormat(LOG_LEVEL_DEBUG, F("C%03d : Batch sent %u of %u queued"),
+                 controller_number,
+                 nrProcessed,
+                 nrProcessed + sendQueue.size());
+  }
+#endif // ifndef BUILD_NO_DEBUG
+  return nrProcessed;
+}
+
+void ControllerDelayHandlerStruct::updateAdaptiveRate(bool failed, unsigned long duration, size_t nrSent)
+{
+  const unsigned int sendDuration = duration / (nrSent == 0 ? 1 : nrSent);
+
+  // Sending suddenly takes much longer, e.g. the server stalls.
+  const bool slow = (avgSendDuration != 0) && (sendDuration > (2 * avgSendDuration + 10));
+
+  if (nrSent != 0) {
+    // Moving average over approx. the last 8 runs
+    avgSendDuration = (avgSendDuration == 0)
+      ? sendDuration
+      : (7 * avgSendDuration + sendDuration) / 8;
+  }
+
+  size_t maxBatchSize = CONTROLLER_BATCH_MAX_ELEMENTS;
+
+  if (maxBatchSize > max_queue_depth) { maxBatchSize = max_queue_depth; }
+
+  if (failed || slow) {
+    // Multiplicative decrease
+    adaptiveDelay *= 2;
+
+    if (adaptiveDelay > CONTROLLER_ADAPTIVE_MAX_DELAY) {
+      adaptiveDelay = CONTROLLER_ADAPTIVE_MAX_DELAY;
+    }
+    adaptiveBatchSize = (adaptiveBatchSize + 1) / 2;
+  } else if (!sendQueue.empty()) {
+    // Additive increase, only when messages are waiting.
+    // First reduce the delay towards the configured minimum, then send more messages per run.
+    if (adaptiveDelay > minTimeBetweenMessages) {
+      adaptiveDelay = (adaptiveDelay > 2 * minTimeBetweenMessages)
+        ? adaptiveDelay - minTimeBetweenMessages
+        : minTimeBetweenMessages;
+    } else if (batch_send && (adaptiveBatchSize < maxBatchSize)) {
+      ++adaptiveBatchSize;
+
+      // Speed up faster when the queue is filling up.
+      if ((4 * sendQueue.size() > 3 * max_queue_depth) && (adaptiveBatchSize < maxBatchSize)) {
+        ++adaptiveBatchSize;
+      }
+    }
+  }
+
+  if (adaptiveBatchSize == 0) { adaptiveBatchSize = 1; }
+}
@@ -4,6 +4,9 @@
 #include "../../ESPEasy_common.h"
 
 #include "../ControllerQueue/Queue_element_base.h"
+#include "../ControllerQueue/Queue_element_pool.h"
+#include "../ControllerQueue/Queue_element_ring.h"
+#include "../ControllerQueue/Queue_element_spill.h"
 
 #include "../DataStructs/ControllerSettingsStruct.h"
 #include "../DataStructs/TimingStats.h"
@@ -20,9 +23,9 @@
 #include "../Helpers/StringConverter.h"
 
 
-#include <list>
 #include <memory> // For std::shared_ptr
 #include <new>    // std::nothrow
+#include <vector>
 
 #ifndef CONTROLLER_QUEUE_MINIMAL_EXPIRE_TIME
   # define CONTROLLER_QUEUE_MINIMAL_EXPIRE_TIME 10000
@@ -32,6 +35,14 @@ typedef bool (*do_process_function)(int,
                                     const Queue_element_base&,
                                     ControllerSettingsStruct&);
 
+// Process a batch of queued elements in one go.
+// Return the number of elements (counted from the first) which can be marked 'Processed'.
+// Set 'failed' when an element could not be sent, not when stopping early to leave the rest for the next run.
+typedef size_t (*do_process_batch_function)(int,
+                                            const std::vector<const Queue_element_base *>&,
+                                            ControllerSettingsStruct&,
+                                            bool&);
+
 /*********************************************************************************************\
 * ControllerDelayHandlerStruct
 \*********************************************************************************************/
@@ -49,9 +60,14 @@ struct ControllerDelayHandlerStruct {
   bool isDuplicate(const Queue_element_base& element) const;
 
   // Try to add to the queue, if permitted by "delete_oldest"
+  // When the queue is full, the element may be spilled to the file system.
+  // Thus the element must be complete, as it may not end up at the back of sendQueue.
   // Return true when item was added, or skipped as it was considered a duplicate
   bool addToQueue(std::unique_ptr<Queue_element_base>element);
 
+  // Nr of elements in the queue, including those spilled to the file system.
+  size_t getNrQueued() const;
+
   // Get the next element.
   // Remove front element when max_retries is reached.
   Queue_element_base* getNext();
@@ -63,11 +79,48 @@ struct ControllerDelayHandlerStruct {
 
   unsigned long getNextScheduleTime() const;
 
+  // Max. number of elements to process in one run.
+  // Will be 1 when batch send is not enabled, so messages are never sent closer together than the configured minimum.
+  // With adaptive send rate enabled, it is adjusted between 1 and CONTROLLER_BATCH_MAX_ELEMENTS.
+  size_t getBatchSize() const;
+
+  // Time between runs, which is adjusted when adaptive send rate is enabled.
+  unsigned int getEffectiveTimeBetweenMessages() const;
+
+  // Messages per second which can be sent with the current time between runs,
+  // number of messages per run and average send duration.
+  float  getEffectiveSendRate() const;
+
+  // Average time in msec to send a message.
+  unsigned int getAvgSendDuration() const {
+    return avgSendDuration;
+  }
+
+  // Additive increase, multiplicative decrease of the send rate.
+  // Back off on failure or when sending takes much longer than on average.
+  // Speed up when messages are waiting in the queue, by first reducing the time between runs
+  // to the configured minimum and then, only with batch send enabled, sending more messages per run.
+  void updateAdaptiveRate(bool          failed,
+                          unsigned long duration,
+                          size_t        nrSent);
+
+  // Return true when the first element may be processed.
+  // With batch send enabled, this is when enough elements are queued
+  // or the first element has waited long enough.
+  bool   batchReady() const;
+
+  // Set the controller specific handler to process a batch of elements in one go.
+  // When not set, the elements of a batch are processed one by one in a single run.
+  void   setBatchFunction(do_process_batch_function func) {
+    batch_func = func;
+  }
+
   // Set the "lastSend" to "now" + some additional delay.
   // This will cause the next schedule time to be delayed to
   // msecFromNow + minTimeBetweenMessages
   void   setAdditionalDelay(unsigned long msecFromNow);
 
+  // Memory used by the queue: ring buffer, pool records in use and elements which did not fit in the pool.
   size_t getQueueMemorySize() const;
 
   void   process(
@@ -76,7 +129,30 @@ struct ControllerDelayHandlerStruct {
     TimingStatsElements                timerstats_id,
     SchedulerIntervalTimer_e timerID);
 
-  std::list<std::unique_ptr<Queue_element_base> >sendQueue;
+private:
+
+  // Move spilled elements back into the queue while there is room.
+  void   refillFromSpill();
+
+  // Process up to getBatchSize() elements from the front of the queue and return the number of elements processed.
+  // 'failed' is set when an element could not be sent at all,
+  // not when the rest is left for the next run as the scheduler slice ran out of time.
+  size_t processBatch(
+    int                       controller_number,
+    do_process_function       func,
+    ControllerSettingsStruct& ControllerSettings,
+    bool                    & failed);
+
+public:
+
+  // Elements should be allocated from this pool: new (DelayHandler->pool) Cxxx_queue_element(...)
+  // N.B. must be declared before sendQueue, so the elements are destructed before the pool.
+  Queue_element_pool                             pool;
+  Queue_element_ring                             sendQueue;
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+  // Elements which did not fit in sendQueue, newer than all elements in sendQueue.
+  Queue_element_spill                            spill;
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
   mutable UnitLastMessageCount_map               unitLastMessageCount;
   unsigned long                                  lastSend               = 0;
   unsigned int                                   minTimeBetweenMessages = CONTROLLER_DELAY_QUEUE_DELAY_DFLT;
@@ -88,6 +164,14 @@ struct ControllerDelayHandlerStruct {
   bool                                           must_check_reply       = false;
   bool                                           deduplicate            = false;
   bool                                           useLocalSystemTime     = false;
+  bool                                           batch_send             = false;
+  do_process_batch_function                      batch_func             = nullptr;
+
+  // Adaptive send rate state, not reset when the settings are cached again.
+  bool                                           adaptive_send_rate     = false;
+  uint8_t                                        adaptiveBatchSize      = 1;
+  unsigned int                                   adaptiveDelay          = 0;
+  unsigned int                                   avgSendDuration        = 0;
 };
 
 
@@ -118,6 +118,9 @@
 
 
 
+// Return the delay handler used by the controller, or nullptr when not active.
+struct ControllerDelayHandlerStruct* getControllerDelayHandler(controllerIndex_t ControllerIndex);
+
 #if FEATURE_MQTT
 # include "../ControllerQueue/MQTT_queue_element.h"
 extern struct ControllerDelayHandlerStruct *MQTTDelayHandler;
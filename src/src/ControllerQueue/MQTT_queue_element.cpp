@@ -43,6 +43,46 @@ size_t MQTT_queue_element::getSize() const {
   return sizeof(*this) + _topic.length() + _payload.length();
 }
 
+uint32_t MQTT_queue_element::computeHash() const {
+  uint32_t hash = Queue_element_base::computeHash();
+
+  hash = addToHash(hash, static_cast<uint32_t>(_retained));
+  hash = addToHash(hash, _topic);
+  hash = addToHash(hash, _payload);
+  return hash;
+}
+
+# if FEATURE_CONTROLLER_QUEUE_SPILL
+
+void MQTT_queue_element::serialize(std::vector<uint8_t>& buffer) const {
+  Queue_element_base::serialize(buffer);
+  serializeValue(buffer, _retained ? 1 : 0, 1);
+  serializeValue(buffer, UnitMessageCount.unit,  1);
+  serializeValue(buffer, UnitMessageCount.count, 1);
+  serializeString(buffer, _topic);
+  serializeString(buffer, _payload);
+}
+
+bool MQTT_queue_element::deserialize(const uint8_t *& data, const uint8_t *end) {
+  uint32_t retained{};
+  uint32_t unit{};
+  uint32_t count{};
+
+  if (!Queue_element_base::deserialize(data, end) ||
+      !deserializeValue(data, end, retained, 1) ||
+      !deserializeValue(data, end, unit,     1) ||
+      !deserializeValue(data, end, count,    1)) {
+    return false;
+  }
+  _retained              = retained != 0;
+  UnitMessageCount.unit  = unit;
+  UnitMessageCount.count = count;
+  return deserializeString(data, end, _topic) &&
+         deserializeString(data, end, _payload);
+}
+
+# endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
 bool MQTT_queue_element::isDuplicate(const Queue_element_base& other) const {
   if (_call_PLUGIN_PROCESS_CONTROLLER_DATA || other._call_PLUGIN_PROCESS_CONTROLLER_DATA) {
     return false;
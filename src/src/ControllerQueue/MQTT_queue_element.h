@@ -39,6 +39,19 @@ public:
 
   bool                      isDuplicate(const Queue_element_base& other) const;
 
+  uint32_t                  computeHash() const;
+
+# if FEATURE_CONTROLLER_QUEUE_SPILL
+  Queue_element_type_e getType() const {
+    return Queue_element_type_e::MQTT_queue_element;
+  }
+
+  void serialize(std::vector<uint8_t>& buffer) const;
+
+  bool deserialize(const uint8_t *& data,
+                   const uint8_t  *end);
+# endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
   const UnitMessageCount_t* getUnitMessageCount() const {
     return &UnitMessageCount;
   }
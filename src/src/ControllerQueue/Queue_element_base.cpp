@@ -1,6 +1,9 @@
 #include "../ControllerQueue/Queue_element_base.h"
 
+#include "../Helpers/CRC_functions.h"
+
 Queue_element_base::Queue_element_base() :
+  _hash(0),
   _controller_idx(INVALID_CONTROLLER_INDEX),
   _taskIndex(INVALID_TASK_INDEX),
   _call_PLUGIN_PROCESS_CONTROLLER_DATA(false),
@@ -10,3 +13,124 @@ Queue_element_base::Queue_element_base() :
 }
 
 Queue_element_base::~Queue_element_base() {}
+
+uint32_t Queue_element_base::computeHash() const
+{
+  // All elements only consider elements for the same controller as duplicate.
+  return addToHash(FNV1A_32_INIT, _controller_idx);
+}
+
+uint32_t Queue_element_base::addToHash(uint32_t hash, const String& str)
+{
+  return calc_FNV1a_32(reinterpret_cast<const uint8_t *>(str.c_str()), str.length(), hash);
+}
+
+uint32_t Queue_element_base::addToHash(uint32_t hash, uint32_t value)
+{
+  return calc_FNV1a_32(reinterpret_cast<const uint8_t *>(&value), sizeof(value), hash);
+}
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+void Queue_element_base::serialize(std::vector<uint8_t>& buffer) const
+{
+  const uint8_t flags = (_call_PLUGIN_PROCESS_CONTROLLER_DATA ? 1 : 0) |
+                        (_processByController ? 2 : 0);
+
+  serializeValue(buffer, _timestamp,      4);
+  serializeValue(buffer, _controller_idx, 1);
+  serializeValue(buffer, _taskIndex,      1);
+  serializeValue(buffer, flags,           1);
+}
+
+bool Queue_element_base::deserialize(const uint8_t *& data, const uint8_t *end)
+{
+  uint32_t timestamp{};
+  uint32_t controller_idx{};
+  uint32_t taskIndex{};
+  uint32_t flags{};
+
+  if (!deserializeValue(data, end, timestamp,      4) ||
+      !deserializeValue(data, end, controller_idx, 1) ||
+      !deserializeValue(data, end, taskIndex,      1) ||
+      !deserializeValue(data, end, flags,          1)) {
+    return false;
+  }
+  _timestamp                           = timestamp;
+  _controller_idx                      = controller_idx;
+  _taskIndex                           = taskIndex;
+  _call_PLUGIN_PROCESS_CONTROLLER_DATA = flags & 1;
+  _processByController                 = flags & 2;
+  return true;
+}
+
+void Queue_element_base::serializeValue(std::vector<uint8_t>& buffer, uint32_t value, uint8_t nrBytes)
+{
+  for (uint8_t i = 0; i < nrBytes; ++i) {
+    buffer.push_back(value & 0xFF);
+    value >>= 8;
+  }
+}
+
+void Queue_element_base::serializeString(std::vector<uint8_t>& buffer, const String& str)
+{
+  const size_t length = str.length() > 0xFFFF ? 0xFFFF : str.length();
+
+  serializeValue(buffer, length, 2);
+  buffer.insert(buffer.end(), str.c_str(), str.c_str() + length);
+}
+
+bool Queue_element_base::deserializeValue(const uint8_t *& data, const uint8_t *end, uint32_t& value, uint8_t nrBytes)
+{
+  if ((data + nrBytes) > end) { return false; }
+  value = 0;
+
+  for (uint8_t i = 0; i < nrBytes; ++i) {
+    value |= static_cast<uint32_t>(*data) << (8 * i);
+    ++data;
+  }
+  return true;
+}
+
+bool Queue_element_base::deserializeString(const uint8_t *& data, const uint8_t *end, String& str)
+{
+  uint32_t length{};
+
+  if (!deserializeValue(data, end, length, 2) || ((data + length) > end)) {
+    return false;
+  }
+  str.clear();
+
+  if (!str.concat(reinterpret_cast<const char *>(data), length)) {
+    return false;
+  }
+  data += length;
+  return true;
+}
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
+void * Queue_element_base::operator new(size_t size) noexcept
+{
+  return Queue_element_pool::allocate(nullptr, size);
+}
+
+void * Queue_element_base::operator new(size_t size, const std::nothrow_t& tag) noexcept
+{
+  return Queue_element_pool::allocate(nullptr, size);
+}
+
+void * Queue_element_base::operator new(size_t size, Queue_element_pool& pool) noexcept
+{
+  return Queue_element_pool::allocate(&pool, size);
+}
+
+void Queue_element_base::operator delete(void *ptr)
+{
+  Queue_element_pool::release(ptr);
+}
+
+void Queue_element_base::operator delete(void *ptr, Queue_element_pool& pool)
+{
+  Queue_element_pool::release(ptr);
+}
@@ -4,9 +4,22 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../ControllerQueue/Queue_element_pool.h"
 #include "../DataStructs/UnitMessageCount.h"
 #include "../Globals/CPlugins.h"
 
+#include <new> // std::nothrow_t
+#include <vector>
+
+// Element types which can be spilled to the file system.
+// Stored in the spill files, so do not change the values.
+enum class Queue_element_type_e : uint8_t {
+  NotSerializable                      = 0,
+  SimpleQueueElement_formatted_Strings = 1,
+  SimpleQueueElement_string_only       = 2,
+  MQTT_queue_element                   = 3,
+};
+
 /*********************************************************************************************\
 * Base class for all controller queue elements
 \*********************************************************************************************/
@@ -16,6 +29,18 @@ public:
 
   virtual ~Queue_element_base();
 
+  // Elements are allocated from the pool of the controller queue when given:
+  //   new (DelayHandler->pool) Cxxx_queue_element(...)
+  // Return nullptr when out of memory.
+  static void* operator new(size_t size) noexcept;
+  static void* operator new(size_t                size,
+                            const std::nothrow_t& tag) noexcept;
+  static void* operator new(size_t              size,
+                            Queue_element_pool& pool) noexcept;
+  static void  operator delete(void *ptr);
+  static void  operator delete(void                *ptr,
+                               Queue_element_pool& pool);
+
   virtual size_t                    getSize() const = 0;
 
   virtual bool                      isDuplicate(const Queue_element_base& other) const = 0;
@@ -23,7 +48,38 @@ public:
   virtual const UnitMessageCount_t* getUnitMessageCount() const = 0;
   virtual UnitMessageCount_t      * getUnitMessageCount()       = 0;
 
+  // Hash of the content compared in isDuplicate().
+  // Elements which are considered duplicates must have the same hash.
+  // Only include members which are already set when the element is added to the queue.
+  virtual uint32_t                  computeHash() const;
+
+  // Nr of values already sent, for controllers sending a single value per request.
+  // Used to tell a partially sent element apart from a failed send.
+  virtual uint8_t                   getNrValuesSent() const {
+    return 0;
+  }
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  // Element type, used to restore an element spilled to the file system.
+  virtual Queue_element_type_e getType() const {
+    return Queue_element_type_e::NotSerializable;
+  }
+
+  // Append a compact binary form of the element to 'buffer'.
+  // Derived classes must call the base class first.
+  virtual void serialize(std::vector<uint8_t>& buffer) const;
+
+  // Restore the element from its binary form.
+  // Return false when the data is not valid.
+  virtual bool deserialize(const uint8_t *& data,
+                           const uint8_t  *end);
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
   unsigned long _timestamp;
+
+  // Content hash, set by computeHash() when added to the queue.
+  uint32_t _hash;
   controllerIndex_t _controller_idx;
   taskIndex_t _taskIndex;
 
@@ -34,6 +90,35 @@ public:
   // Some formatting of values can be done when actually sending it.
   // This may require less RAM than keeping formatted strings in memory
   bool _processByController;
+
+protected:
+
+  // Chain a value to a content hash.
+  static uint32_t addToHash(uint32_t      hash,
+                            const String& str);
+  static uint32_t addToHash(uint32_t hash,
+                            uint32_t value);
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  // Little endian, nrBytes of the value.
+  static void serializeValue(std::vector<uint8_t>& buffer,
+                             uint32_t              value,
+                             uint8_t               nrBytes);
+
+  // Length (2 bytes) followed by the characters.
+  static void serializeString(std::vector<uint8_t>& buffer,
+                              const String        & str);
+
+  static bool deserializeValue(const uint8_t *& data,
+                               const uint8_t  *end,
+                               uint32_t      & value,
+                               uint8_t         nrBytes);
+
+  static bool deserializeString(const uint8_t *& data,
+                                const uint8_t  *end,
+                                String         & str);
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
 };
 
 #endif // ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_BASE_H
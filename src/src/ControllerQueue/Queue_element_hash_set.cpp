@@ -0,0 +1,97 @@
+#include "../ControllerQueue/Queue_element_hash_set.h"
+
+
+void Queue_element_hash_set::reserve(size_t nrElements)
+{
+  // Keep the table at most half full.
+  size_t nrSlots = 8;
+
+  while (nrSlots < (2 * nrElements)) {
+    nrSlots *= 2;
+  }
+
+  if (nrSlots > _table.size()) {
+    rebuild(nrSlots);
+  }
+}
+
+void Queue_element_hash_set::add(uint32_t hash)
+{
+  reserve(_nrUsed + 1);
+  entry& slot = _table[findSlot(hash)];
+
+  if (slot.count == 0) {
+    slot.hash = hash;
+    ++_nrUsed;
+  }
+
+  if (slot.count < UINT16_MAX) {
+    ++slot.count;
+  }
+}
+
+void Queue_element_hash_set::remove(uint32_t hash)
+{
+  if (_table.empty()) { return; }
+  const size_t mask = _table.size() - 1;
+  size_t slot       = findSlot(hash);
+
+  if (_table[slot].count == 0) { return; }
+
+  if (--_table[slot].count != 0) { return; }
+  --_nrUsed;
+
+  // Backward shift deletion, to keep the probe sequences intact.
+  size_t next = (slot + 1) & mask;
+
+  while (_table[next].count != 0) {
+    const size_t home = _table[next].hash & mask;
+
+    // Move when the empty slot lies cyclically between the home slot and the current slot.
+    if (((next - home) & mask) >= ((next - slot) & mask)) {
+      _table[slot]       = _table[next];
+      _table[next].count = 0;
+      slot               = next;
+    }
+    next = (next + 1) & mask;
+  }
+}
+
+size_t Queue_element_hash_set::count(uint32_t hash) const
+{
+  if (_nrUsed == 0) { return 0; }
+  return _table[findSlot(hash)].count;
+}
+
+void Queue_element_hash_set::clear()
+{
+  for (auto it = _table.begin(); it != _table.end(); ++it) {
+    it->count = 0;
+  }
+  _nrUsed = 0;
+}
+
+size_t Queue_element_hash_set::findSlot(uint32_t hash) const
+{
+  const size_t mask = _table.size() - 1;
+  size_t slot       = hash & mask;
+
+  while (_table[slot].count != 0 && _table[slot].hash != hash) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+void Queue_element_hash_set::rebuild(size_t nrSlots)
+{
+  std::vector<entry> table;
+
+  table.swap(_table);
+  _table.resize(nrSlots, entry{ 0, 0 });
+
+  for (auto it = table.begin(); it != table.end(); ++it) {
+    if (it->count != 0) {
+      _table[findSlot(it->hash)] = *it;
+    }
+  }
+}
@@ -0,0 +1,52 @@
+#ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_HASH_SET_H
+#define CONTROLLERQUEUE_QUEUE_ELEMENT_HASH_SET_H
+
+
+#include "../../ESPEasy_common.h"
+
+#include <vector>
+
+
+/*********************************************************************************************\
+* Queue_element_hash_set
+* Counts the content hashes of the elements in a controller queue,
+* using open addressing with linear probing.
+* Used to quickly rule out duplicates before comparing the content of the elements.
+\*********************************************************************************************/
+class Queue_element_hash_set {
+public:
+
+  // Make sure nrElements can be added without growing the table.
+  void   reserve(size_t nrElements);
+
+  void   add(uint32_t hash);
+
+  void   remove(uint32_t hash);
+
+  // Nr of elements with this hash.
+  size_t count(uint32_t hash) const;
+
+  void   clear();
+
+  size_t getMemorySize() const {
+    return _table.capacity() * sizeof(entry);
+  }
+
+private:
+
+  struct entry {
+    uint32_t hash;
+    uint16_t count; // 0 = empty slot
+  };
+
+  // Return the slot holding the hash, or the empty slot where it should be stored.
+  size_t findSlot(uint32_t hash) const;
+
+  void   rebuild(size_t nrSlots);
+
+  std::vector<entry>_table;
+  size_t _nrUsed = 0;
+};
+
+
+#endif // ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_HASH_SET_H
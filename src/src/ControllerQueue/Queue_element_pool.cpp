@@ -0,0 +1,157 @@
+#include "../ControllerQueue/Queue_element_pool.h"
+
+#include "../Helpers/Memory.h"
+
+#include <stdlib.h>
+
+
+Queue_element_pool::~Queue_element_pool()
+{
+  freeSlab();
+}
+
+void Queue_element_pool::setNrRecords(size_t nrRecords)
+{
+  _nrRecords = nrRecords;
+
+  if ((_nrUsed == 0) && (_slabRecords != _nrRecords)) {
+    // Will be allocated again on the next allocation.
+    freeSlab();
+  }
+}
+
+void * Queue_element_pool::allocate(Queue_element_pool *pool, size_t size)
+{
+  uint8_t *record = nullptr;
+
+  if (pool != nullptr) {
+    record = static_cast<uint8_t *>(pool->allocateRecord(size));
+  }
+
+  if (record == nullptr) {
+    record = static_cast<uint8_t *>(malloc(headerSize() + size));
+
+    if (record == nullptr) {
+      return nullptr;
+    }
+
+    if (pool != nullptr) {
+      ++(pool->_nrHeap);
+    }
+  }
+  *reinterpret_cast<Queue_element_pool **>(record) = pool;
+  return record + headerSize();
+}
+
+void Queue_element_pool::release(void *ptr)
+{
+  if (ptr == nullptr) { return; }
+  uint8_t *record          = static_cast<uint8_t *>(ptr) - headerSize();
+  Queue_element_pool *pool = *reinterpret_cast<Queue_element_pool **>(record);
+
+  if (pool != nullptr) {
+    if (pool->owns(ptr)) {
+      pool->releaseRecord(record);
+      return;
+    }
+
+    if (pool->_nrHeap > 0) {
+      --(pool->_nrHeap);
+    }
+  }
+  free(record);
+}
+
+bool Queue_element_pool::owns(const void *ptr) const
+{
+  if (_slab == nullptr) { return false; }
+  const uint8_t *p = static_cast<const uint8_t *>(ptr);
+
+  return p >= _slab && p < (_slab + _slabRecords * _recordSize);
+}
+
+void * Queue_element_pool::allocateRecord(size_t size)
+{
+  if ((_nrUsed == 0) && (_slabRecords != _nrRecords)) {
+    // Number of records was changed while in use.
+    freeSlab();
+  }
+
+  if (_slab == nullptr) {
+    // All elements in a queue are of the same type,
+    // so the first allocation determines the record size.
+    const size_t align = headerSize();
+
+    if (!allocateSlab(((headerSize() + size + align - 1) / align) * align)) {
+      return nullptr;
+    }
+  }
+
+  if ((headerSize() + size) > _recordSize) {
+    return nullptr;
+  }
+
+  if (_freeList == nullptr) {
+    return nullptr;
+  }
+  void *record = _freeList;
+
+  _freeList = *static_cast<void **>(record);
+  ++_nrUsed;
+  return record;
+}
+
+void Queue_element_pool::releaseRecord(void *record)
+{
+  *static_cast<void **>(record) = _freeList;
+  _freeList                     = record;
+
+  if (_nrUsed > 0) {
+    --_nrUsed;
+  }
+
+  if ((_nrUsed == 0) && (_slabRecords != _nrRecords)) {
+    freeSlab();
+  }
+}
+
+bool Queue_element_pool::allocateSlab(size_t recordSize)
+{
+  if (_nrRecords == 0) { return false; }
+  {
+    #ifdef USE_SECOND_HEAP
+
+    // Elements have members which are not 32-bit aligned, so do not store in 2nd heap.
+    HeapSelectDram ephemeral;
+    #endif // ifdef USE_SECOND_HEAP
+
+    _slab = static_cast<uint8_t *>(special_calloc(_nrRecords, recordSize));
+  }
+
+  if (_slab == nullptr) {
+    return false;
+  }
+  _recordSize  = recordSize;
+  _slabRecords = _nrRecords;
+
+  // Link all records in the free list, first record on top.
+  _freeList = nullptr;
+
+  for (size_t i = _slabRecords; i > 0; --i) {
+    void *record = _slab + (i - 1) * _recordSize;
+    *static_cast<void **>(record) = _freeList;
+    _freeList                     = record;
+  }
+  return true;
+}
+
+void Queue_element_pool::freeSlab()
+{
+  if (_slab != nullptr) {
+    free(_slab);
+    _slab = nullptr;
+  }
+  _freeList    = nullptr;
+  _recordSize  = 0;
+  _slabRecords = 0;
+}
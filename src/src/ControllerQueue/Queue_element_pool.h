@@ -0,0 +1,91 @@
+#ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_POOL_H
+#define CONTROLLERQUEUE_QUEUE_ELEMENT_POOL_H
+
+
+#include "../../ESPEasy_common.h"
+
+#include <stddef.h>
+
+
+/*********************************************************************************************\
+* Queue_element_pool
+* Preallocated slab of fixed size records to store controller queue elements.
+*
+* The record size is set by the first element allocated from the pool,
+* as all elements in a controller queue are of the same type.
+* Elements which do not fit, or when the pool is exhausted, are allocated on the heap.
+*
+* Every allocation starts with a small header holding the pool it was requested from,
+* so it can be released without knowing where it was allocated.
+\*********************************************************************************************/
+class Queue_element_pool {
+public:
+
+  Queue_element_pool() = default;
+
+  ~Queue_element_pool();
+
+  Queue_element_pool(const Queue_element_pool& other) = delete;
+  Queue_element_pool& operator=(const Queue_element_pool& other) = delete;
+
+  // Set the number of records in the pool.
+  // The slab is (re)allocated on the next allocation when no record is in use.
+  void   setNrRecords(size_t nrRecords);
+
+  // Allocate from the pool when given, else from the heap.
+  // Return nullptr when out of memory.
+  static void* allocate(Queue_element_pool *pool,
+                        size_t              size);
+
+  static void  release(void *ptr);
+
+  // Return true when the element is stored in the slab of this pool.
+  bool         owns(const void *ptr) const;
+
+  // Memory in use by the records of allocated elements.
+  size_t       getUsedSize() const {
+    return _nrUsed * _recordSize;
+  }
+
+  // Memory allocated for the slab.
+  size_t getPoolSize() const {
+    return _slabRecords * _recordSize;
+  }
+
+  size_t getNrUsed() const {
+    return _nrUsed;
+  }
+
+  // Elements allocated on the heap as they did not fit in the pool.
+  size_t getNrHeapAllocated() const {
+    return _nrHeap;
+  }
+
+  // Size needed for the header to keep the element aligned.
+  static constexpr size_t headerSize() {
+    return alignof(max_align_t) > sizeof(Queue_element_pool *)
+      ? alignof(max_align_t)
+      : sizeof(Queue_element_pool *);
+  }
+
+private:
+
+  void* allocateRecord(size_t size);
+
+  void  releaseRecord(void *record);
+
+  bool  allocateSlab(size_t recordSize);
+
+  void  freeSlab();
+
+  uint8_t *_slab        = nullptr;
+  void    *_freeList    = nullptr;
+  size_t   _recordSize  = 0;
+  size_t   _nrRecords   = 0;
+  size_t   _slabRecords = 0;
+  size_t   _nrUsed      = 0;
+  size_t   _nrHeap      = 0;
+};
+
+
+#endif // ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_POOL_H
@@ -0,0 +1,63 @@
+#include "../ControllerQueue/Queue_element_ring.h"
+
+
+void Queue_element_ring::reserve(size_t nrElements)
+{
+  if (nrElements <= _buffer.size()) { return; }
+
+  // Move the elements to a new buffer, with the front at index 0
+  std::vector<element_ptr> buffer;
+
+  buffer.resize(nrElements);
+
+  for (size_t i = 0; i < _size; ++i) {
+    buffer[i] = std::move(operator[](i));
+  }
+  _buffer.swap(buffer);
+  _head = 0;
+  _hashes.reserve(nrElements);
+}
+
+void Queue_element_ring::push_back(element_ptr&& element)
+{
+  if (_size >= _buffer.size()) {
+    reserve(_buffer.empty() ? 4 : 2 * _buffer.size());
+  }
+
+  if (element) {
+    _hashes.add(element->_hash);
+  }
+  _buffer[wrap(_head + _size)] = std::move(element);
+  ++_size;
+}
+
+void Queue_element_ring::pop_front()
+{
+  if (_size == 0) { return; }
+
+  if (_buffer[_head]) {
+    _hashes.remove(_buffer[_head]->_hash);
+  }
+  _buffer[_head].reset();
+  _head = wrap(_head + 1);
+  --_size;
+}
+
+void Queue_element_ring::pop_back()
+{
+  if (_size == 0) { return; }
+
+  if (back()) {
+    _hashes.remove(back()->_hash);
+  }
+  back().reset();
+  --_size;
+}
+
+void Queue_element_ring::clear()
+{
+  while (_size > 0) {
+    pop_front();
+  }
+  _head = 0;
+}
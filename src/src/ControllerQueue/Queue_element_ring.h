@@ -0,0 +1,100 @@
+#ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_RING_H
+#define CONTROLLERQUEUE_QUEUE_ELEMENT_RING_H
+
+
+#include "../../ESPEasy_common.h"
+
+#include "../ControllerQueue/Queue_element_base.h"
+#include "../ControllerQueue/Queue_element_hash_set.h"
+
+#include <memory>
+#include <vector>
+
+
+/*********************************************************************************************\
+* Queue_element_ring
+* FIFO of controller queue elements, stored in a ring buffer.
+* The buffer is sized from the max. queue depth, so adding and removing elements
+* does not allocate memory for the container itself.
+* It only grows when more elements are added than reserved.
+*
+* The content hashes (_hash) of the stored elements are kept in a hash set,
+* so the hash must be set before the element is added.
+\*********************************************************************************************/
+class Queue_element_ring {
+public:
+
+  typedef std::unique_ptr<Queue_element_base> element_ptr;
+
+  bool   empty() const {
+    return _size == 0;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+  size_t capacity() const {
+    return _buffer.size();
+  }
+
+  // Make sure at least nrElements can be stored without allocating memory.
+  void               reserve(size_t nrElements);
+
+  // Index 0 is the front of the queue, the oldest element.
+  element_ptr      & operator[](size_t index) {
+    return _buffer[wrap(_head + index)];
+  }
+
+  const element_ptr& operator[](size_t index) const {
+    return _buffer[wrap(_head + index)];
+  }
+
+  element_ptr      & front() {
+    return _buffer[_head];
+  }
+
+  const element_ptr& front() const {
+    return _buffer[_head];
+  }
+
+  element_ptr      & back() {
+    return operator[](_size - 1);
+  }
+
+  const element_ptr& back() const {
+    return operator[](_size - 1);
+  }
+
+  void push_back(element_ptr&& element);
+
+  void pop_front();
+
+  void pop_back();
+
+  void clear();
+
+  // Nr of stored elements with this content hash.
+  size_t countHash(uint32_t hash) const {
+    return _hashes.count(hash);
+  }
+
+  // Memory used by the ring buffer itself.
+  size_t getMemorySize() const {
+    return _buffer.capacity() * sizeof(element_ptr) + _hashes.getMemorySize();
+  }
+
+private:
+
+  size_t wrap(size_t index) const {
+    return index >= _buffer.size() ? index - _buffer.size() : index;
+  }
+
+  std::vector<element_ptr>_buffer;
+  Queue_element_hash_set  _hashes;
+  size_t _head = 0;
+  size_t _size = 0;
+};
+
+
+#endif // ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_RING_H
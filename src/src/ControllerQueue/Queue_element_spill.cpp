@@ -0,0 +1,340 @@
+#include "../ControllerQueue/Queue_element_spill.h"
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+# include "../ControllerQueue/MQTT_queue_element.h"
+# include "../ControllerQueue/SimpleQueueElement_formatted_Strings.h"
+# include "../ControllerQueue/SimpleQueueElement_string_only.h"
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Helpers/FS_Helper.h"
+# include "../Helpers/StringConverter.h"
+
+// Record header: payload length (2 bytes) and element type (1 byte)
+# define QUEUE_ELEMENT_SPILL_HEADER_SIZE  3
+
+
+namespace {
+Queue_element_base* createElement(Queue_element_type_e type, Queue_element_pool& pool)
+{
+  switch (type) {
+    case Queue_element_type_e::SimpleQueueElement_formatted_Strings:
+      return new (pool) SimpleQueueElement_formatted_Strings();
+    case Queue_element_type_e::SimpleQueueElement_string_only:
+      return new (pool) simple_queue_element_string_only();
+    # if FEATURE_MQTT
+    case Queue_element_type_e::MQTT_queue_element:
+      return new (pool) MQTT_queue_element();
+    # endif // if FEATURE_MQTT
+    default:
+      break;
+  }
+  return nullptr;
+}
+} // namespace
+
+
+Queue_element_spill::~Queue_element_spill()
+{
+  clear();
+}
+
+void Queue_element_spill::init(controllerIndex_t controllerIndex)
+{
+  if (_controllerIndex == controllerIndex) { return; }
+  clear();
+  _controllerIndex = controllerIndex;
+  removeSegmentFiles();
+}
+
+bool Queue_element_spill::write(const Queue_element_base& element, bool deleteOldest)
+{
+  if (!enabled() || !validControllerIndex(_controllerIndex) ||
+      (element.getType() == Queue_element_type_e::NotSerializable)) {
+    return false;
+  }
+
+  if (_writeBuffer.capacity() == 0) {
+    _writeBuffer.reserve(CONTROLLER_QUEUE_SPILL_WRITE_SIZE + 64);
+  }
+  const size_t recordStart = _writeBuffer.size();
+
+  _writeBuffer.resize(recordStart + QUEUE_ELEMENT_SPILL_HEADER_SIZE);
+  element.serialize(_writeBuffer);
+
+  const size_t length = _writeBuffer.size() - recordStart - QUEUE_ELEMENT_SPILL_HEADER_SIZE;
+
+  if (length > 0xFFFF) {
+    _writeBuffer.resize(recordStart);
+    return false;
+  }
+  _writeBuffer[recordStart]     = length & 0xFF;
+  _writeBuffer[recordStart + 1] = (length >> 8) & 0xFF;
+  _writeBuffer[recordStart + 2] = static_cast<uint8_t>(element.getType());
+  ++_nrElementsInBuffer;
+  ++_nrElements;
+
+  if ((_writeBuffer.size() - _writeBufferReadPos) >= CONTROLLER_QUEUE_SPILL_WRITE_SIZE) {
+    if (!flushWriteBuffer(deleteOldest)) {
+      // Keep the elements already collected, but do not accept more.
+      _writeBuffer.resize(recordStart);
+      --_nrElementsInBuffer;
+      --_nrElements;
+      return false;
+    }
+  }
+  return true;
+}
+
+std::unique_ptr<Queue_element_base>Queue_element_spill::read(Queue_element_pool& pool)
+{
+  std::vector<uint8_t> record;
+
+  while (_nrElements != 0) {
+    const uint8_t *data = nullptr;
+    const uint8_t *end  = nullptr;
+
+    if (!_segments.empty()) {
+      if (!readRecord(record)) {
+        // Unable to read the rest of this segment file
+        removeOldestSegment();
+        continue;
+      }
+      data = record.data();
+      end  = data + record.size();
+    } else if (_nrElementsInBuffer != 0) {
+      // Not yet written to flash
+      data = &_writeBuffer[_writeBufferReadPos];
+      end  = data + QUEUE_ELEMENT_SPILL_HEADER_SIZE + (data[0] | (data[1] << 8));
+
+      _writeBufferReadPos += end - data;
+      --_nrElementsInBuffer;
+      --_nrElements;
+
+      if (_nrElementsInBuffer == 0) {
+        _writeBuffer.clear();
+        _writeBufferReadPos = 0;
+      }
+    } else {
+      _nrElements = 0;
+      break;
+    }
+
+    const Queue_element_type_e type = static_cast<Queue_element_type_e>(data[2]);
+
+    data += QUEUE_ELEMENT_SPILL_HEADER_SIZE;
+    std::unique_ptr<Queue_element_base> element(createElement(type, pool));
+
+    if (element && element->deserialize(data, end)) {
+      return element;
+    }
+    ++_nrDropped;
+  }
+  return std::unique_ptr<Queue_element_base>();
+}
+
+void Queue_element_spill::clear()
+{
+  while (!_segments.empty()) {
+    removeOldestSegment();
+  }
+  _writeBuffer.clear();
+  _writeBufferReadPos = 0;
+  _nrElementsInBuffer = 0;
+  _nrElements         = 0;
+}
+
+size_t Queue_element_spill::getFlashSize() const
+{
+  size_t res = 0;
+
+  for (auto it = _segments.begin(); it != _segments.end(); ++it) {
+    res += it->size;
+  }
+  return res;
+}
+
+bool Queue_element_spill::flushWriteBuffer(bool deleteOldest)
+{
+  const size_t nrBytes = _writeBuffer.size() - _writeBufferReadPos;
+
+  if (nrBytes == 0) { return true; }
+
+  if (_segments.empty() ||
+      ((_segments.back().size != 0) && ((_segments.back().size + nrBytes) > CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE))) {
+    // Start a new segment file
+    if (_segments.size() >= _maxSegments) {
+      if (!deleteOldest || _segments.empty()) {
+        return false;
+      }
+      removeOldestSegment();
+    }
+    Segment segment;
+    segment.nr = _nextSegmentNr++;
+    _segments.push_back(segment);
+  }
+  Segment& segment = _segments.back();
+
+  if ((_segments.size() == 1) && _readFile) {
+    // Do not read and append to the same file at the same time.
+    _readFile.close();
+  }
+
+  fs::File f = ESPEASY_FS.open(getSegmentFilename(segment.nr), "a");
+
+  if (!f) {
+    if (segment.size == 0) {
+      _segments.pop_back();
+    }
+    return false;
+  }
+  const size_t bytesWritten = f.write(&_writeBuffer[_writeBufferReadPos], nrBytes);
+
+  f.close();
+  ++_nrFlashWrites;
+
+  if (bytesWritten != nrBytes) {
+    // The partial record at the end of the file is never read,
+    // as only the elements counted in the segment are read.
+    // Start a new segment on the next write.
+    segment.size = CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE;
+    # ifndef BUILD_NO_DEBUG
+
+    if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+      addLogMove(LOG_LEVEL_ERROR, strformat(
+                   F("Controller-%d : Error writing queue to %s"),
+                   _controllerIndex + 1,
+                   getSegmentFilename(segment.nr).c_str()));
+    }
+    # endif // ifndef BUILD_NO_DEBUG
+    return false;
+  }
+  segment.size       += nrBytes;
+  segment.nrElements += _nrElementsInBuffer;
+  _nrElementsInBuffer = 0;
+  _writeBuffer.clear();
+  _writeBufferReadPos = 0;
+  return true;
+}
+
+bool Queue_element_spill::readRecord(std::vector<uint8_t>& record)
+{
+  Segment& segment = _segments.front();
+
+  if (segment.nrElements == 0) { return false; }
+
+  if (!_readFile) {
+    _readFile = ESPEASY_FS.open(getSegmentFilename(segment.nr), "r");
+
+    if (!_readFile) { return false; }
+
+    if ((_readPos != 0) && !_readFile.seek(_readPos)) {
+      return false;
+    }
+  }
+  uint8_t header[QUEUE_ELEMENT_SPILL_HEADER_SIZE]{};
+
+  if (_readFile.read(header, QUEUE_ELEMENT_SPILL_HEADER_SIZE) != QUEUE_ELEMENT_SPILL_HEADER_SIZE) {
+    return false;
+  }
+  const size_t length = header[0] | (header[1] << 8);
+
+  if ((_readPos + QUEUE_ELEMENT_SPILL_HEADER_SIZE + length) > segment.size) {
+    return false;
+  }
+  record.resize(QUEUE_ELEMENT_SPILL_HEADER_SIZE + length);
+  memcpy(&record[0], header, QUEUE_ELEMENT_SPILL_HEADER_SIZE);
+
+  if ((length != 0) && (_readFile.read(&record[QUEUE_ELEMENT_SPILL_HEADER_SIZE], length) != length)) {
+    return false;
+  }
+  _readPos += record.size();
+  --segment.nrElements;
+  --_nrElements;
+
+  if (segment.nrElements == 0) {
+    // All read, no longer needed.
+    removeOldestSegment();
+  }
+  return true;
+}
+
+void Queue_element_spill::removeOldestSegment()
+{
+  if (_segments.empty()) { return; }
+
+  if (_readFile) {
+    _readFile.close();
+  }
+  const Segment& segment = _segments.front();
+
+  if (segment.nrElements != 0) {
+    _nrElements -= segment.nrElements;
+    _nrDropped  += segment.nrElements;
+    # ifndef BUILD_NO_DEBUG
+
+    if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+      addLogMove(LOG_LEVEL_DEBUG, strformat(
+                   F("Controller-%d : Removed %d queued messages from flash"),
+                   _controllerIndex + 1,
+                   segment.nrElements));
+    }
+    # endif // ifndef BUILD_NO_DEBUG
+  }
+  ESPEASY_FS.remove(getSegmentFilename(segment.nr));
+  _segments.erase(_segments.begin());
+  _readPos = 0;
+}
+
+String Queue_element_spill::getSegmentFilename(uint16_t segmentNr) const
+{
+  String fname;
+
+  # ifdef ESP32
+  fname = '/';
+  # endif // ifdef ESP32
+  fname += strformat(F("ctrlq%d_%u.bin"), _controllerIndex + 1, segmentNr);
+  return fname;
+}
+
+void Queue_element_spill::removeSegmentFiles()
+{
+  if (!validControllerIndex(_controllerIndex)) { return; }
+
+  const String prefix = strformat(F("ctrlq%d_"), _controllerIndex + 1);
+  std::vector<String> filenames;
+
+  # ifdef ESP8266
+  fs::Dir dir = ESPEASY_FS.openDir(F("/"));
+
+  while (dir.next()) {
+    if (dir.fileName().startsWith(prefix)) {
+      filenames.push_back(dir.fileName());
+    }
+  }
+  # endif // ifdef ESP8266
+  # ifdef ESP32
+  fs::File root = ESPEASY_FS.open(F("/"));
+  fs::File file = root.openNextFile();
+
+  while (file) {
+    if (!file.isDirectory()) {
+      String fname(file.name());
+
+      if (fname.startsWith(F("/"))) {
+        fname = fname.substring(1);
+      }
+
+      if (fname.startsWith(prefix)) {
+        filenames.push_back(concat(F("/"), fname));
+      }
+    }
+    file = root.openNextFile();
+  }
+  # endif // ifdef ESP32
+
+  for (auto it = filenames.begin(); it != filenames.end(); ++it) {
+    ESPEASY_FS.remove(*it);
+  }
+}
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
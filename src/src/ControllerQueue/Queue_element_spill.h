@@ -0,0 +1,133 @@
+#ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_SPILL_H
+#define CONTROLLERQUEUE_QUEUE_ELEMENT_SPILL_H
+
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+# include "../ControllerQueue/Queue_element_base.h"
+# include "../ControllerQueue/Queue_element_pool.h"
+# include "../DataTypes/ControllerIndex.h"
+
+# include <FS.h>
+# include <memory>
+# include <vector>
+
+
+/*********************************************************************************************\
+* Queue_element_spill
+* Overflow of a controller queue to the file system, e.g. during network outages.
+* Elements which do not fit in the queue in RAM are stored in a compact binary form
+* and read back in the same order when the queue has room again.
+*
+* Like the RTC cache of C016, the data is appended to numbered segment files,
+* which are removed as soon as all elements in it are read.
+* The number of segment files is the flash budget.
+*
+* To limit the number of flash writes, elements are collected in RAM and appended
+* to the segment file in chunks of CONTROLLER_QUEUE_SPILL_WRITE_SIZE bytes.
+* Elements still in this write buffer are read back without writing them to flash.
+*
+* Spilled elements only live as long as the controller queue itself.
+* Files left from before a reboot are removed in init().
+*
+* Segment files are not settings files, so they are accessed directly via ESPEASY_FS
+* and not via tryOpenFile()/tryDeleteFile(), which clear the settings and file caches.
+\*********************************************************************************************/
+class Queue_element_spill {
+public:
+
+  ~Queue_element_spill();
+
+  // Set the controller, used in the segment file names.
+  // Removes segment files of this controller left from before a reboot.
+  void   init(controllerIndex_t controllerIndex);
+
+  // Flash budget in segment files, 0 disables spilling.
+  // Already spilled elements can still be read.
+  void   setMaxSegments(uint8_t maxSegments) {
+    _maxSegments = maxSegments;
+  }
+
+  bool   enabled() const {
+    return _maxSegments != 0;
+  }
+
+  bool   empty() const {
+    return _nrElements == 0;
+  }
+
+  // Nr of spilled elements, on flash and in the write buffer.
+  size_t size() const {
+    return _nrElements;
+  }
+
+  // Append the element.
+  // When the flash budget is used up, the oldest segment is removed if deleteOldest is set.
+  // Return false when the element was not stored.
+  bool   write(const Queue_element_base& element,
+               bool                      deleteOldest);
+
+  // Read the oldest element, allocated from the pool.
+  // Return an empty pointer when there is nothing to read.
+  std::unique_ptr<Queue_element_base>read(Queue_element_pool& pool);
+
+  // Remove all spilled elements and segment files.
+  void     clear();
+
+  // Bytes stored in segment files.
+  size_t   getFlashSize() const;
+
+  uint8_t  getNrSegments() const {
+    return _segments.size();
+  }
+
+  uint32_t getNrFlashWrites() const {
+    return _nrFlashWrites;
+  }
+
+  // Elements lost, due to the flash budget or invalid data.
+  uint32_t getNrDropped() const {
+    return _nrDropped;
+  }
+
+private:
+
+  struct Segment {
+    uint16_t nr{};
+    uint16_t nrElements{};
+    uint32_t size{};
+  };
+
+  // Append the unread part of the write buffer to the last segment file.
+  bool   flushWriteBuffer(bool deleteOldest);
+
+  // Read the next record of the oldest segment file into 'record'.
+  bool   readRecord(std::vector<uint8_t>& record);
+
+  // Remove the oldest segment file and the elements not yet read from it.
+  void   removeOldestSegment();
+
+  String getSegmentFilename(uint16_t segmentNr) const;
+
+  // Remove segment files of this controller, which may be left after a reboot.
+  void   removeSegmentFiles();
+
+  std::vector<Segment>_segments;
+  std::vector<uint8_t>_writeBuffer;
+  fs::File _readFile;
+  size_t _writeBufferReadPos{};
+  size_t _nrElements{};
+  size_t _nrElementsInBuffer{};
+  uint32_t _readPos{};
+  uint32_t _nrFlashWrites{};
+  uint32_t _nrDropped{};
+  uint16_t _nextSegmentNr{};
+  controllerIndex_t _controllerIndex = INVALID_CONTROLLER_INDEX;
+  uint8_t _maxSegments{};
+};
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
+#endif // ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_SPILL_H
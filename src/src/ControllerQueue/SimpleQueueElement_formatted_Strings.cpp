@@ -73,6 +73,60 @@ size_t SimpleQueueElement_formatted_Strings::getSize() const {
   return total;
 }
 
+uint32_t SimpleQueueElement_formatted_Strings::computeHash() const {
+  // The formatted values may be set after the element was added to the queue.
+  uint32_t hash = Queue_element_base::computeHash();
+
+  hash = addToHash(hash, static_cast<uint32_t>(_taskIndex));
+  hash = addToHash(hash, static_cast<uint32_t>(sensorType));
+  hash = addToHash(hash, static_cast<uint32_t>(valueCount));
+  hash = addToHash(hash, static_cast<uint32_t>(idx));
+  return hash;
+}
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+void SimpleQueueElement_formatted_Strings::serialize(std::vector<uint8_t>& buffer) const {
+  Queue_element_base::serialize(buffer);
+  serializeValue(buffer, idx,                               4);
+  serializeValue(buffer, static_cast<uint32_t>(sensorType), 1);
+  serializeValue(buffer, valuesSent,                        1);
+  serializeValue(buffer, valueCount,                        1);
+
+  for (uint8_t i = 0; i < valueCount && i < VARS_PER_TASK; ++i) {
+    serializeString(buffer, txt[i]);
+  }
+}
+
+bool SimpleQueueElement_formatted_Strings::deserialize(const uint8_t *& data, const uint8_t *end) {
+  uint32_t value_idx{};
+  uint32_t value_sensorType{};
+  uint32_t value_valuesSent{};
+  uint32_t value_valueCount{};
+
+  if (!Queue_element_base::deserialize(data, end) ||
+      !deserializeValue(data, end, value_idx,        4) ||
+      !deserializeValue(data, end, value_sensorType, 1) ||
+      !deserializeValue(data, end, value_valuesSent, 1) ||
+      !deserializeValue(data, end, value_valueCount, 1) ||
+      (value_valueCount > VARS_PER_TASK)) {
+    return false;
+  }
+  idx        = value_idx;
+  sensorType = static_cast<Sensor_VType>(value_sensorType);
+  valuesSent = value_valuesSent;
+  valueCount = value_valueCount;
+
+  for (uint8_t i = 0; i < valueCount; ++i) {
+    if (!deserializeString(data, end, txt[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
 bool SimpleQueueElement_formatted_Strings::isDuplicate(const Queue_element_base& rval) const {
   const SimpleQueueElement_formatted_Strings& oth = static_cast<const SimpleQueueElement_formatted_Strings&>(rval);
 
@@ -14,6 +14,28 @@ size_t simple_queue_element_string_only::getSize() const {
   return sizeof(*this) + txt.length();
 }
 
+uint32_t simple_queue_element_string_only::computeHash() const {
+  uint32_t hash = Queue_element_base::computeHash();
+
+  hash = addToHash(hash, static_cast<uint32_t>(_taskIndex));
+  hash = addToHash(hash, txt);
+  return hash;
+}
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+void simple_queue_element_string_only::serialize(std::vector<uint8_t>& buffer) const {
+  Queue_element_base::serialize(buffer);
+  serializeString(buffer, txt);
+}
+
+bool simple_queue_element_string_only::deserialize(const uint8_t *& data, const uint8_t *end) {
+  return Queue_element_base::deserialize(data, end) &&
+         deserializeString(data, end, txt);
+}
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
 bool simple_queue_element_string_only::isDuplicate(const Queue_element_base& other) const {
   const simple_queue_element_string_only& oth = static_cast<const simple_queue_element_string_only&>(other);
 
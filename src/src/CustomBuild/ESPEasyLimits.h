@@ -127,6 +127,21 @@
 #ifndef RULES_BUFFER_SIZE
   #define RULES_BUFFER_SIZE                  64
 #endif
+// Read-ahead cache per rules file, used when rules are not kept in memory as pre-compiled lines.
+#ifndef RULES_FILE_CACHE_BLOCK_SIZE
+  # ifdef ESP32
+    # define RULES_FILE_CACHE_BLOCK_SIZE     512
+  # else
+    # define RULES_FILE_CACHE_BLOCK_SIZE     256
+  # endif
+#endif
+#ifndef RULES_FILE_CACHE_NR_BLOCKS
+  # ifdef ESP32
+    # define RULES_FILE_CACHE_NR_BLOCKS        4
+  # else
+    # define RULES_FILE_CACHE_NR_BLOCKS        2
+  # endif
+#endif
 
 #ifndef RULES_IF_MAX_NESTING_LEVEL
   #define RULES_IF_MAX_NESTING_LEVEL          4
@@ -156,6 +171,55 @@
 #ifndef TIMER_GRATUITOUS_ARP_MAX
   #define TIMER_GRATUITOUS_ARP_MAX           5000
 #endif
+// Time budget (usec) of a single action handled by the scheduler.
+// Work which can be split up will be continued in a next loop when exceeding this budget.
+// Set to 0 to disable.
+#ifndef SCHEDULER_SLICE_BUDGET_USEC
+  #define SCHEDULER_SLICE_BUDGET_USEC        20000
+#endif
+// Max. number of HTTP client connections kept open (keep-alive) for HTTP controllers and SendToHTTP.
+#ifndef HTTP_CLIENT_POOL_MAX_SOCKETS
+  #ifdef ESP32
+    #define HTTP_CLIENT_POOL_MAX_SOCKETS     4
+  #else
+    #define HTTP_CLIENT_POOL_MAX_SOCKETS     2
+  #endif
+#endif
+// Close kept open HTTP client connections when idle for this time (msec).
+// Should be shorter than the keep-alive timeout of most servers (typically 5 sec or more)
+#ifndef HTTP_CLIENT_POOL_IDLE_TIMEOUT
+  #define HTTP_CLIENT_POOL_IDLE_TIMEOUT      4000
+#endif
+
+// Number of ExtraTaskSettings kept in RAM by LoadTaskSettings(), to prevent reading them from flash
+// when switching between tasks. More slots are used on ESP32 with PSRAM.
+#ifndef EXTRA_TASK_SETTINGS_CACHE_SLOTS
+  #ifdef ESP32
+    #define EXTRA_TASK_SETTINGS_CACHE_SLOTS        4
+  #else
+    #define EXTRA_TASK_SETTINGS_CACHE_SLOTS        2
+  #endif
+#endif
+#ifndef EXTRA_TASK_SETTINGS_CACHE_SLOTS_PSRAM
+  #define EXTRA_TASK_SETTINGS_CACHE_SLOTS_PSRAM    16
+#endif
+
+// Settings write-back: Saved settings are written to flash when no other settings were saved
+// for SETTINGS_WRITE_BACK_DELAY msec, or at most SETTINGS_WRITE_BACK_MAX_DELAY msec after the first save.
+// Pending data is written immediately when it would exceed SETTINGS_WRITE_BACK_MAX_PENDING bytes.
+#ifndef SETTINGS_WRITE_BACK_DELAY
+  #define SETTINGS_WRITE_BACK_DELAY          1000
+#endif
+#ifndef SETTINGS_WRITE_BACK_MAX_DELAY
+  #define SETTINGS_WRITE_BACK_MAX_DELAY      5000
+#endif
+#ifndef SETTINGS_WRITE_BACK_MAX_PENDING
+  #ifdef ESP32
+    #define SETTINGS_WRITE_BACK_MAX_PENDING  16384
+  #else
+    #define SETTINGS_WRITE_BACK_MAX_PENDING  4096
+  #endif
+#endif
 
 #define DOMOTICZ_MAX_IDX            999999999 // Looks like it is an unsigned int, so could be up to 4 bln.
 
@@ -2774,6 +2774,24 @@ To create/register a plugin, you have to :
   #define FEATURE_RTC_CACHE_STORAGE 1
 #endif
 
+// Store controller queue elements on the file system when the queue in RAM is full.
+#ifndef FEATURE_CONTROLLER_QUEUE_SPILL
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_CONTROLLER_QUEUE_SPILL  0
+  #else
+    #define FEATURE_CONTROLLER_QUEUE_SPILL  1
+  #endif
+#endif
+
+// Collect settings saves in RAM for a short while and write them to the file system together.
+#ifndef FEATURE_SETTINGS_WRITE_BACK
+  #ifdef LIMIT_BUILD_SIZE
+    #define FEATURE_SETTINGS_WRITE_BACK  0
+  #else
+    #define FEATURE_SETTINGS_WRITE_BACK  1
+  #endif
+#endif
+
 
 
 // P098 PWM motor needs P003 pulse
@@ -5,6 +5,7 @@
 #include "../Globals/Settings.h"
 #include "../Globals/WiFi_AP_Candidates.h"
 
+#include "../Helpers/CRC_functions.h"
 #include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/StringConverter.h"
 
@@ -28,16 +29,31 @@ void Caches::clearAllTaskCaches() {
   taskIndexName.clear();
   taskIndexValueName.clear();
   extraTaskSettings_cache.clear();
+  extraTaskSettings_lru.clear();
+  compiledFormula_cache.clear();
   updateActiveTaskUseSerial0();
+  ++settingsGeneration;
 }
 
 void Caches::clearTaskCache(taskIndex_t TaskIndex) {
   clearTaskIndexFromMaps(TaskIndex);
+  extraTaskSettings_lru.erase(TaskIndex);
 
   auto it = extraTaskSettings_cache.find(TaskIndex);
 
   if (it != extraTaskSettings_cache.end()) {
     extraTaskSettings_cache.erase(it);
+
+    // Only when something was cached, there may be something derived from it.
+    ++settingsGeneration;
+  }
+
+  for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
+    auto it_formula = compiledFormula_cache.find(makeWord(TaskIndex, i));
+
+    if (it_formula != compiledFormula_cache.end()) {
+      compiledFormula_cache.erase(it_formula);
+    }
   }
   updateActiveTaskUseSerial0();
 }
@@ -209,6 +225,62 @@ String Caches::getTaskDeviceFormula(taskIndex_t TaskIndex, uint8_t rel_index)
   return EMPTY_STRING;
 }
 
+const CompiledExpression * Caches::getCompiledFormula(taskIndex_t TaskIndex, uint8_t rel_index)
+{
+  if (!hasFormula(TaskIndex, rel_index)) {
+    return nullptr;
+  }
+
+  auto it = compiledFormula_cache.find(makeWord(TaskIndex, rel_index));
+
+  if ((it == compiledFormula_cache.end()) || !it->second.expression.isCompiled()) {
+    return nullptr;
+  }
+  return &(it->second.expression);
+}
+
+void Caches::updateCompiledFormula(taskIndex_t TaskIndex, uint8_t rel_index, const char *formula)
+{
+  const uint16_t key = makeWord(TaskIndex, rel_index);
+  auto it            = compiledFormula_cache.find(key);
+
+  if (formula[0] == 0) {
+    if (it != compiledFormula_cache.end()) {
+      compiledFormula_cache.erase(it);
+    }
+    return;
+  }
+
+  const uint32_t formulaCRC = calc_CRC32(reinterpret_cast<const uint8_t *>(formula), strlen(formula));
+
+  if ((it != compiledFormula_cache.end()) && (it->second.formulaCRC == formulaCRC)) {
+    // Formula not changed, no need to compile again
+    return;
+  }
+
+  CompiledFormula_t compiled;
+
+  compiled.formulaCRC = formulaCRC;
+
+  // Only compile when no parseTemplate is needed, apart from %value% and %pvalue%
+  String check(formula);
+
+  check.replace(F("%value%"),  EMPTY_STRING);
+  check.replace(F("%pvalue%"), EMPTY_STRING);
+
+  if ((check.indexOf('[') == -1) &&
+      (check.indexOf('{') == -1) &&
+      (check.indexOf('%') == -1)) {
+    const __FlashStringHelper *const variableNames[] = { F("%value%"), F("%pvalue%") };
+
+    if (isError(compiled.expression.compile(formula, variableNames, NR_ELEMENTS(variableNames)))) {
+      compiled.expression.clear();
+    }
+  }
+
+  compiledFormula_cache[key] = std::move(compiled);
+}
+
 long Caches::getTaskDevicePluginConfigLong(taskIndex_t TaskIndex, uint8_t rel_index)
 {
   if (validTaskIndex(TaskIndex) && (rel_index < PLUGIN_EXTRACONFIGVAR_MAX)) {
@@ -333,6 +405,7 @@ void Caches::updateExtraTaskSettingsCache()
         tmp.TaskDeviceFormula[i] = std::move(formula);
         #endif // ifdef ESP32
       }
+      updateCompiledFormula(TaskIndex, i, ExtraTaskSettings.TaskDeviceFormula[i]);
       tmp.decimals[i] = ExtraTaskSettings.TaskDeviceValueDecimals[i];
       #if FEATURE_PLUGIN_STATS
 
@@ -367,6 +440,17 @@ void Caches::updateExtraTaskSettingsCache_afterLoad_Save()
     return;
   }
 
+  bool wasCached = false;
+  ChecksumType prevChecksum;
+  {
+    auto it = extraTaskSettings_cache.find(ExtraTaskSettings.TaskIndex);
+
+    if (it != extraTaskSettings_cache.end()) {
+      wasCached    = true;
+      prevChecksum = it->second.md5checksum;
+    }
+  }
+
   // First update all other values
   updateExtraTaskSettingsCache();
 
@@ -378,6 +462,11 @@ void Caches::updateExtraTaskSettingsCache_afterLoad_Save()
       bitWrite(it->second.defaultTaskDeviceValueName, i, ExtraTaskSettings.isDefaultTaskVarName(i));
     }
     it->second.md5checksum = ExtraTaskSettings.computeChecksum();
+
+    if (!wasCached || !(prevChecksum == it->second.md5checksum)) {
+      // Task settings are new or have changed, e.g. task name or value names
+      ++settingsGeneration;
+    }
   }
 }
 
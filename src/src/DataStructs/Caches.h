@@ -5,6 +5,7 @@
 #include "../../ESPEasy_common.h"
 #include "../CustomBuild/ESPEasyLimits.h"
 #include "../DataStructs/ChecksumType.h"
+#include "../DataStructs/ExtraTaskSettingsLRU.h"
 #ifdef ESP32
 # include "../DataStructs/ControllerSettingsStruct.h"
 # include "../DataTypes/ControllerIndex.h"
@@ -16,6 +17,7 @@
 
 #include "../Globals/Plugins.h"
 
+#include "../Helpers/Rules_calculate.h"
 #include "../Helpers/RulesHelper.h"
 
 #include <map>
@@ -54,11 +56,22 @@ struct ExtraTaskSettings_cache_t {
   uint8_t hasFormula = 0; // Bitmap which task value has formula and whether a formula needs previous value
 };
 
+// Task value formula, compiled with %value% and %pvalue% bound as variables.
+// The expression is left empty when the formula cannot be compiled,
+// e.g. when it refers to other task values or system variables.
+struct CompiledFormula_t {
+  uint32_t           formulaCRC{};
+  CompiledExpression expression;
+};
+
 typedef std::map<String, taskIndex_t>                    TaskIndexNameMap;
 typedef std::map<String, uint8_t>                        TaskIndexValueNameMap;
 typedef std::map<String, uint8_t>                        FilePresenceMap;
 typedef std::map<taskIndex_t, ExtraTaskSettings_cache_t> ExtraTaskSettingsMap;
 
+// Key is makeWord(taskIndex, taskVarIndex)
+typedef std::map<uint16_t, CompiledFormula_t>            CompiledFormulaMap;
+
 #ifdef ESP32
 typedef std::map<controllerIndex_t, ControllerSettingsStruct> ControllerSettingsMap;
 #endif // ifdef ESP32
@@ -94,6 +107,11 @@ struct Caches {
   String  getTaskDeviceFormula(taskIndex_t TaskIndex,
                                uint8_t     rel_index);
 
+  // Return the compiled formula, or nullptr when the formula could not be compiled.
+  // N.B. %value% is variable 0, %pvalue% is variable 1
+  const CompiledExpression* getCompiledFormula(taskIndex_t TaskIndex,
+                                               uint8_t     rel_index);
+
   long    getTaskDevicePluginConfigLong(taskIndex_t TaskIndex,
                                         uint8_t     rel_index);
 
@@ -134,6 +152,10 @@ private:
 
   void                                 clearTaskIndexFromMaps(taskIndex_t TaskIndex);
 
+  void                                 updateCompiledFormula(taskIndex_t TaskIndex,
+                                                             uint8_t     rel_index,
+                                                             const char *formula);
+
 public:
 
   TaskIndexNameMap      taskIndexName;
@@ -141,10 +163,15 @@ public:
   FilePresenceMap       fileExistsMap;
   RulesHelperClass      rulesHelper;
 
+  // Full ExtraTaskSettings of the last loaded tasks, used by LoadTaskSettings()
+  ExtraTaskSettingsLRU  extraTaskSettings_lru;
+
 private:
 
   ExtraTaskSettingsMap extraTaskSettings_cache;
 
+  CompiledFormulaMap compiledFormula_cache;
+
   #ifdef ESP32
 
   // Only cache Controller Settings on ESP32 due to memory restrictions on ESP8266
@@ -156,6 +183,10 @@ public:
   ChecksumType controllerSettings_checksums[CONTROLLER_MAX] = {};
   uint32_t     fileCacheClearMoment                         = 0;
 
+  // Incremented whenever task caches are cleared, thus when task names, value names, etc. may have changed.
+  // Used to invalidate anything derived from these settings, like compiled templates.
+  uint32_t settingsGeneration = 0;
+
 
   bool activeTaskUseSerial0 = false;
 };
@@ -44,6 +44,9 @@ void ControllerSettingsStruct::reset() {
   VariousBits1.allowExpire                      = 0;
   VariousBits1.deduplicate                      = 0;
   VariousBits1.useLocalSystemTime               = 0;
+  VariousBits1.batchSend                        = 0;
+  VariousBits1.adaptiveSendRate                 = 0;
+  VariousBits1.spillSegments                    = 0;
 
   safe_strncpy(ClientID, F(CONTROLLER_DEFAULT_CLIENTID), sizeof(ClientID));
 }
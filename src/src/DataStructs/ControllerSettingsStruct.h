@@ -49,6 +49,35 @@
 # define CONTROLLER_CLIENTTIMEOUT_DFLT     100
 #endif // ifndef CONTROLLER_CLIENTTIMEOUT_DFLT
 
+// Batch send: max. number of queued messages handed to the controller in one go
+// and max. time in msec the oldest message may wait for the batch to fill up.
+#ifndef CONTROLLER_BATCH_MAX_ELEMENTS
+# ifdef ESP32
+#  define CONTROLLER_BATCH_MAX_ELEMENTS  16
+# else // ifdef ESP32
+#  define CONTROLLER_BATCH_MAX_ELEMENTS  8
+# endif // ifdef ESP32
+#endif // ifndef CONTROLLER_BATCH_MAX_ELEMENTS
+#ifndef CONTROLLER_BATCH_MAX_WAIT
+# define CONTROLLER_BATCH_MAX_WAIT       500
+#endif // ifndef CONTROLLER_BATCH_MAX_WAIT
+
+// Adaptive send rate: max. time in msec between messages when the controller is slow or fails.
+// The configured minimum send interval is the lower bound.
+#ifndef CONTROLLER_ADAPTIVE_MAX_DELAY
+# define CONTROLLER_ADAPTIVE_MAX_DELAY   10000
+#endif // ifndef CONTROLLER_ADAPTIVE_MAX_DELAY
+
+// Spill to file system: size of a segment file, which is also the unit of the flash budget.
+// Elements are collected in RAM and appended to the segment file in chunks of CONTROLLER_QUEUE_SPILL_WRITE_SIZE bytes.
+#ifndef CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE
+# define CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE  4096
+#endif // ifndef CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE
+#ifndef CONTROLLER_QUEUE_SPILL_WRITE_SIZE
+# define CONTROLLER_QUEUE_SPILL_WRITE_SIZE    512
+#endif // ifndef CONTROLLER_QUEUE_SPILL_WRITE_SIZE
+#define CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS   255
+
 #ifndef CONTROLLER_DEFAULT_CLIENTID
 # define CONTROLLER_DEFAULT_CLIENTID  "%sysname%_%unit%"
 #endif // ifndef CONTROLLER_DEFAULT_CLIENTID
@@ -70,9 +99,12 @@ struct ControllerSettingsStruct
     CONTROLLER_MAX_QUEUE_DEPTH,
     CONTROLLER_MAX_RETRIES,
     CONTROLLER_FULL_QUEUE_ACTION,
+    CONTROLLER_SPILL_BUDGET,
     CONTROLLER_ALLOW_EXPIRE,
     CONTROLLER_DEDUPLICATE,
     CONTROLLER_USE_LOCAL_SYSTEM_TIME,
+    CONTROLLER_BATCH_SEND,
+    CONTROLLER_ADAPTIVE_SEND_RATE,
     CONTROLLER_CHECK_REPLY,
     CONTROLLER_CLIENT_ID,
     CONTROLLER_UNIQUE_CLIENT_ID_RECONNECT,
@@ -155,6 +187,17 @@ struct ControllerSettingsStruct
   bool         useLocalSystemTime() const { return VariousBits1.useLocalSystemTime; }
   void         useLocalSystemTime(bool value) { VariousBits1.useLocalSystemTime = value; }
 
+  bool         batchSend() const { return VariousBits1.batchSend; }
+  void         batchSend(bool value) { VariousBits1.batchSend = value; }
+
+  bool         adaptiveSendRate() const { return VariousBits1.adaptiveSendRate; }
+  void         adaptiveSendRate(bool value) { VariousBits1.adaptiveSendRate = value; }
+
+  // Max. nr of segment files (CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE) to store queued messages which do not fit in RAM.
+  // 0 = disabled
+  uint8_t      spillSegments() const { return VariousBits1.spillSegments; }
+  void         spillSegments(uint8_t value) { VariousBits1.spillSegments = value; }
+
   bool         UseDNS;
   uint8_t      IP[4];
   unsigned int Port;
@@ -185,16 +228,9 @@ struct ControllerSettingsStruct
     uint32_t allowExpire                      : 1; // Bit 09
     uint32_t deduplicate                      : 1; // Bit 10
     uint32_t useLocalSystemTime               : 1; // Bit 11
-    uint32_t unused_12                        : 1; // Bit 12
-    uint32_t unused_13                        : 1; // Bit 13
-    uint32_t unused_14                        : 1; // Bit 14
-    uint32_t unused_15                        : 1; // Bit 15
-    uint32_t unused_16                        : 1; // Bit 16
-    uint32_t unused_17                        : 1; // Bit 17
-    uint32_t unused_18                        : 1; // Bit 18
-    uint32_t unused_19                        : 1; // Bit 19
-    uint32_t unused_20                        : 1; // Bit 20
-    uint32_t unused_21                        : 1; // Bit 21
+    uint32_t batchSend                        : 1; // Bit 12
+    uint32_t adaptiveSendRate                 : 1; // Bit 13
+    uint32_t spillSegments                    : 8; // Bit 14 - 21
     uint32_t unused_22                        : 1; // Bit 22
     uint32_t unused_23                        : 1; // Bit 23
     uint32_t unused_24                        : 1; // Bit 24
@@ -2,77 +2,72 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../Globals/Settings.h"
+#include "../Helpers/CRC_functions.h"
 #include "../Helpers/Misc.h"
 #include "../Helpers/StringConverter.h"
 
+static_assert((EVENTQUEUE_MAX_NR_ELEMENTS & (EVENTQUEUE_MAX_NR_ELEMENTS - 1)) == 0, "EVENTQUEUE_MAX_NR_ELEMENTS must be a power of 2");
+static_assert(EVENTQUEUE_MAX_NR_ELEMENTS < 0xFFFF, "EVENTQUEUE_MAX_NR_ELEMENTS too large");
+static_assert(EVENTQUEUE_TEXT_SIZE <= 0xFFFF,      "EVENTQUEUE_TEXT_SIZE too large");
 
 
 void EventQueueStruct::add(const String& event, bool deduplicate)
 {
-  if (!deduplicate || !isDuplicate(event)) {
-    #ifdef USE_SECOND_HEAP
-    String tmp;
-    reserve_special(tmp, event.length());
-    tmp = event;
-
-    // Do not add to the list while on 2nd heap
-    HeapSelectDram ephemeral;
+  // Split the event in name and value, so the name can be interned.
+  const char *str = event.c_str();
+  const int   len = event.length();
+  const int   pos = event.indexOf('=');
 
-    _eventQueue.emplace_back(std::move(tmp));
-    #else
-    _eventQueue.push_back(event);
-    #endif // ifdef USE_SECOND_HEAP
+  if (pos < 0) {
+    addElement(
+      EventQueueElement::Type::Text, INVALID_TASK_INDEX,
+      str, len, internName(str, len),
+      EventQueueElement::ValueType::None, nullptr, 0, 0,
+      deduplicate);
+  } else {
+    addElement(
+      EventQueueElement::Type::Text, INVALID_TASK_INDEX,
+      str, pos, internName(str, pos),
+      EventQueueElement::ValueType::Text, str + pos + 1, len - pos - 1, 0,
+      deduplicate);
   }
 }
 
 void EventQueueStruct::add(const __FlashStringHelper *event, bool deduplicate)
 {
-  String str;
-  move_special(str, String(event));
-  add(str, deduplicate);
+  add(String(event), deduplicate);
 }
 
 void EventQueueStruct::addMove(String&& event, bool deduplicate)
 {
   if (!event.length()) { return; }
 
-  if (!deduplicate || !isDuplicate(event)) {
-    #ifdef USE_SECOND_HEAP
-    String tmp;
-    move_special(tmp, std::move(event));
-
-    // Do not add to the list while on 2nd heap
-    HeapSelectDram ephemeral;
-    _eventQueue.emplace_back(std::move(tmp));
-    #else
-    _eventQueue.emplace_back(std::move(event));
-    #endif // ifdef USE_SECOND_HEAP
-  }
+  // Event is copied into the text arena, the string itself is not kept.
+  add(event, deduplicate);
 }
 
 void EventQueueStruct::add(taskIndex_t TaskIndex, const String& varName, const String& eventValue)
 {
   if (Settings.UseRules) {
-    if (eventValue.isEmpty()) {
-      addMove(strformat(
-        F("%s#%s"), 
-        getTaskDeviceName(TaskIndex).c_str(), 
-        varName.c_str()));
-    } else {
-      addMove(strformat(
-        F("%s#%s=%s"), 
-        getTaskDeviceName(TaskIndex).c_str(), 
-        varName.c_str(), 
-        eventValue.c_str()));
-    }
+    addElement(
+      EventQueueElement::Type::Task, TaskIndex,
+      varName.c_str(), varName.length(), internName(varName.c_str(), varName.length()),
+      eventValue.isEmpty() ? EventQueueElement::ValueType::None : EventQueueElement::ValueType::Text,
+      eventValue.c_str(), eventValue.length(), 0,
+      false);
   }
 }
 
 void EventQueueStruct::add(taskIndex_t TaskIndex, const String& varName, int eventValue)
 {
   if (Settings.UseRules) {
-    add(TaskIndex, varName, String(eventValue));
+    addElement(
+      EventQueueElement::Type::Task, TaskIndex,
+      varName.c_str(), varName.length(), internName(varName.c_str(), varName.length()),
+      EventQueueElement::ValueType::Int, nullptr, 0, eventValue,
+      false);
   }
 }
 
@@ -86,30 +81,345 @@ void EventQueueStruct::add(taskIndex_t TaskIndex, const __FlashStringHelper *var
 void EventQueueStruct::add(taskIndex_t TaskIndex, const __FlashStringHelper *varName, int eventValue)
 {
   if (Settings.UseRules) {
-    add(TaskIndex, String(varName), String(eventValue));
+    add(TaskIndex, String(varName), eventValue);
+  }
+}
+
+void EventQueueStruct::addTaskValueEvent(taskIndex_t TaskIndex, uint8_t varNr, const String& eventValue)
+{
+  if (Settings.UseRules) {
+    addElement(
+      EventQueueElement::Type::TaskValue, TaskIndex,
+      nullptr, 0, varNr,
+      EventQueueElement::ValueType::Text, eventValue.c_str(), eventValue.length(), 0,
+      false);
   }
 }
 
 bool EventQueueStruct::getNext(String& event)
 {
-  if (_eventQueue.empty()) {
-    return false;
+  if (_count == 0) {
+    if (_overflow.empty()) {
+      return false;
+    }
+
+    // Events in the overflow list are always newer than the ones in the ring buffer.
+    event = std::move(_overflow.front());
+    _overflow.pop_front();
+    return true;
   }
-  event = std::move(_eventQueue.front());
-  _eventQueue.pop_front();
+  const EventQueueElement& element = _elements[_head];
+  const char *text                 = _text.data() + element.textOffset;
+
+  event = String();
+  appendEvent(element, text, element.nameLength, text + element.nameLength, element.valueLength, event);
+  popFront();
   return true;
 }
 
 void EventQueueStruct::clear()
 {
-  _eventQueue.clear();
+  if (isEmpty()) {
+    return;
+  }
+
+  // Keep the allocated queue and text arena, their size is fixed.
+  // The interned names are also kept, as they will likely be used again.
+  for (size_t i = 0; i < EVENTQUEUE_HASH_BUCKETS; ++i) {
+    _hashBuckets[i] = 0;
+  }
+  _overflow.clear();
+  _head     = 0;
+  _count    = 0;
+  _textHead = 0;
+  _textTail = 0;
+  _textUsed = 0;
 }
 
 bool EventQueueStruct::isEmpty() const
 {
-  return _eventQueue.empty();
+  return _count == 0 && _overflow.empty();
+}
+
+bool EventQueueStruct::addElement(
+  EventQueueElement::Type      type,
+  taskIndex_t                  TaskIndex,
+  const char                  *name,
+  size_t                       nameLength,
+  uint8_t                      nameId,
+  EventQueueElement::ValueType valueType,
+  const char                  *value,
+  size_t                       valueLength,
+  int32_t                      intValue,
+  bool                         deduplicate)
+{
+  EventQueueElement element;
+
+  element.type      = type;
+  element.taskIndex = TaskIndex;
+  element.nameId    = nameId;
+  element.valueType = valueType;
+  element.intValue  = intValue;
+
+  if ((nameLength + valueLength) > EVENTQUEUE_TEXT_SIZE) {
+    // Does not fit in the text arena, so it cannot be a duplicate of an element in the ring buffer.
+    return addOverflow(element, name, nameLength, value, valueLength, deduplicate);
+  }
+
+  if ((type != EventQueueElement::Type::TaskValue) && (nameId >= EVENTQUEUE_MAX_INTERNED_NAMES)) {
+    // Not interned, keep the name in the text arena.
+    element.nameLength = nameLength;
+  } else {
+    name = nullptr;
+  }
+
+  if (valueType == EventQueueElement::ValueType::Text) {
+    element.valueLength = valueLength;
+  }
+
+  // Hash over all members which make the event unique.
+  uint8_t header[4] = { static_cast<uint8_t>(type), TaskIndex, nameId, static_cast<uint8_t>(valueType) };
+
+  element.hash = calc_FNV1a_32(header, sizeof(header));
+  element.hash = calc_FNV1a_32(reinterpret_cast<const uint8_t *>(&element.intValue), sizeof(element.intValue), element.hash);
+  element.hash = calc_FNV1a_32(reinterpret_cast<const uint8_t *>(name), element.nameLength, element.hash);
+  element.hash = calc_FNV1a_32(reinterpret_cast<const uint8_t *>(value), element.valueLength, element.hash);
+
+  if (deduplicate && isDuplicate(element, name, value)) {
+    return false;
+  }
+
+  if (!_overflow.empty() ||
+      !allocate(element.nameLength + element.valueLength, element.textOffset)) {
+    // Queue is full, or keep the order of the events when the overflow list is in use.
+    return addOverflow(element, name, nameLength, value, valueLength, deduplicate);
+  }
+
+  if (element.nameLength != 0) {
+    memcpy(_text.data() + element.textOffset, name, element.nameLength);
+  }
+
+  if (element.valueLength != 0) {
+    memcpy(_text.data() + element.textOffset + element.nameLength, value, element.valueLength);
+  }
+
+  const size_t slot    = (_head + _count) % _elements.size();
+  uint16_t   & bucket  = _hashBuckets[element.hash % EVENTQUEUE_HASH_BUCKETS];
+
+  element.nextInBucket = bucket;
+  bucket               = slot + 1;
+  _elements[slot]      = element;
+  ++_count;
+  return true;
+}
+
+bool EventQueueStruct::addOverflow(const EventQueueElement& element,
+                                   const char              *name,
+                                   size_t                   nameLength,
+                                   const char              *value,
+                                   size_t                   valueLength,
+                                   bool                     deduplicate)
+{
+  String event;
+
+  appendEvent(element, name, nameLength, value, valueLength, event);
+
+  if (deduplicate) {
+    for (auto it = _overflow.begin(); it != _overflow.end(); ++it) {
+      if (it->equals(event)) {
+        return false;
+      }
+    }
+  }
+  #ifdef USE_SECOND_HEAP
+  String tmp;
+  move_special(tmp, std::move(event));
+
+  // Do not add to the list while on 2nd heap
+  HeapSelectDram ephemeral;
+  _overflow.emplace_back(std::move(tmp));
+  #else // ifdef USE_SECOND_HEAP
+  _overflow.emplace_back(std::move(event));
+  #endif // ifdef USE_SECOND_HEAP
+  return true;
 }
 
-bool EventQueueStruct::isDuplicate(const String& event) {
-  return std::find(_eventQueue.begin(), _eventQueue.end(), event) != _eventQueue.end();
+void EventQueueStruct::appendEvent(const EventQueueElement& element,
+                                   const char              *name,
+                                   size_t                   nameLength,
+                                   const char              *value,
+                                   size_t                   valueLength,
+                                   String                 & event) const
+{
+  if (element.type == EventQueueElement::Type::Text) {
+    if (element.nameId < _internedNames.size()) {
+      event.reserve(_internedNames[element.nameId].length() + valueLength + 12);
+      event += _internedNames[element.nameId];
+    } else {
+      event.reserve(nameLength + valueLength + 12);
+      event.concat(name, nameLength);
+    }
+  } else {
+    // Only look up the task name now, so it is not allocated while the event is in the queue.
+    event += getTaskDeviceName(element.taskIndex);
+    event += '#';
+
+    if (element.type == EventQueueElement::Type::TaskValue) {
+      event += getTaskValueName(element.taskIndex, element.nameId);
+    } else if (element.nameId < _internedNames.size()) {
+      event += _internedNames[element.nameId];
+    } else {
+      event.concat(name, nameLength);
+    }
+  }
+
+  if (element.valueType == EventQueueElement::ValueType::Text) {
+    event += '=';
+    event.concat(value, valueLength);
+  } else if (element.valueType == EventQueueElement::ValueType::Int) {
+    event += '=';
+    event += element.intValue;
+  }
+}
+
+uint8_t EventQueueStruct::internName(const char *name, size_t length)
+{
+  if (length > EVENTQUEUE_MAX_INTERNED_NAME_LENGTH) {
+    return EVENTQUEUE_MAX_INTERNED_NAMES;
+  }
+  const uint32_t hash = calc_FNV1a_32(reinterpret_cast<const uint8_t *>(name), length);
+
+  for (size_t i = 0; i < _internedNameHashes.size(); ++i) {
+    if ((_internedNameHashes[i] == hash) &&
+        (_internedNames[i].length() == length) &&
+        (memcmp(_internedNames[i].c_str(), name, length) == 0)) {
+      return i;
+    }
+  }
+
+  if (_internedNames.size() >= EVENTQUEUE_MAX_INTERNED_NAMES) {
+    if (_count != 0) {
+      return EVENTQUEUE_MAX_INTERNED_NAMES;
+    }
+
+    // No queued element refers to the interned names, so start over.
+    // This prevents the table from being filled with names which are no longer used.
+    _internedNames.clear();
+    _internedNameHashes.clear();
+  }
+  String str;
+
+  if (!str.reserve(length)) {
+    return EVENTQUEUE_MAX_INTERNED_NAMES;
+  }
+  str.concat(name, length);
+
+  #ifdef USE_SECOND_HEAP
+  HeapSelectDram ephemeral;
+  #endif // ifdef USE_SECOND_HEAP
+
+  _internedNames.emplace_back(std::move(str));
+  _internedNameHashes.push_back(hash);
+  return _internedNames.size() - 1;
+}
+
+bool EventQueueStruct::isDuplicate(const EventQueueElement& element, const char *name, const char *value) const
+{
+  // Only the elements in the same hash bucket need to be checked.
+  uint16_t next = _hashBuckets[element.hash % EVENTQUEUE_HASH_BUCKETS];
+
+  while (next != 0) {
+    const EventQueueElement& queued = _elements[next - 1];
+
+    next = queued.nextInBucket;
+
+    if ((queued.hash == element.hash) &&
+        (queued.type == element.type) &&
+        (queued.taskIndex == element.taskIndex) &&
+        (queued.nameId == element.nameId) &&
+        (queued.valueType == element.valueType) &&
+        (queued.intValue == element.intValue) &&
+        (queued.nameLength == element.nameLength) &&
+        (queued.valueLength == element.valueLength)) {
+      const char *text = _text.data() + queued.textOffset;
+
+      if ((memcmp(text, name, element.nameLength) == 0) &&
+          (memcmp(text + element.nameLength, value, element.valueLength) == 0)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool EventQueueStruct::allocate(uint16_t textLength, uint16_t& textOffset)
+{
+  if (_elements.empty()) {
+    // Allocate once, with a fixed size, so a burst of events does not cause reallocations.
+    #ifdef USE_SECOND_HEAP
+
+    // Do not allocate the queue on the 2nd heap
+    HeapSelectDram ephemeral;
+    #endif // ifdef USE_SECOND_HEAP
+
+    _elements.resize(EVENTQUEUE_MAX_NR_ELEMENTS);
+    _text.resize(EVENTQUEUE_TEXT_SIZE);
+  }
+
+  return (_count < _elements.size()) && allocateText(textLength, textOffset);
+}
+
+bool EventQueueStruct::allocateText(uint16_t textLength, uint16_t& textOffset)
+{
+  textOffset = 0;
+
+  if (textLength == 0) {
+    return true;
+  }
+
+  if (_textTail >= _textHead) {
+    if ((_textTail + textLength) <= _text.size()) {
+      textOffset = _textTail;
+    } else if (textLength < _textHead) {
+      // Wrap around, the remaining space at the end is skipped.
+      textOffset = 0;
+    } else {
+      return false;
+    }
+  } else {
+    // Must not end up at _textHead, as that would mark the arena empty.
+    if ((_textTail + textLength) >= _textHead) {
+      return false;
+    }
+    textOffset = _textTail;
+  }
+  _textTail  = textOffset + textLength;
+  _textUsed += textLength;
+  return true;
+}
+
+void EventQueueStruct::popFront()
+{
+  const EventQueueElement& element = _elements[_head];
+  const size_t length              = element.nameLength + element.valueLength;
+
+  // Unlink from its hash bucket, the oldest element is at the end of the chain.
+  uint16_t *link = &_hashBuckets[element.hash % EVENTQUEUE_HASH_BUCKETS];
+
+  while (*link != (_head + 1)) {
+    link = &_elements[*link - 1].nextInBucket;
+  }
+  *link = element.nextInBucket;
+
+  if (length != 0) {
+    _textHead  = element.textOffset + length;
+    _textUsed -= length;
+
+    if (_textUsed == 0) {
+      _textHead = 0;
+      _textTail = 0;
+    }
+  }
+  _head = (_head + 1) % _elements.size();
+  --_count;
 }
@@ -3,11 +3,83 @@
 
 
 #include <list>
+#include <vector>
 
 
 #include "../Globals/Plugins.h"
 
 
+// Max. number of queued events, must be a power of 2.
+// The queue and text arena are allocated once, when the first event is queued.
+// Events which do not fit are kept as String in an overflow list on the heap.
+#ifndef EVENTQUEUE_MAX_NR_ELEMENTS
+  # ifdef ESP32
+    #  define EVENTQUEUE_MAX_NR_ELEMENTS      128
+  # else
+    #  define EVENTQUEUE_MAX_NR_ELEMENTS      32
+  # endif // ifdef ESP32
+#endif // ifndef EVENTQUEUE_MAX_NR_ELEMENTS
+
+// Size of the arena holding the (non interned) text parts of the queued events.
+#ifndef EVENTQUEUE_TEXT_SIZE
+  # ifdef ESP32
+    #  define EVENTQUEUE_TEXT_SIZE            2048
+  # else
+    #  define EVENTQUEUE_TEXT_SIZE            512
+  # endif // ifdef ESP32
+#endif // ifndef EVENTQUEUE_TEXT_SIZE
+
+// Max. number of event names (e.g. "WiFi#Connected" or task value names) kept as interned string.
+#ifndef EVENTQUEUE_MAX_INTERNED_NAMES
+  # ifdef ESP32
+    #  define EVENTQUEUE_MAX_INTERNED_NAMES   64
+  # else
+    #  define EVENTQUEUE_MAX_INTERNED_NAMES   32
+  # endif // ifdef ESP32
+#endif // ifndef EVENTQUEUE_MAX_INTERNED_NAMES
+
+#define EVENTQUEUE_MAX_INTERNED_NAME_LENGTH  64
+#define EVENTQUEUE_HASH_BUCKETS              EVENTQUEUE_MAX_NR_ELEMENTS
+
+
+// Queued event, stored in a ring buffer.
+// The event string is only constructed when the event is taken from the queue:
+//   Text:      <name>[=<value>]
+//   Task:      <taskname>#<name>[=<value>]
+//   TaskValue: <taskname>#<task value name>=<value>
+struct EventQueueElement {
+  enum class Type : uint8_t {
+    Text,
+    Task,
+    TaskValue
+  };
+
+  enum class ValueType : uint8_t {
+    None,
+    Text,
+    Int
+  };
+
+  // Hash over all members describing the event, used for detecting duplicates.
+  uint32_t    hash = 0;
+  int32_t     intValue = 0;
+
+  // Offset in the text arena of the name (when not interned), directly followed by the value text.
+  uint16_t    textOffset  = 0;
+  uint16_t    nameLength  = 0;
+  uint16_t    valueLength = 0;
+
+  // Slot + 1 of the next (older) element in the same hash bucket, 0 = none.
+  uint16_t    nextInBucket = 0;
+
+  // Index in the interned names, or task value index for Type::TaskValue
+  uint8_t     nameId    = 0;
+  taskIndex_t taskIndex = INVALID_TASK_INDEX;
+  Type        type      = Type::Text;
+  ValueType   valueType = ValueType::None;
+};
+
+
 struct EventQueueStruct {
   EventQueueStruct() = default;
 
@@ -26,21 +98,89 @@ struct EventQueueStruct {
   void        add(taskIndex_t TaskIndex, const __FlashStringHelper * varName, const String& eventValue);
   void        add(taskIndex_t TaskIndex, const __FlashStringHelper * varName, int eventValue);
 
+  // Add event formatted as Taskname#ValueName=eventvalue
+  // The task value name is only looked up when the event is processed.
+  void        addTaskValueEvent(taskIndex_t TaskIndex, uint8_t varNr, const String& eventValue);
+
   bool        getNext(String& event);
 
   void        clear();
 
   bool        isEmpty() const;
 
-  std::size_t size() {
-    return _eventQueue.size();
+  std::size_t size() const {
+    return _count + _overflow.size();
   }
 
 private:
 
-  bool isDuplicate(const String& event);
-
-  std::list<String>_eventQueue;
+  // Construct and add the element, return false when it could not be stored.
+  bool addElement(EventQueueElement::Type      type,
+                  taskIndex_t                  TaskIndex,
+                  const char                  *name,
+                  size_t                       nameLength,
+                  uint8_t                      nameId,
+                  EventQueueElement::ValueType valueType,
+                  const char                  *value,
+                  size_t                       valueLength,
+                  int32_t                      intValue,
+                  bool                         deduplicate);
+
+  // Add the event as String to the overflow list.
+  bool addOverflow(const EventQueueElement& element,
+                   const char              *name,
+                   size_t                   nameLength,
+                   const char              *value,
+                   size_t                   valueLength,
+                   bool                     deduplicate);
+
+  // Append the event string described by element to event.
+  void appendEvent(const EventQueueElement& element,
+                   const char              *name,
+                   size_t                   nameLength,
+                   const char              *value,
+                   size_t                   valueLength,
+                   String                 & event) const;
+
+  // Return index of the interned name, or EVENTQUEUE_MAX_INTERNED_NAMES when it could not be interned.
+  uint8_t internName(const char *name,
+                     size_t      length);
+
+  bool    isDuplicate(const EventQueueElement& element,
+                      const char              *name,
+                      const char              *value) const;
+
+  // Reserve a slot in the queue and space in the text arena.
+  bool    allocate(uint16_t  textLength,
+                   uint16_t& textOffset);
+
+  bool    allocateText(uint16_t  textLength,
+                       uint16_t& textOffset);
+
+  void    popFront();
+
+  std::vector<EventQueueElement>_elements;
+  std::vector<char>             _text;
+
+  // Events which did not fit in the ring buffer.
+  // Once used, new events are also added here to keep the order of the events.
+  std::list<String>             _overflow;
+
+  std::vector<String>  _internedNames;
+  std::vector<uint32_t>_internedNameHashes;
+
+  // Per hash bucket the slot + 1 of the newest queued element, 0 = empty.
+  // The elements in a bucket are chained via nextInBucket.
+  uint16_t _hashBuckets[EVENTQUEUE_HASH_BUCKETS]{};
+
+  size_t   _head  = 0;
+  size_t   _count = 0;
+
+  // Text arena is used as ring buffer.
+  // Data is wrapped around when _textTail < _textHead.
+  size_t _textHead = 0;
+  size_t _textTail = 0;
+  size_t _textUsed = 0;
 };
 
 
@@ -8,12 +8,20 @@
 struct EventStructCommandWrapper {
   EventStructCommandWrapper() : id(0) {}
 
-  EventStructCommandWrapper(unsigned long i, EventStruct&& e) : id(i), event(std::move(e)) {}
+  EventStructCommandWrapper(unsigned long i, EventStruct&& e) : id(i), event(std::move(e))
+#if FEATURE_TIMING_STATS
+    , queued(millis())
+#endif
+  {}
 
   unsigned long      id;
   String             cmd;
   String             line;
   EventStruct event;
+#if FEATURE_TIMING_STATS
+  // Moment the event was queued, to compute how long it has been waiting.
+  unsigned long      queued = 0;
+#endif
 };
 
 #endif // DATASTRUCTS_EVENTSTRUCTCOMMANDWRAPPER_H
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "../DataStructs/ExtraTaskSettingsLRU.h"
+
+#include "../Helpers/Hardware_device_info.h"
+#include "../Helpers/Memory.h"
+
+#include <new> // for placement new
+
+
+ExtraTaskSettingsLRU::~ExtraTaskSettingsLRU()
+{
+  for (auto it = _slots.begin(); it != _slots.end(); ++it) {
+    free(it->settings);
+  }
+}
+
+bool ExtraTaskSettingsLRU::get(taskIndex_t TaskIndex, ExtraTaskSettingsStruct& settings, ChecksumType& checksum)
+{
+  for (auto it = _slots.begin(); it != _slots.end(); ++it) {
+    if ((it->TaskIndex == TaskIndex) && (it->settings != nullptr)) {
+      checksum = it->settings->computeChecksum();
+
+      if (!(checksum == it->checksum)) {
+        // Content got corrupted, must load from file again.
+        ++_nrChecksumErrors;
+        ++_nrMisses;
+        it->TaskIndex = INVALID_TASK_INDEX;
+        return false;
+      }
+      memcpy(&settings, it->settings, sizeof(ExtraTaskSettingsStruct));
+      it->lastUsed = ++_useCounter;
+      ++_nrHits;
+      return true;
+    }
+  }
+  ++_nrMisses;
+  return false;
+}
+
+void ExtraTaskSettingsLRU::put(const ExtraTaskSettingsStruct& settings, const ChecksumType& checksum)
+{
+  if (!validTaskIndex(settings.TaskIndex)) { return; }
+
+  if (_slots.empty()) {
+    _slots.resize(getNrSlots());
+  }
+  Slot *slot = nullptr;
+
+  for (auto it = _slots.begin(); it != _slots.end(); ++it) {
+    if (it->TaskIndex == settings.TaskIndex) {
+      slot = &(*it);
+      break;
+    }
+
+    // Prefer an unused slot, else the least recently used one.
+    if ((slot == nullptr) ||
+        ((slot->TaskIndex != INVALID_TASK_INDEX) &&
+         ((it->TaskIndex == INVALID_TASK_INDEX) || (it->lastUsed < slot->lastUsed)))) {
+      slot = &(*it);
+    }
+  }
+
+  if (slot == nullptr) { return; }
+
+  if (slot->settings == nullptr) {
+    void *ptr = special_calloc(1, sizeof(ExtraTaskSettingsStruct));
+
+    if (ptr == nullptr) { return; }
+    slot->settings = new (ptr) ExtraTaskSettingsStruct();
+  }
+  memcpy(slot->settings, &settings, sizeof(ExtraTaskSettingsStruct));
+  slot->checksum  = checksum;
+  slot->TaskIndex = settings.TaskIndex;
+  slot->lastUsed  = ++_useCounter;
+}
+
+void ExtraTaskSettingsLRU::erase(taskIndex_t TaskIndex)
+{
+  for (auto it = _slots.begin(); it != _slots.end(); ++it) {
+    if (it->TaskIndex == TaskIndex) {
+      it->TaskIndex = INVALID_TASK_INDEX;
+    }
+  }
+}
+
+void ExtraTaskSettingsLRU::clear()
+{
+  // Keep the allocated memory, only mark the slots unused.
+  for (auto it = _slots.begin(); it != _slots.end(); ++it) {
+    it->TaskIndex = INVALID_TASK_INDEX;
+  }
+}
+
+size_t ExtraTaskSettingsLRU::getNrSlotsUsed() const
+{
+  size_t res = 0;
+
+  for (auto it = _slots.begin(); it != _slots.end(); ++it) {
+    if (it->TaskIndex != INVALID_TASK_INDEX) {
+      ++res;
+    }
+  }
+  return res;
+}
+
+size_t ExtraTaskSettingsLRU::getNrSlots() const
+{
+  if (!_slots.empty()) {
+    return _slots.size();
+  }
+#ifdef ESP32
+
+  if (UsePSRAM()) {
+    return EXTRA_TASK_SETTINGS_CACHE_SLOTS_PSRAM;
+  }
+#endif // ifdef ESP32
+  return EXTRA_TASK_SETTINGS_CACHE_SLOTS;
+}
@@ -0,0 +1,79 @@
+#ifndef DATASTRUCTS_EXTRATASKSETTINGSLRU_H
+#define DATASTRUCTS_EXTRATASKSETTINGSLRU_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataStructs/ChecksumType.h"
+#include "../DataStructs/ExtraTaskSettingsStruct.h"
+#include "../DataTypes/TaskIndex.h"
+
+#include <vector>
+
+
+/*********************************************************************************************\
+* ExtraTaskSettingsLRU
+* Copies of the ExtraTaskSettings of the most recently loaded tasks,
+* as they were loaded from (or saved to) the file system.
+* Used by LoadTaskSettings() so switching between tasks does not need to read from flash.
+*
+* Each slot keeps the checksum of its content, which is checked before the slot is used.
+* The slots are allocated in PSRAM when available.
+\*********************************************************************************************/
+class ExtraTaskSettingsLRU {
+public:
+
+  ExtraTaskSettingsLRU() = default;
+
+  ExtraTaskSettingsLRU(const ExtraTaskSettingsLRU& other) = delete;
+
+  ~ExtraTaskSettingsLRU();
+
+  // Copy the cached settings of the task into 'settings' and return its checksum in 'checksum'.
+  // Return false when not cached, or when the cached copy no longer matches its checksum.
+  bool     get(taskIndex_t              TaskIndex,
+               ExtraTaskSettingsStruct& settings,
+               ChecksumType           & checksum);
+
+  // Store a copy of the settings, replacing the least recently used slot.
+  void     put(const ExtraTaskSettingsStruct& settings,
+               const ChecksumType           & checksum);
+
+  void     erase(taskIndex_t TaskIndex);
+
+  void     clear();
+
+  uint32_t getNrHits() const {
+    return _nrHits;
+  }
+
+  uint32_t getNrMisses() const {
+    return _nrMisses;
+  }
+
+  uint32_t getNrChecksumErrors() const {
+    return _nrChecksumErrors;
+  }
+
+  size_t   getNrSlotsUsed() const;
+
+  // Max. number of slots, depends on the availability of PSRAM.
+  size_t   getNrSlots() const;
+
+private:
+
+  struct Slot {
+    ExtraTaskSettingsStruct *settings = nullptr;
+    ChecksumType             checksum;
+    uint32_t                 lastUsed  = 0;
+    taskIndex_t              TaskIndex = INVALID_TASK_INDEX;
+  };
+
+  std::vector<Slot>_slots;
+  uint32_t _useCounter       = 0;
+  uint32_t _nrHits           = 0;
+  uint32_t _nrMisses         = 0;
+  uint32_t _nrChecksumErrors = 0;
+};
+
+
+#endif // ifndef DATASTRUCTS_EXTRATASKSETTINGSLRU_H
@@ -3,24 +3,25 @@
 
 #include "../../ESPEasy_common.h"
 
-class LogEntry_t {
-public:
+#ifdef ESP32
+  #define LOG_BUFFER_EXPIRE         30000  // Time after which a buffered log item is considered expired.
+#else
+  #define LOG_BUFFER_EXPIRE         5000  // Time after which a buffered log item is considered expired.
+#endif
 
-  LogEntry_t() = default;
-
-  bool add(const uint8_t loglevel,
-           const String& line);
-  bool add(const uint8_t loglevel,
-           String     && line);
-
-  void clear();
-
-  bool isExpired() const;
 
+// A log line as read from the LogStruct ring buffer by one of the log consumers.
+// The message is a copy, so the entry remains valid while new lines are logged.
+// Reuse the entry to read several lines, so the message only needs to be allocated once.
+struct LogEntry_t {
+  LogEntry_t() = default;
 
-  String _message;
+  String        _message;
   unsigned long _timestamp{};
-  uint8_t _loglevel{};
+  #ifndef LIMIT_BUILD_SIZE
+  uint32_t      _freeMem{}; // Free memory at the moment the line was logged
+  #endif
+  uint8_t       _loglevel{};
 };
 
 
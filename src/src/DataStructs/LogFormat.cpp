@@ -0,0 +1,419 @@
+#include "../DataStructs/LogFormat.h"
+
+#include <limits.h>
+
+
+namespace {
+bool isConversion(char c)
+{
+  switch (c) {
+    case 'd': case 'i': case 'o': case 'u': case 'x': case 'X': case 'c':
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+    case 's': case 'p': case '%':
+      return true;
+  }
+  return false;
+}
+
+bool isLengthModifier(char c)
+{
+  switch (c) {
+    case 'h': case 'l': case 'L': case 'z': case 'j': case 't': case 'q':
+      return true;
+  }
+  return false;
+}
+} // namespace
+
+
+LogFormat_t::LogFormat_t(const __FlashStringHelper *format, size_t capacity)
+  : _data(_buffer), _capacity(sizeof(_buffer))
+{
+  if (capacity > sizeof(_buffer)) {
+    _heapData.resize(capacity);
+
+    if (_heapData.size() == capacity) {
+      _data     = _heapData.data();
+      _capacity = capacity;
+    }
+  }
+  memcpy(_data, &format, sizeof(format));
+  _size         = sizeof(format);
+  _requiredSize = _size;
+}
+
+void LogFormat_t::add(int value)
+{
+  const int32_t v = value;
+
+  add(Arg_e::Int32, &v, sizeof(v));
+}
+
+void LogFormat_t::add(unsigned int value)
+{
+  const uint32_t v = value;
+
+  add(Arg_e::UInt32, &v, sizeof(v));
+}
+
+void LogFormat_t::add(long value)
+{
+  if ((value >= INT32_MIN) && (value <= INT32_MAX)) {
+    add(static_cast<int>(value));
+  } else {
+    add(static_cast<long long>(value));
+  }
+}
+
+void LogFormat_t::add(unsigned long value)
+{
+  if (value <= UINT32_MAX) {
+    add(static_cast<unsigned int>(value));
+  } else {
+    add(static_cast<unsigned long long>(value));
+  }
+}
+
+void LogFormat_t::add(long long value)
+{
+  const int64_t v = value;
+
+  add(Arg_e::Int64, &v, sizeof(v));
+}
+
+void LogFormat_t::add(unsigned long long value)
+{
+  const uint64_t v = value;
+
+  add(Arg_e::UInt64, &v, sizeof(v));
+}
+
+void LogFormat_t::add(double value)
+{
+  add(Arg_e::Double, &value, sizeof(value));
+}
+
+void LogFormat_t::add(const char *value)
+{
+  if (value == nullptr) {
+    addString(nullptr, 0);
+  } else {
+    addString(value, strlen(value));
+  }
+}
+
+void LogFormat_t::add(const String& value)
+{
+  addString(value.c_str(), value.length());
+}
+
+void LogFormat_t::add(const __FlashStringHelper *value)
+{
+  add(Arg_e::FlashString, &value, sizeof(value));
+}
+
+void LogFormat_t::add(Arg_e type, const void *value, size_t size)
+{
+  _requiredSize += 1 + size;
+
+  if (_full || ((_size + 1 + size) > _capacity)) {
+    _full = true;
+    return;
+  }
+  _data[_size++] = static_cast<uint8_t>(type);
+  memcpy(&_data[_size], value, size);
+  _size += size;
+}
+
+void LogFormat_t::addString(const char *value, size_t length)
+{
+  if (length > UINT16_MAX) { length = UINT16_MAX; }
+
+  // Type and length take 3 bytes
+  _requiredSize += 3 + length;
+
+  if (_full || ((_size + 3 + length) > _capacity)) {
+    _full = true;
+    return;
+  }
+  const uint16_t len = length;
+
+  _data[_size++] = static_cast<uint8_t>(Arg_e::String);
+  memcpy(&_data[_size], &len, sizeof(len));
+  _size += sizeof(len);
+
+  if (length != 0) {
+    memcpy(&_data[_size], value, length);
+    _size += length;
+  }
+}
+
+void LogFormat_t::render(const uint8_t *data, size_t size, String& dest)
+{
+  PGM_P format = nullptr;
+
+  if (size >= sizeof(format)) {
+    memcpy(&format, data, sizeof(format));
+  }
+  size_t pos = sizeof(format);
+
+  // Conversion specification, with room to add a length modifier
+  char spec[16];
+
+  // Run of literal characters
+  char   buf[64];
+  size_t length = 0;
+
+  while (format != nullptr) {
+    char c = pgm_read_byte(format++);
+
+    if (c == '\0') { break; }
+
+    if (c != '%') {
+      buf[length++] = c;
+
+      if (length == sizeof(buf)) {
+        dest.concat(buf, length);
+        length = 0;
+      }
+      continue;
+    }
+
+    if (length != 0) {
+      dest.concat(buf, length);
+      length = 0;
+    }
+
+    // Copy the flags, width and precision, leave out the length modifiers and conversion
+    size_t specLength = 0;
+    spec[specLength++] = '%';
+
+    do {
+      c = pgm_read_byte(format++);
+
+      if ((c == '\0') || isConversion(c)) { break; }
+
+      if (!isLengthModifier(c) && (specLength < (sizeof(spec) - 4))) {
+        spec[specLength++] = c;
+      }
+    } while (true);
+
+    if (c == '\0') { break; }
+
+    if (c == '%') {
+      buf[length++] = '%';
+    } else {
+      renderArg(spec, specLength, c, data, size, pos, dest);
+    }
+  }
+
+  if (length != 0) {
+    dest.concat(buf, length);
+  }
+}
+
+void LogFormat_t::renderArg(const char    *spec,
+                            size_t         specLength,
+                            char           conversion,
+                            const uint8_t *data,
+                            size_t         size,
+                            size_t       & pos,
+                            String       & dest)
+{
+  if (pos >= size) {
+    // Missing argument
+    return;
+  }
+  const Arg_e type = static_cast<Arg_e>(data[pos++]);
+  size_t      argSize{};
+
+  switch (type) {
+    case Arg_e::Int32:
+    case Arg_e::UInt32:      argSize = sizeof(uint32_t); break;
+    case Arg_e::Int64:
+    case Arg_e::UInt64:      argSize = sizeof(uint64_t); break;
+    case Arg_e::Double:      argSize = sizeof(double); break;
+    case Arg_e::String:
+    {
+      uint16_t strLength{};
+
+      if ((pos + sizeof(strLength)) <= size) {
+        memcpy(&strLength, &data[pos], sizeof(strLength));
+      }
+      argSize = sizeof(strLength) + strLength;
+      break;
+    }
+    case Arg_e::FlashString: argSize = sizeof(PGM_P); break;
+    default:                 argSize = size; break;
+  }
+
+  if ((pos + argSize) > size) {
+    // Unknown or incomplete data, do not try to render the rest.
+    pos = size;
+    return;
+  }
+  int64_t     iValue{};
+  double      dValue{};
+  const char *strValue  = nullptr;
+  size_t      strLength = 0;
+  PGM_P       flashStr  = nullptr;
+  bool        isString  = false;
+
+  switch (type) {
+    case Arg_e::Int32:
+    {
+      int32_t v{};
+      memcpy(&v, &data[pos], sizeof(v));
+      pos   += sizeof(v);
+      iValue = v;
+      break;
+    }
+    case Arg_e::UInt32:
+    {
+      uint32_t v{};
+      memcpy(&v, &data[pos], sizeof(v));
+      pos   += sizeof(v);
+      iValue = v;
+      break;
+    }
+    case Arg_e::Int64:
+    case Arg_e::UInt64:
+      memcpy(&iValue, &data[pos], sizeof(iValue));
+      pos += sizeof(iValue);
+      break;
+    case Arg_e::Double:
+      memcpy(&dValue, &data[pos], sizeof(dValue));
+      pos   += sizeof(dValue);
+      iValue = dValue;
+      break;
+    case Arg_e::String:
+    {
+      strLength = argSize - sizeof(uint16_t);
+      strValue  = reinterpret_cast<const char *>(&data[pos + sizeof(uint16_t)]);
+      pos      += argSize;
+      isString  = true;
+      break;
+    }
+    case Arg_e::FlashString:
+      memcpy(&flashStr, &data[pos], sizeof(flashStr));
+      pos     += sizeof(flashStr);
+      isString = true;
+      break;
+    default:
+      return;
+  }
+
+  if (type != Arg_e::Double) {
+    dValue = iValue;
+  }
+
+  if ((conversion == 's') && isString && (specLength == 1)) {
+    // Plain "%s", append the string as a whole, no matter how long.
+    if (strValue != nullptr) {
+      dest.concat(strValue, strLength);
+    } else if (flashStr != nullptr) {
+      dest += FPSTR(flashStr);
+    }
+    return;
+  }
+
+  // Rendered argument, large enough for a string argument with some padding.
+  char buf[LOG_FORMAT_DATA_SIZE + 32];
+  char str[LOG_FORMAT_DATA_SIZE];
+
+  str[0] = '\0';
+
+  if (strValue != nullptr) {
+    if (strLength >= sizeof(str)) { strLength = sizeof(str) - 1; }
+    memcpy(str, strValue, strLength);
+    str[strLength] = '\0';
+  } else if (flashStr != nullptr) {
+    strncpy_P(str, flashStr, sizeof(str) - 1);
+    str[sizeof(str) - 1] = '\0';
+  }
+
+  // Pass the argument with the type matching the conversion.
+  char fmt[16];
+
+  memcpy(fmt, spec, specLength);
+  int res = 0;
+
+  switch (conversion) {
+    case 's':
+
+      if (!isString) {
+        if (type == Arg_e::Double) {
+          snprintf(str, sizeof(str), "%g", dValue);
+        } else {
+          snprintf(str, sizeof(str), "%ld", static_cast<long>(iValue));
+        }
+      }
+      fmt[specLength]     = 's';
+      fmt[specLength + 1] = '\0';
+      res                 = snprintf(buf, sizeof(buf), fmt, str);
+      break;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+      fmt[specLength]     = conversion;
+      fmt[specLength + 1] = '\0';
+      res                 = snprintf(buf, sizeof(buf), fmt, dValue);
+      break;
+    case 'c':
+      fmt[specLength]     = 'c';
+      fmt[specLength + 1] = '\0';
+      res                 = snprintf(buf, sizeof(buf), fmt, static_cast<int>(iValue));
+      break;
+    case 'p':
+      fmt[specLength]     = 'p';
+      fmt[specLength + 1] = '\0';
+      res                 = snprintf(buf, sizeof(buf), fmt, reinterpret_cast<void *>(static_cast<uintptr_t>(iValue)));
+      break;
+    default:
+    {
+      // Integer conversions
+      const bool isSigned = (conversion == 'd') || (conversion == 'i');
+
+      if ((type == Arg_e::Int32) && !isSigned) {
+        // Keep the 32-bit representation of negative values, e.g. for %x
+        iValue = static_cast<uint32_t>(iValue);
+      }
+
+      const bool fitsLong = isSigned
+                            ? ((iValue >= LONG_MIN) && (iValue <= LONG_MAX))
+                            : ((iValue >= 0) && (static_cast<uint64_t>(iValue) <= ULONG_MAX));
+
+      if (fitsLong) {
+        fmt[specLength]     = 'l';
+        fmt[specLength + 1] = conversion;
+        fmt[specLength + 2] = '\0';
+
+        if (isSigned) {
+          res = snprintf(buf, sizeof(buf), fmt, static_cast<long>(iValue));
+        } else {
+          res = snprintf(buf, sizeof(buf), fmt, static_cast<unsigned long>(iValue));
+        }
+      } else {
+        fmt[specLength]     = 'l';
+        fmt[specLength + 1] = 'l';
+        fmt[specLength + 2] = conversion;
+        fmt[specLength + 3] = '\0';
+
+        if (isSigned) {
+          res = snprintf(buf, sizeof(buf), fmt, static_cast<long long>(iValue));
+        } else {
+          res = snprintf(buf, sizeof(buf), fmt, static_cast<unsigned long long>(iValue));
+        }
+      }
+      break;
+    }
+  }
+
+  if (res <= 0) {
+    return;
+  }
+
+  if (static_cast<size_t>(res) >= sizeof(buf)) {
+    // Truncated
+    res = sizeof(buf) - 1;
+  }
+  dest.concat(buf, res);
+}
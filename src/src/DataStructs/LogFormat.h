@@ -0,0 +1,112 @@
+#ifndef DATASTRUCTS_LOGFORMAT_H
+#define DATASTRUCTS_LOGFORMAT_H
+
+// Included from ESPEasy_Log.h, which is included from ESPEasy_common.h
+#include <Arduino.h>
+
+#include <vector>
+
+/*********************************************************************************************\
+* LogFormat_t
+* A log line kept as the pointer to its printf-style format string in flash,
+* followed by the binary arguments.
+* It is only rendered to text when read from the log buffer, so logging costs little
+* more than copying the arguments when nobody reads the log at the moment.
+*
+* Supported arguments: integer types, float/double, const char*, String and flash strings.
+* When an argument does not fit, isTruncated() is set and requiredSize() tells the capacity
+* needed to keep all arguments.
+* Format specifiers with '*' as width or precision are not supported.
+\*********************************************************************************************/
+#ifndef LOG_FORMAT_MAX_ARGS
+  # define LOG_FORMAT_MAX_ARGS   8
+#endif
+
+// Max. size of the format pointer and arguments
+#ifndef LOG_FORMAT_DATA_SIZE
+  # define LOG_FORMAT_DATA_SIZE  128
+#endif
+
+
+class LogFormat_t {
+public:
+
+  // A capacity larger than LOG_FORMAT_DATA_SIZE is allocated on the heap.
+  explicit LogFormat_t(const __FlashStringHelper *format,
+                       size_t                     capacity = LOG_FORMAT_DATA_SIZE);
+
+  LogFormat_t(const LogFormat_t&)            = delete;
+  LogFormat_t& operator=(const LogFormat_t&) = delete;
+
+  void add(int value);
+  void add(unsigned int value);
+  void add(long value);
+  void add(unsigned long value);
+  void add(long long value);
+  void add(unsigned long long value);
+  void add(double value);
+  void add(const char *value);
+  void add(const String& value);
+  void add(const __FlashStringHelper *value);
+
+  const uint8_t* data() const {
+    return _data;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+  // An argument did not fit, the data is incomplete.
+  bool isTruncated() const {
+    return _full;
+  }
+
+  // Size needed to store the format and all arguments added so far.
+  size_t requiredSize() const {
+    return _requiredSize;
+  }
+
+  // Render the data as created by a LogFormat_t object and append it to dest.
+  static void render(const uint8_t *data,
+                     size_t         size,
+                     String       & dest);
+
+private:
+
+  enum class Arg_e : uint8_t {
+    Int32,
+    UInt32,
+    Int64,
+    UInt64,
+    Double,
+    String,
+    FlashString
+  };
+
+  void   add(Arg_e       type,
+             const void *value,
+             size_t      size);
+
+  void   addString(const char *value,
+                   size_t      length);
+
+  // Render one argument and append it to dest.
+  static void renderArg(const char    *spec,
+                        size_t         specLength,
+                        char           conversion,
+                        const uint8_t *data,
+                        size_t         size,
+                        size_t       & pos,
+                        String       & dest);
+
+  uint8_t              _buffer[LOG_FORMAT_DATA_SIZE];
+  std::vector<uint8_t> _heapData; // Only used when the capacity exceeds _buffer
+  uint8_t             *_data;
+  size_t               _capacity;
+  size_t               _size         = 0;
+  size_t               _requiredSize = 0;
+  bool                 _full         = false; // Set when an argument did not fit, to ignore the next arguments
+};
+
+#endif // ifndef DATASTRUCTS_LOGFORMAT_H
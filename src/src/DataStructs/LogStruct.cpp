@@ -1,71 +1,191 @@
 #include "../DataStructs/LogStruct.h"
 
 #include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/Memory.h"
 #include "../Helpers/StringConverter.h"
 
-void LogStruct::add_end() {
-  if (isFull()) {
-    read_idx = nextIndex(read_idx);
+static_assert(LOG_STRUCT_MAX_RECORD_SIZE <= LOG_STRUCT_BUFFER_SIZE / 2, "LOG_STRUCT_MAX_RECORD_SIZE too large");
+static_assert(LOG_STRUCT_MAX_RECORD_SIZE <= 0xFFFF,                     "LOG_STRUCT_MAX_RECORD_SIZE too large");
+static_assert(LOG_FORMAT_DATA_SIZE <= LOG_STRUCT_MAX_RECORD_SIZE,       "LOG_FORMAT_DATA_SIZE too large");
+
+LogStruct::~LogStruct() {
+  if (_buffer != nullptr) {
+    free(_buffer);
+    _buffer = nullptr;
   }
-  write_idx = nextIndex(write_idx);
-  is_full   = (write_idx == read_idx);
 }
 
-void LogStruct::add(const uint8_t loglevel, const String& line) {
-  if (Message[write_idx].add(loglevel, line)) {
-    add_end();
+void LogStruct::add(const uint8_t loglevel, const char *line, size_t length) {
+  if (length > LOG_STRUCT_MAX_RECORD_SIZE) {
+    length = LOG_STRUCT_MAX_RECORD_SIZE;
   }
+  addRecord(loglevel, RecordType_e::Text, line, length);
+}
+
+void LogStruct::add(const uint8_t loglevel, const String& line) {
+  add(loglevel, line.c_str(), line.length());
 }
 
-void LogStruct::add(const uint8_t loglevel, String&& line) {
-  if (Message[write_idx].add(loglevel, std::move(line))) {
-    add_end();
+void LogStruct::add(const uint8_t loglevel, const __FlashStringHelper *line) {
+  if ((line == nullptr) || (pgm_read_byte(reinterpret_cast<PGM_P>(line)) == 0)) {
+    return;
   }
+  addRecord(loglevel, RecordType_e::FlashString, &line, sizeof(line));
 }
 
-bool LogStruct::getNext(bool& logLinesAvailable, unsigned long& timestamp, String& message, uint8_t& loglevel) {
-  lastReadTimeStamp = millis();
-  logLinesAvailable = false;
+void LogStruct::add(const uint8_t loglevel, const LogFormat_t& logFormat) {
+  addRecord(loglevel, RecordType_e::Format, logFormat.data(), logFormat.size());
+}
 
-  if (isEmpty()) {
+bool LogStruct::getNext(LogConsumer_e consumer, uint8_t maxLoglevel, LogEntry_t& entry) {
+  uint32_t& lag = _lag[static_cast<uint8_t>(consumer)];
+
+  if (consumer == LogConsumer_e::WebLog) {
+    lastReadTimeStamp = millis();
+  }
+
+  if ((maxLoglevel == 0) || (_buffer == nullptr)) {
+    // Nothing to read for this consumer
+    lag = 0;
     return false;
   }
-  timestamp = Message[read_idx]._timestamp;
-  message   = std::move(Message[read_idx]._message);
-  loglevel  = Message[read_idx]._loglevel;
-  clearOldest();
 
-  if (!isEmpty()) {
-    logLinesAvailable = true;
+  while (lag != 0) {
+    RecordHeader header;
+    read(lag, &header, sizeof(header));
+    const uint32_t dataLag = lag - sizeof(header);
+    lag = dataLag - header.length;
+
+    if ((header.loglevel > maxLoglevel) ||
+        ((consumer == LogConsumer_e::WebLog) && (timePassedSince(header.timestamp) >= LOG_BUFFER_EXPIRE))) {
+      continue;
+    }
+
+    entry._message.clear();
+
+    switch (header.type) {
+      case RecordType_e::Text:
+        read(dataLag, entry._message, header.length);
+        break;
+      case RecordType_e::FlashString:
+      {
+        const __FlashStringHelper *str = nullptr;
+        read(dataLag, &str, sizeof(str));
+        entry._message = str;
+        break;
+      }
+      case RecordType_e::Format:
+      {
+        uint8_t data[LOG_FORMAT_DATA_SIZE];
+        read(dataLag, data, header.length);
+        LogFormat_t::render(data, header.length, entry._message);
+        break;
+      }
+      default:
+        continue;
+    }
+    entry._timestamp = header.timestamp;
+    entry._loglevel  = header.loglevel;
+    #ifndef LIMIT_BUILD_SIZE
+    entry._freeMem = header.freeMem;
+    #endif
+    return true;
   }
-  return true;
+  return false;
 }
 
-
 bool LogStruct::logActiveRead() {
-  clearExpiredEntries();
   return timePassedSince(lastReadTimeStamp) < LOG_BUFFER_ACTIVE_READ_TIMEOUT;
 }
 
-void LogStruct::clearExpiredEntries() {
-  unsigned int maxLoops = LOG_STRUCT_MESSAGE_LINES;
+bool LogStruct::allocate() {
+  if (_buffer == nullptr) {
+    #ifdef USE_SECOND_HEAP
+
+    // Allow to store the logs in 2nd heap if present.
+    HeapSelectIram ephemeral;
+    #endif // ifdef USE_SECOND_HEAP
+    _buffer = static_cast<uint8_t *>(special_calloc(1, LOG_STRUCT_BUFFER_SIZE));
+  }
+  return _buffer != nullptr;
+}
+
+void LogStruct::addRecord(uint8_t loglevel, RecordType_e type, const void *data, size_t length) {
+  if ((length == 0) || !allocate()) {
+    return;
+  }
+  RecordHeader header;
+
+  header.timestamp = millis();
+  #ifndef LIMIT_BUILD_SIZE
+  header.freeMem = FreeMem();
+  #endif
+  header.length   = length;
+  header.loglevel = loglevel;
+  header.type     = type;
 
-  while (maxLoops > 0) {
-    --maxLoops;
+  const uint32_t recordSize = sizeof(header) + length;
 
-    if (isEmpty() || // Nothing left
-        !Message[read_idx].isExpired())
-    {
-      return;
+  while ((_used + recordSize) > LOG_STRUCT_BUFFER_SIZE) {
+    removeOldest();
+  }
+  write(&header, sizeof(header));
+  write(data,    length);
+
+  _used += recordSize;
+
+  for (uint8_t i = 0; i < static_cast<uint8_t>(LogConsumer_e::NrElements); ++i) {
+    _lag[i] += recordSize;
+  }
+}
+
+void LogStruct::removeOldest() {
+  if (_used == 0) { return; }
+  RecordHeader header;
+
+  read(_used, &header, sizeof(header));
+  _used -= sizeof(header) + header.length;
+
+  for (uint8_t i = 0; i < static_cast<uint8_t>(LogConsumer_e::NrElements); ++i) {
+    if (_lag[i] > _used) {
+      _lag[i] = _used;
     }
-    clearOldest();
   }
 }
 
-void LogStruct::clearOldest() {
-  if (!isEmpty()) {
-    is_full = false;
-    Message[read_idx].clear();
-    read_idx = nextIndex(read_idx);
+void LogStruct::write(const void *data, size_t size) {
+  const uint8_t *src   = static_cast<const uint8_t *>(data);
+  const size_t   first = std::min<size_t>(size, LOG_STRUCT_BUFFER_SIZE - _head);
+
+  memcpy(_buffer + _head, src, first);
+
+  if (first < size) {
+    // Wrap around the end of the buffer
+    memcpy(_buffer, src + first, size - first);
+  }
+  _head = (_head + size) % LOG_STRUCT_BUFFER_SIZE;
+}
+
+void LogStruct::read(uint32_t lag, void *data, size_t size) const {
+  uint8_t     *dest  = static_cast<uint8_t *>(data);
+  const size_t pos   = (_head + LOG_STRUCT_BUFFER_SIZE - lag) % LOG_STRUCT_BUFFER_SIZE;
+  const size_t first = std::min<size_t>(size, LOG_STRUCT_BUFFER_SIZE - pos);
+
+  memcpy(dest, _buffer + pos, first);
+
+  if (first < size) {
+    memcpy(dest + first, _buffer, size - first);
+  }
+}
+
+void LogStruct::read(uint32_t lag, String& str, size_t size) const {
+  const size_t pos   = (_head + LOG_STRUCT_BUFFER_SIZE - lag) % LOG_STRUCT_BUFFER_SIZE;
+  const size_t first = std::min<size_t>(size, LOG_STRUCT_BUFFER_SIZE - pos);
+
+  str.reserve(str.length() + size);
+  str.concat(reinterpret_cast<const char *>(_buffer + pos), first);
+
+  if (first < size) {
+    str.concat(reinterpret_cast<const char *>(_buffer), size - first);
   }
 }
@@ -5,9 +5,18 @@
 #include "../../ESPEasy_common.h"
 
 #include "../DataStructs/LogEntry.h"
+#include "../DataStructs/LogFormat.h"
 
 /*********************************************************************************************\
  * LogStruct
+ * All log lines are stored in a single byte ring buffer, allocated once when the first
+ * line is logged. Each record consists of a small header (timestamp, log level, length)
+ * followed by the message. Log lines from flash strings only store the pointer.
+ * When the buffer is full, the oldest records are dropped.
+ *
+ * Each log consumer (serial, syslog, web log) reads via its own cursor,
+ * so a line is stored only once, regardless the number of consumers.
+ * A consumer which is not reading fast enough will miss the dropped lines.
 \*********************************************************************************************/
 #ifdef ESP32
   #define LOG_STRUCT_MESSAGE_LINES 60
@@ -23,6 +32,17 @@
   #endif
 #endif
 
+// Typical log line length, including the record header.
+#ifndef LOG_STRUCT_BUFFER_SIZE
+  #define LOG_STRUCT_BUFFER_SIZE (LOG_STRUCT_MESSAGE_LINES * 96)
+#endif
+
+// Max. size of a single record, longer lines are truncated.
+// Lines are stored with their full length, so serial and syslog get the complete line.
+#ifndef LOG_STRUCT_MAX_RECORD_SIZE
+  #define LOG_STRUCT_MAX_RECORD_SIZE (LOG_STRUCT_BUFFER_SIZE / 2)
+#endif
+
 #ifdef ESP32
   #define LOG_BUFFER_ACTIVE_READ_TIMEOUT 30000
 #else
@@ -30,46 +50,82 @@
 #endif
 
 
+enum class LogConsumer_e : uint8_t {
+  Serial,
+  Syslog,
+  WebLog,
+
+  NrElements // Keep as last
+};
+
+
 struct LogStruct {
-    
+
+    ~LogStruct();
+
+    void add(const uint8_t loglevel, const char *line, size_t length);
     void add(const uint8_t loglevel, const String& line);
-    void add(const uint8_t loglevel, String&& line);
 
-    // Read the next item and append it to the given string.
-    // Returns whether new lines are available.
-//    bool get(String& output, const String& lineEnd);
+    // Only the pointer is stored, the string is copied when read.
+    void add(const uint8_t loglevel, const __FlashStringHelper *line);
+
+    // Only the format pointer and the arguments are stored, the line is rendered when read.
+    void add(const uint8_t loglevel, const LogFormat_t& logFormat);
 
+    // Read the next line for the consumer with a log level up to maxLoglevel.
+    // Lines with a higher log level are skipped.
     // Returns whether a line was retrieved.
-    bool getNext(bool& logLinesAvailable, unsigned long& timestamp, String& message, uint8_t& loglevel);
+    bool getNext(LogConsumer_e consumer, uint8_t maxLoglevel, LogEntry_t& entry);
 
-    bool isEmpty() const {
-      return !is_full && (write_idx == read_idx);
+    bool isEmpty(LogConsumer_e consumer) const {
+      return _lag[static_cast<uint8_t>(consumer)] == 0;
     }
 
-    bool isFull() const { return is_full; }
-
     bool logActiveRead();
 
   private:
 
-    void add_end();
+    enum class RecordType_e : uint8_t {
+      Text,
+      FlashString,
+      Format
+    };
 
-    void clearExpiredEntries();
+    struct RecordHeader {
+      uint32_t timestamp;
+      #ifndef LIMIT_BUILD_SIZE
+      uint32_t freeMem;
+      #endif
+      uint16_t length;   // Length of the data following the header
+      uint8_t  loglevel;
+      RecordType_e type;
+    };
 
-    void clearOldest();
+    bool allocate();
 
-    static int nextIndex(int idx) {
-//      return ((++idx) == LOG_STRUCT_MESSAGE_LINES) ? 0 : idx;
-      return (idx + 1) % LOG_STRUCT_MESSAGE_LINES;
-    }
+    void addRecord(uint8_t loglevel, RecordType_e type, const void *data, size_t length);
+
+    // Remove the oldest record, moving the cursors pointing to it to the next record.
+    void removeOldest();
+
+    // Copy to the buffer at the write position.
+    void write(const void *data, size_t size);
+
+    // Copy from the buffer at the position 'lag' bytes before the write position.
+    void read(uint32_t lag, void *data, size_t size) const;
+
+    // Append from the buffer at the position 'lag' bytes before the write position to str.
+    void read(uint32_t lag, String& str, size_t size) const;
+
+    uint8_t *_buffer = nullptr;
+    uint32_t _head   = 0; // Write position in the buffer
+    uint32_t _used   = 0; // Nr of bytes in use by records, the oldest record starts '_used' bytes before _head
 
-    LogEntry_t Message[LOG_STRUCT_MESSAGE_LINES];
-    int write_idx = 0;
-    int read_idx = 0;
+    // Per consumer the nr of bytes between its read position and _head
+    uint32_t _lag[static_cast<uint8_t>(LogConsumer_e::NrElements)]{};
     unsigned long lastReadTimeStamp = 0;
-    bool is_full = false;
 };
 
 
 
-#endif // DATASTRUCTS_LOGSTRUCT_H
\ No newline at end of file
+#endif // DATASTRUCTS_LOGSTRUCT_H
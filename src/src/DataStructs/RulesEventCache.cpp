@@ -21,9 +21,68 @@ RulesEventCache_element::RulesEventCache_element(
 }
 
 
+// Compute a case insensitive hash (FNV-1a) of the event name prefix,
+// which is the part up to the first '#', '=', '<', '>' or '!'.
+// Events and rules use the same function, so an event can only match
+// rules with the same prefix hash.
+// Return false when the prefix cannot be used for indexing.
+bool getEventNamePrefixHash(const String& str, bool isRule, uint32_t& hash)
+{
+  const int length = str.length();
+  int start        = 0;
+
+  while (start < length && str[start] == ' ') {
+    ++start;
+  }
+
+  if ((start == length) || (str[start] == '!')) {
+    // Literal string events (and rules to match them) are only handled via the generic rules.
+    return false;
+  }
+
+  int end = start;
+
+  for (; end < length; ++end) {
+    const char c = str[end];
+
+    if ((c == '#') || (c == '=') || (c == '<') || (c == '>') || (c == '!')) {
+      break;
+    }
+
+    if (isRule && (c == '*')) {
+      // Wildcard within the prefix
+      return false;
+    }
+  }
+
+  if (isRule) {
+    if (str.indexOf('[') != -1 ||
+        str.indexOf('%') != -1 ||
+        str.indexOf('{') != -1) {
+      // Rule will be processed by parseTemplate before matching
+      return false;
+    }
+  }
+
+  // Strip trailing spaces, as ruleMatch() trims the event and the rule
+  while (end > start && str[end - 1] == ' ') {
+    --end;
+  }
+
+  hash = 2166136261u;
+
+  for (int i = start; i < end; ++i) {
+    hash ^= static_cast<uint8_t>(tolower(str[i]));
+    hash *= 16777619u;
+  }
+  return true;
+}
+
 void RulesEventCache::clear()
 {
   _eventCache.clear();
+  _index.clear();
+  _genericIndex.clear();
   _initialized = false;
 }
 
@@ -42,6 +101,15 @@ bool RulesEventCache::addLine(const String& line, const String& filename, size_t
     HeapSelectDram ephemeral;
     # endif // ifdef USE_SECOND_HEAP
 
+    const uint16_t index = _eventCache.size();
+    uint32_t hash        = 0;
+
+    if (getEventNamePrefixHash(event, true, hash)) {
+      _index[hash].push_back(index);
+    } else {
+      _genericIndex.push_back(index);
+    }
+
     _eventCache.emplace_back(filename, pos, std::move(event), std::move(action));
     return true;
   }
@@ -50,49 +118,47 @@ bool RulesEventCache::addLine(const String& line, const String& filename, size_t
 
 RulesEventCache_vector::const_iterator RulesEventCache::findMatchingRule(const String& event, bool optimize)
 {
-  RulesEventCache_vector::iterator it   = _eventCache.begin();
-//  RulesEventCache_vector::iterator prev = _eventCache.end();
-
   // FIXME TD-er: Disable optimize as it has some side effects.
   // For example, matching a specific event first and then a more generic one is perfectly normal to do.
   // But this optimization will then put the generic one in front as it will be matched more often.
   // Thus it will never match the more specific one anymore.
+  // The index on event name prefix makes such reordering unnecessary.
+
+  const RulesEventCache_index *candidates = nullptr;
+  uint32_t hash                           = 0;
+
+  if (getEventNamePrefixHash(event, false, hash)) {
+    auto it = _index.find(hash);
+
+    if (it != _index.end()) {
+      candidates = &(it->second);
+    }
+  }
 
+  // Merge the candidates and the generic rules to check them in file order.
+  const size_t nrCandidates = candidates == nullptr ? 0 : candidates->size();
+  size_t c                  = 0;
+  size_t g                  = 0;
+
+  while (c < nrCandidates || g < _genericIndex.size()) {
+    uint16_t index;
+
+    if ((g >= _genericIndex.size()) ||
+        ((c < nrCandidates) && ((*candidates)[c] < _genericIndex[g]))) {
+      index = (*candidates)[c];
+      ++c;
+    } else {
+      index = _genericIndex[g];
+      ++g;
+    }
 
-  for (; it != _eventCache.end(); ++it)
-  {
     START_TIMER
-    const bool match = ruleMatch(event, it->_event);
+    const bool match = ruleMatch(event, _eventCache[index]._event);
     STOP_TIMER(RULES_MATCH);
 
     if (match) {
-      /*
-      if (optimize) {
-        it->_nrTimesMatched++;
-
-        if (prev != _eventCache.end()) {
-          // Check to see if we need to place this one more to the front of the vector
-          // to speed up parsing.
-          if (prev->_nrTimesMatched < it->_nrTimesMatched) {
-            std::swap(*prev, *it);
-            return prev;
-          }
-        }
-      }
-      */
-      return it;
-    }
-/*
-    if (optimize) {
-      if (prev == _eventCache.end()) {
-        prev = it;
-      }
-      else if (prev->_nrTimesMatched > it->_nrTimesMatched) {
-        // Found one that's having a lower match rate
-        prev = it;
-      }
+      return _eventCache.begin() + index;
     }
-    */
   }
-  return it;
+  return _eventCache.end();
 }
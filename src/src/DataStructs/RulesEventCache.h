@@ -3,6 +3,7 @@
 
 #include "../../ESPEasy_common.h"
 
+#include <map>
 #include <vector>
 
 struct RulesEventCache_element {
@@ -37,6 +38,9 @@ public:
                const String& filename,
                size_t        pos);
 
+  // Find the first rule (in file order) matching the event.
+  // Only rules with the same event name prefix (the part before '#' or '=')
+  // and generic rules (wildcards, templates, literal '!' events) are checked.
   RulesEventCache_vector::const_iterator findMatchingRule(const String& event, bool optimize);
 
   RulesEventCache_vector::const_iterator end() const {
@@ -45,7 +49,17 @@ public:
 
 private:
 
+  // Indices into _eventCache, in file order
+  typedef std::vector<uint16_t> RulesEventCache_index;
+
   RulesEventCache_vector _eventCache;
+
+  // Rules grouped by hash of their event name prefix
+  std::map<uint32_t, RulesEventCache_index> _index;
+
+  // Rules which may match any event, like "*", "Rules#*" or "[dummy#name]#value"
+  RulesEventCache_index _genericIndex;
+
   bool _initialized = false;
 };
 
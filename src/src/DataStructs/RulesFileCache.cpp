@@ -0,0 +1,102 @@
+#include "../DataStructs/RulesFileCache.h"
+
+#include "../Helpers/ESPEasy_Storage.h"
+
+#include <algorithm>
+
+
+RulesFileCache::~RulesFileCache()
+{
+  closeFile();
+}
+
+const uint8_t * RulesFileCache::getData(const String& filename, size_t pos, size_t& available)
+{
+  available = 0;
+  const uint32_t blockOffset = pos - (pos % RULES_FILE_CACHE_BLOCK_SIZE);
+
+  Block *block = nullptr;
+
+  for (auto it = _blocks.begin(); it != _blocks.end() && block == nullptr; ++it) {
+    if (it->offset == blockOffset) {
+      block = &(*it);
+    }
+  }
+
+  if (block == nullptr) {
+    // Not cached, read from file
+    if (!_file) {
+      if (!fileExists(filename)) {
+        return nullptr;
+      }
+      _file = tryOpenFile(filename, "r");
+
+      if (!_file) {
+        return nullptr;
+      }
+    }
+
+    if (_blocks.size() < RULES_FILE_CACHE_NR_BLOCKS) {
+      _blocks.emplace_back();
+      block = &_blocks.back();
+    } else {
+      // Replace the least recently used block
+      block = &(*std::min_element(
+                  _blocks.begin(), _blocks.end(),
+                  [](const Block& a, const Block& b) {
+          return a.lastUsed < b.lastUsed;
+        }));
+    }
+    block->offset = blockOffset;
+    block->data.resize(RULES_FILE_CACHE_BLOCK_SIZE);
+
+    if (_file.position() != blockOffset) {
+      _file.seek(blockOffset);
+    }
+    const size_t length = _file.read(block->data.data(), RULES_FILE_CACHE_BLOCK_SIZE);
+
+    block->data.resize(length);
+  }
+  block->lastUsed = ++_useCounter;
+
+  const size_t offsetInBlock = pos - blockOffset;
+
+  if (offsetInBlock >= block->data.size()) {
+    // End of file
+    return nullptr;
+  }
+  available = block->data.size() - offsetInBlock;
+  return block->data.data() + offsetInBlock;
+}
+
+void RulesFileCache::closeFile()
+{
+  if (_file) {
+    _file.close();
+  }
+}
+
+void RulesFileCache::addOnLine(size_t pos)
+{
+  if (_onLines.empty() || (_onLines.back() < pos)) {
+    _onLines.push_back(pos);
+  } else {
+    _onLines.insert(std::lower_bound(_onLines.begin(), _onLines.end(), pos), pos);
+  }
+}
+
+bool RulesFileCache::findNextOnLine(size_t& pos) const
+{
+  auto it = std::lower_bound(_onLines.begin(), _onLines.end(), pos);
+
+  if (it == _onLines.end()) {
+    return false;
+  }
+  pos = *it;
+  return true;
+}
+
+bool RulesFileCache::isOnLine(const String& line)
+{
+  return line.length() >= 3 && strncasecmp(line.c_str(), "on ", 3) == 0;
+}
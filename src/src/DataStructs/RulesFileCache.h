@@ -0,0 +1,74 @@
+#ifndef DATASTRUCTS_RULESFILECACHE_H
+#define DATASTRUCTS_RULESFILECACHE_H
+
+#include "../../ESPEasy_common.h"
+
+#include <FS.h>
+#include <vector>
+
+
+// Read-ahead cache of a single rules file.
+// The file is read in blocks of RULES_FILE_CACHE_BLOCK_SIZE bytes,
+// keeping the last recently used RULES_FILE_CACHE_NR_BLOCKS blocks in memory.
+//
+// Also keeps an index of the positions of all "On ... do" lines,
+// so searching for the next rules block does not need to read all lines in between.
+class RulesFileCache {
+public:
+
+  RulesFileCache() = default;
+
+  RulesFileCache(const RulesFileCache& other)            = delete;
+  RulesFileCache& operator=(const RulesFileCache& other) = delete;
+
+  ~RulesFileCache();
+
+  // Return a pointer to the data starting at pos and the nr of bytes available from there.
+  // The pointer is only valid until the next call to getData().
+  // Return nullptr at the end of the file or when the file could not be read.
+  const uint8_t* getData(const String& filename,
+                         size_t        pos,
+                         size_t      & available);
+
+  // Close the file handle, but keep the cached data.
+  void           closeFile();
+
+  // Position at which readLn() needs to start reading to get an "On ... do" line.
+  void           addOnLine(size_t pos);
+
+  void           setLineIndexComplete() {
+    _lineIndexComplete = true;
+  }
+
+  bool lineIndexComplete() const {
+    return _lineIndexComplete;
+  }
+
+  // Set pos to the first indexed "On" line at or after pos.
+  // Return false when there is no next "On" line.
+  bool findNextOnLine(size_t& pos) const;
+
+  // Return true when the line starts with "on "
+  static bool isOnLine(const String& line);
+
+private:
+
+  struct Block {
+    std::vector<uint8_t>data;
+    uint32_t            offset   = 0;
+    uint32_t            lastUsed = 0;
+  };
+
+  fs::File _file;
+
+  std::vector<Block> _blocks;
+
+  // Sorted positions of the "On" lines
+  std::vector<uint32_t> _onLines;
+
+  uint32_t _useCounter = 0;
+
+  bool _lineIndexComplete = false;
+};
+
+#endif // ifndef DATASTRUCTS_RULESFILECACHE_H
@@ -0,0 +1,80 @@
+#include "../DataStructs/RulesLine.h"
+
+#include "../Helpers/StringConverter.h"
+
+
+RulesLine::RulesLine(const String& line) : _line(line)
+{
+  const int length = _line.length();
+  int start        = 0;
+  int end          = length;
+
+  if ((length >= 3) && _line.substring(0, 3).equalsIgnoreCase(F("on "))) {
+    _type = RulesLineType::On;
+
+    String line_lc = _line;
+    line_lc.toLowerCase();
+    const int pos_do = line_lc.indexOf(F(" do"), 3);
+
+    if (pos_do != -1) {
+      // The action of a one-liner, same as getEventFromRulesLine()
+      start = pos_do + 3;
+
+      while (start < end && isspace(_line[start])) { ++start; }
+
+      while (end > start && isspace(_line[end - 1])) { --end; }
+
+      if (line_lc.substring(start, end).endsWith(F("endon"))) {
+        end -= 5;
+      }
+      _isOneLiner = end > start;
+    }
+  } else if (_line.equalsIgnoreCase(F("endon"))) {
+    _type = RulesLineType::EndOn;
+  } else {
+    String line_lc = _line;
+    line_lc.toLowerCase();
+    line_lc.trim();
+
+    if (line_lc.startsWith(F("elseif "))) {
+      _type = RulesLineType::ElseIf;
+    } else if (line_lc.startsWith(F("if "))) {
+      _type = RulesLineType::If;
+    } else if (equals(line_lc, F("else"))) {
+      _type = RulesLineType::Else;
+    } else if (equals(line_lc, F("endif"))) {
+      _type = RulesLineType::EndIf;
+    }
+
+    if ((_type == RulesLineType::If) || (_type == RulesLineType::ElseIf)) {
+      // The condition, leave out the keyword
+      while (start < length && isspace(_line[start])) { ++start; }
+
+      start = _line.indexOf(' ', start);
+
+      while (start < length && isspace(_line[start])) { ++start; }
+    }
+  }
+
+  if ((_type == RulesLineType::On) && !_isOneLiner) {
+    start = 0;
+    end   = 0;
+  }
+
+  if ((start != 0) || (end != length)) {
+    _partIsLine = false;
+
+    if (end > start) {
+      _part = _line.substring(start, end);
+    }
+  }
+
+  _restrict = (_type == RulesLineType::Command) && _line.startsWith(F("%event"));
+
+  const String& part = getPart();
+
+  _hasEventVar = part.indexOf(F("%event")) != -1;
+  _hasTemplate = part.indexOf('[') != -1 ||
+                 part.indexOf('%') != -1 ||
+                 part.indexOf('{') != -1;
+}
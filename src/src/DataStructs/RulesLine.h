@@ -0,0 +1,55 @@
+#ifndef DATASTRUCTS_RULESLINE_H
+#define DATASTRUCTS_RULESLINE_H
+
+#include "../../ESPEasy_common.h"
+
+/*********************************************************************************************\
+* Pre-compiled rules line
+*
+* The type of a rules line (on/endon/if/elseif/else/endif/command) and whether it
+* needs any substitution is determined once when the rules file is read.
+* Processing an event can then walk the lines of a matched block without
+* re-parsing each line and without calling parseTemplate on literal lines.
+\*********************************************************************************************/
+
+enum class RulesLineType : uint8_t {
+  Command,
+  On,
+  EndOn,
+  If,
+  ElseIf,
+  Else,
+  EndIf
+};
+
+struct RulesLine {
+  explicit RulesLine(const String& line);
+
+  // The part of the line to process:
+  // the condition of an "if" or "elseif", the action of a one-liner or the whole command.
+  const String& getPart() const {
+    return _partIsLine ? _line : _part;
+  }
+
+  String        _line;
+
+  // Only set when the part to process is not the whole line
+  String        _part;
+  RulesLineType _type = RulesLineType::Command;
+
+  bool _partIsLine = true;
+
+  // Part contains "%event", thus needs substitute_eventvalue
+  bool _hasEventVar = false;
+
+  // Part contains any of '[', '%' or '{', thus needs parseTemplate
+  bool _hasTemplate = false;
+
+  // "on ... do <action>" on a single line
+  bool _isOneLiner = false;
+
+  // Command starts with "%event", thus must be prefixed with "restrict"
+  bool _restrict = false;
+};
+
+#endif // ifndef DATASTRUCTS_RULESLINE_H
@@ -0,0 +1,23 @@
+#ifndef DATASTRUCTS_SCHEDULERCONTINUATION_H
+#define DATASTRUCTS_SCHEDULERCONTINUATION_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataStructs/ESPEasy_EventStruct.h"
+
+// Function to continue work which was interrupted as it exceeded its time budget.
+// state: Function specific value to keep track of the progress.
+// Return true when all work is done.
+typedef bool (*SchedulerContinuation_fp)(struct EventStruct& event,
+                                         uint32_t          & state);
+
+struct SchedulerContinuation {
+  SchedulerContinuation(SchedulerContinuation_fp f, EventStruct&& e, uint32_t s) : 
+    fp(f), event(std::move(e)), state(s) {}
+
+  SchedulerContinuation_fp fp;
+  EventStruct              event;
+  uint32_t                 state;
+};
+
+#endif // DATASTRUCTS_SCHEDULERCONTINUATION_H
@@ -0,0 +1,89 @@
+#include "../DataStructs/SchedulerTimerStats.h"
+
+#if FEATURE_TIMING_STATS
+
+# include "../DataStructs/Scheduler_ConstIntervalTimerID.h"
+# include "../DataTypes/SchedulerIntervalTimer.h"
+# include "../Globals/Settings.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/StringConverter.h"
+
+std::map<uint16_t, SchedulerTimerStats> schedulerTimerStats;
+
+
+void SchedulerTimerStats::add(long lateness_msec, int64_t exec_usec)
+{
+  if (lateness_msec < 0) {
+    // Handled before its scheduled time, should not happen.
+    lateness_msec = 0;
+  }
+  ++_count;
+  ++_buckets[getBucketIndex(lateness_msec)];
+  _latenessTotal += lateness_msec;
+
+  if (static_cast<uint32_t>(lateness_msec) > _latenessMax) {
+    _latenessMax = lateness_msec;
+  }
+  _execStats.add(exec_usec);
+}
+
+uint32_t SchedulerTimerStats::getBucketCount(uint8_t bucket) const
+{
+  if (bucket >= SCHEDULER_LATENESS_NR_BUCKETS) { return 0; }
+  return _buckets[bucket];
+}
+
+float SchedulerTimerStats::getLatenessAvg() const
+{
+  if (_count == 0) { return 0.0f; }
+  return static_cast<float>(_latenessTotal) / static_cast<float>(_count);
+}
+
+uint8_t SchedulerTimerStats::getBucketIndex(long lateness_msec)
+{
+  if (lateness_msec <= 0) { return 0; }
+
+  // Bucket 1 = 1 msec, bucket 2 = 2..3 msec, bucket 3 = 4..7 msec, etc.
+  const uint8_t bucket = 32 - __builtin_clz(static_cast<uint32_t>(lateness_msec));
+
+  if (bucket >= SCHEDULER_LATENESS_NR_BUCKETS) {
+    return SCHEDULER_LATENESS_NR_BUCKETS - 1;
+  }
+  return bucket;
+}
+
+uint32_t SchedulerTimerStats::getBucketUpperBound(uint8_t bucket)
+{
+  if (bucket >= (SCHEDULER_LATENESS_NR_BUCKETS - 1)) { return UINT32_MAX; }
+  return (1u << bucket) - 1;
+}
+
+uint16_t getSchedulerTimerStatsKey(const SchedulerTimerID& timerID)
+{
+  const SchedulerTimerType_e timerType = timerID.getTimerType();
+  uint16_t key                         = static_cast<uint16_t>(timerType) << 8;
+
+  if (timerType == SchedulerTimerType_e::ConstIntervalTimer) {
+    key |= (timerID.getId() & 0xFF);
+  }
+  return key;
+}
+
+String getSchedulerTimerStatsName(uint16_t key)
+{
+  const SchedulerTimerType_e timerType = static_cast<SchedulerTimerType_e>(key >> 8);
+
+  if (timerType == SchedulerTimerType_e::ConstIntervalTimer) {
+    return toString(static_cast<SchedulerIntervalTimer_e>(key & 0xFF));
+  }
+  return toString(timerType);
+}
+
+void addSchedulerTimerStat(uint16_t key, long lateness_msec, uint64_t statisticsTimerStart)
+{
+  if (Settings.EnableTimingStats()) {
+    schedulerTimerStats[key].add(lateness_msec, usecPassedSince(statisticsTimerStart));
+  }
+}
+
+#endif // if FEATURE_TIMING_STATS
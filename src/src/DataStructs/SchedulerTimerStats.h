@@ -0,0 +1,80 @@
+#ifndef DATASTRUCTS_SCHEDULERTIMERSTATS_H
+#define DATASTRUCTS_SCHEDULERTIMERSTATS_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_TIMING_STATS
+
+# include "../DataStructs/SchedulerTimerID.h"
+# include "../DataStructs/TimingStats.h"
+
+# include <map>
+
+// Lateness histogram buckets (msec): 0, 1, 2-3, 4-7, ... 512-1023, >= 1024
+# define SCHEDULER_LATENESS_NR_BUCKETS  12
+
+
+/*********************************************************************************************\
+* SchedulerTimerStats
+* Per timer type statistics of the scheduler:
+* - Lateness histogram: how late a timer was handled compared to its scheduled time (msec)
+* - Execution time of the handler (usec)
+\*********************************************************************************************/
+class SchedulerTimerStats {
+public:
+
+  void                   add(long    lateness_msec,
+                             int64_t exec_usec);
+
+  uint32_t               getCount() const {
+    return _count;
+  }
+
+  uint32_t               getBucketCount(uint8_t bucket) const;
+
+  uint64_t               getLatenessTotal() const {
+    return _latenessTotal;
+  }
+
+  uint32_t               getLatenessMax() const {
+    return _latenessMax;
+  }
+
+  float                  getLatenessAvg() const;
+
+  const TimingStats    & getExecStats() const {
+    return _execStats;
+  }
+
+  // Bucket index for a given lateness in msec.
+  static uint8_t         getBucketIndex(long lateness_msec);
+
+  // Upper bound (inclusive) of the bucket in msec.
+  // Last bucket has no upper bound, which is returned as UINT32_MAX.
+  static uint32_t        getBucketUpperBound(uint8_t bucket);
+
+private:
+
+  TimingStats _execStats;
+  uint64_t    _latenessTotal = 0;
+  uint32_t    _latenessMax   = 0;
+  uint32_t    _count         = 0;
+  uint32_t    _buckets[SCHEDULER_LATENESS_NR_BUCKETS]{};
+};
+
+
+// Key: timer type in the upper 8 bits,
+// for ConstIntervalTimer the SchedulerIntervalTimer_e in the lower 8 bits.
+extern std::map<uint16_t, SchedulerTimerStats> schedulerTimerStats;
+
+uint16_t getSchedulerTimerStatsKey(const SchedulerTimerID& timerID);
+
+String   getSchedulerTimerStatsName(uint16_t key);
+
+void     addSchedulerTimerStat(uint16_t key,
+                               long     lateness_msec,
+                               uint64_t statisticsTimerStart);
+
+#endif // if FEATURE_TIMING_STATS
+
+#endif // ifndef DATASTRUCTS_SCHEDULERTIMERSTATS_H
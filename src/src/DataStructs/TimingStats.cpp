@@ -205,6 +205,7 @@ const __FlashStringHelper* getMiscStatsName_F(TimingStatsElements stat) {
   switch (stat) {
     case TimingStatsElements::LOADFILE_STATS:             return F("Load File");
     case TimingStatsElements::SAVEFILE_STATS:             return F("Save File");
+    case TimingStatsElements::SAVE_SETTINGS_WRITE_BACK:   return F("Save File write-back");
     case TimingStatsElements::LOOP_STATS:                 return F("Loop");
     case TimingStatsElements::PLUGIN_CALL_50PS:           return F("Plugin call 50 p/s");
     case TimingStatsElements::PLUGIN_CALL_10PS:           return F("Plugin call 10 p/s");
@@ -225,12 +226,15 @@ const __FlashStringHelper* getMiscStatsName_F(TimingStatsElements stat) {
     case TimingStatsElements::MQTT_DELAY_QUEUE:           return F("Delay queue MQTT");
     case TimingStatsElements::TRY_CONNECT_HOST_TCP:       return F("try_connect_host() (TCP)");
     case TimingStatsElements::TRY_CONNECT_HOST_UDP:       return F("try_connect_host() (UDP)");
+    case TimingStatsElements::HTTP_SEND_NEW_CONNECTION:   return F("send_via_http() new connection");
+    case TimingStatsElements::HTTP_SEND_REUSED_CONNECTION: return F("send_via_http() reused connection");
     case TimingStatsElements::HOST_BY_NAME_STATS:         return F("hostByName()");
     case TimingStatsElements::CONNECT_CLIENT_STATS:       return F("connectClient()");
     case TimingStatsElements::LOAD_CUSTOM_TASK_STATS:     return F("LoadCustomTaskSettings()");
     case TimingStatsElements::WIFI_ISCONNECTED_STATS:     return F("WiFi.isConnected()");
     case TimingStatsElements::WIFI_NOTCONNECTED_STATS:    return F("WiFi.isConnected() (fail)");
     case TimingStatsElements::LOAD_TASK_SETTINGS:         return F("LoadTaskSettings()");
+    case TimingStatsElements::LOAD_TASK_SETTINGS_CACHED:  return F("LoadTaskSettings() cached");
     case TimingStatsElements::SAVE_TASK_SETTINGS:         return F("SaveTaskSettings()");
     case TimingStatsElements::LOAD_CONTROLLER_SETTINGS:   return F("LoadControllerSettings()");
     #ifdef ESP32
@@ -253,7 +257,10 @@ const __FlashStringHelper* getMiscStatsName_F(TimingStatsElements stat) {
     case TimingStatsElements::GET_TASKVALUE_AS_STRING:    return F("TaskValueGetAsString()");
     case TimingStatsElements::HANDLE_SCHEDULER_IDLE:      return F("handle_schedule() idle");
     case TimingStatsElements::HANDLE_SCHEDULER_TASK:      return F("handle_schedule() task");
+    case TimingStatsElements::HANDLE_SCHEDULER_CONTINUATION: return F("handle_schedule() continuation");
     case TimingStatsElements::PARSE_TEMPLATE_PADDED:      return F("parseTemplate_padded()");
+    case TimingStatsElements::COMPILE_TEMPLATE:           return F("CompiledTemplate::compile()");
+    case TimingStatsElements::RENDER_TEMPLATE:            return F("CompiledTemplate::render()");
     case TimingStatsElements::PARSE_SYSVAR:               return F("parseSystemVariables()");
     case TimingStatsElements::PARSE_SYSVAR_NOCHANGE:      return F("parseSystemVariables() No change");
     case TimingStatsElements::HANDLE_SERVING_WEBPAGE:     return F("handle webpage");
@@ -72,6 +72,8 @@ enum class TimingStatsElements {
   PARSE_SYSVAR,
   PARSE_SYSVAR_NOCHANGE,
   PARSE_TEMPLATE_PADDED,
+  COMPILE_TEMPLATE,
+  RENDER_TEMPLATE,
   IS_NUMERICAL,
   GET_TASKVALUE_AS_STRING,
   FORMAT_USER_VAR,
@@ -88,12 +90,14 @@ enum class TimingStatsElements {
   // Related to file access
   LOADFILE_STATS,
   LOAD_TASK_SETTINGS,
+  LOAD_TASK_SETTINGS_CACHED,
   LOAD_CUSTOM_TASK_STATS,
   LOAD_CONTROLLER_SETTINGS,
   #ifdef ESP32
   LOAD_CONTROLLER_SETTINGS_C,
   #endif
   SAVEFILE_STATS,
+  SAVE_SETTINGS_WRITE_BACK,
   SAVE_TASK_SETTINGS,
   SAVE_CONTROLLER_SETTINGS,
   TRY_OPEN_FILE,
@@ -106,6 +110,7 @@ enum class TimingStatsElements {
   SET_NEW_TIMER,
   HANDLE_SCHEDULER_TASK,
   HANDLE_SCHEDULER_IDLE,
+  HANDLE_SCHEDULER_CONTINUATION,
   BACKGROUND_TASKS,
 
   // Web serving
@@ -115,6 +120,8 @@ enum class TimingStatsElements {
   // Network related
   TRY_CONNECT_HOST_TCP,
   TRY_CONNECT_HOST_UDP,
+  HTTP_SEND_NEW_CONNECTION,
+  HTTP_SEND_REUSED_CONNECTION,
   HOST_BY_NAME_STATS,
   GRAT_ARP_STATS,
   WIFI_ISCONNECTED_STATS,
@@ -8,6 +8,7 @@
 #include "../Globals/RulesCalculate.h"
 #include "../Helpers/_Plugin_SensorTypeHelper.h"
 #include "../Helpers/CRC_functions.h"
+#include "../Helpers/Numerical.h"
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringParser.h"
 
@@ -378,12 +379,9 @@ const TaskValues_Data_t * UserVarStruct::getRawOrComputed(
     if ((it == _computed.end()) || !it->second.isSet(varNr)) {
       // Try to compute values which do have a formula but not yet a 'computed' value cached.
       // FIXME TD-er: This may yield unexpected results when formula contains references to %pvalue%
-      const int nrDecimals = Cache.getTaskDeviceValueDecimals(taskIndex, varNr);
-      const String value   = getAsString(taskIndex, varNr, sensorType, nrDecimals, true);
-
       constexpr bool applyNow = true;
 
-      if (applyFormula(taskIndex, varNr, value, sensorType, applyNow)) {
+      if (applyFormula(taskIndex, varNr, _rawData[taskIndex], sensorType, applyNow)) {
         it = _computed.find(taskIndex);
       }
     }
@@ -397,11 +395,11 @@ const TaskValues_Data_t * UserVarStruct::getRawOrComputed(
   return getRawTaskValues_Data(taskIndex);
 }
 
-bool UserVarStruct::applyFormula(taskIndex_t    taskIndex,
-                                 taskVarIndex_t varNr,
-                                 const String & value,
-                                 Sensor_VType   sensorType,
-                                 bool           applyNow) const
+bool UserVarStruct::applyFormula(taskIndex_t              taskIndex,
+                                 taskVarIndex_t           varNr,
+                                 const TaskValues_Data_t& data,
+                                 Sensor_VType             sensorType,
+                                 bool                     applyNow) const
 {
   if (!validTaskIndex(taskIndex) ||
       !validTaskVarIndex(varNr) ||
@@ -423,6 +421,49 @@ bool UserVarStruct::applyFormula(taskIndex_t    taskIndex,
     return true;
   }
 
+  // TD-er: Should we use the set nr of decimals here, or not round at all?
+  // See: https://github.com/letscontrolit/ESPEasy/issues/3721#issuecomment-889649437
+  const uint8_t nrDecimals = Cache.getTaskDeviceValueDecimals(taskIndex, varNr);
+
+  const CompiledExpression *compiled = Cache.getCompiledFormula(taskIndex, varNr);
+
+  if (compiled != nullptr) {
+    START_TIMER;
+
+    // Bind %value% and %pvalue% as numerical values.
+    // Round the same way as formatting the value would do.
+    ESPEASY_RULES_FLOAT_TYPE vars[2]{};
+
+    vars[0] = data.getAsDouble(varNr, sensorType);
+
+    if (isFloatOutputDataType(sensorType)
+#if FEATURE_EXTENDED_TASK_VALUE_TYPES && FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+        || isDoubleOutputDataType(sensorType)
+#endif
+        ) {
+      const ESPEASY_RULES_FLOAT_TYPE factor = pow(10, nrDecimals);
+      vars[0] = round(vars[0] * factor) / factor;
+    }
+    vars[1] = vars[0];
+
+    if (formula_has_prevvalue) {
+      auto it = _prevValue.find(makeWord(taskIndex, varNr));
+
+      if (it != _prevValue.end()) {
+        validDoubleFromString(it->second, vars[1]);
+      }
+    }
+
+    ESPEASY_RULES_FLOAT_TYPE result{};
+    const bool res = !isError(compiled->eval(vars, result));
+
+    if (res) {
+      _computed[taskIndex].set(varNr, result, sensorType);
+    }
+
+    STOP_TIMER(COMPUTE_FORMULA_STATS);
+    return res;
+  }
 
   String formula = getPreprocessedFormula(taskIndex, varNr);
   bool   res     = true;
@@ -431,10 +472,10 @@ bool UserVarStruct::applyFormula(taskIndex_t    taskIndex,
   {
     START_TIMER;
 
+    const String value = data.getAsString(varNr, sensorType, nrDecimals);
+
     formula.replace(F("%value%"), value);
 
-    // TD-er: Should we use the set nr of decimals here, or not round at all?
-    // See: https://github.com/letscontrolit/ESPEasy/issues/3721#issuecomment-889649437
     if (formula_has_prevvalue) {
       const String prev_str = getPreviousValue(taskIndex, varNr, sensorType);
       formula.replace(F("%pvalue%"), prev_str.isEmpty() ? value : prev_str);
@@ -476,12 +517,10 @@ bool UserVarStruct::applyFormulaAndSet(taskIndex_t                     taskIndex
   TaskValues_Data_t tmp;
 
   tmp.set(varNr, value, sensorType);
-  const uint8_t nrDecimals = Cache.getTaskDeviceValueDecimals(taskIndex, varNr);
-  const String  value_str  = tmp.getAsString(varNr, sensorType, nrDecimals);
 
   constexpr bool applyNow = false;
 
-  if (applyFormula(taskIndex, varNr, value_str, sensorType, applyNow)) {
+  if (applyFormula(taskIndex, varNr, tmp, sensorType, applyNow)) {
     _rawData[taskIndex].set(varNr, value, sensorType);
     return true;
   }
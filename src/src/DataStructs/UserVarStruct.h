@@ -143,11 +143,12 @@ private:
                                             Sensor_VType   sensorType,
                                             bool           raw) const;
 
-  bool applyFormula(taskIndex_t    taskIndex,
-                    taskVarIndex_t varNr,
-                    const String & value,
-                    Sensor_VType   sensorType,
-                    bool           applyNow) const;
+  // Apply the formula on the value of varNr stored in data.
+  bool applyFormula(taskIndex_t              taskIndex,
+                    taskVarIndex_t           varNr,
+                    const TaskValues_Data_t& data,
+                    Sensor_VType             sensorType,
+                    bool                     applyNow) const;
 
   bool applyFormulaAndSet(taskIndex_t                     taskIndex,
                           taskVarIndex_t                  varNr,
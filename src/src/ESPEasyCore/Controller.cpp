@@ -36,6 +36,46 @@ constexpr pluginID_t PLUGIN_ID_MQTT_IMPORT(37);
 // ********************************************************************************
 // Interface for Sending to Controllers
 // ********************************************************************************
+
+// When the scheduler time budget is exceeded, 'state' is set to the next controller to handle.
+bool sendData_to_controllers(struct EventStruct& event, uint32_t& state)
+{
+  bool sent = false;
+
+  for (; state < CONTROLLER_MAX; ++state)
+  {
+    const controllerIndex_t x = state;
+
+    if (Settings.TaskDeviceSendData[x][event.TaskIndex] &&
+        Settings.ControllerEnabled[x] &&
+        Settings.Protocol[x])
+    {
+      if (sent && Scheduler.sliceBudgetExceeded()) {
+        return false;
+      }
+      event.ControllerIndex = x;
+      event.idx             = Settings.TaskDeviceID[x][event.TaskIndex];
+
+      protocolIndex_t ProtocolIndex = getProtocolIndex_from_ControllerIndex(x);
+
+      if (validUserVar(&event)) {
+        String dummy;
+        CPluginCall(ProtocolIndex, CPlugin::Function::CPLUGIN_PROTOCOL_SEND, &event, dummy);
+        sent = true;
+      }
+#ifndef BUILD_NO_DEBUG
+      else {
+        if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+          addLogFormat(LOG_LEVEL_DEBUG, F("Invalid value detected for controller %s"),
+                       getCPluginNameFromProtocolIndex(ProtocolIndex));
+        }
+      }
+#endif // ifndef BUILD_NO_DEBUG
+    }
+  }
+  return true;
+}
+
 void sendData(struct EventStruct *event, bool sendEvents)
 {
   START_TIMER;
@@ -54,31 +94,13 @@ void sendData(struct EventStruct *event, bool sendEvents)
 
 //  LoadTaskSettings(event->TaskIndex); // could have changed during background tasks.
 
-  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; x++)
-  {
-    event->ControllerIndex = x;
-    event->idx             = Settings.TaskDeviceID[x][event->TaskIndex];
+  uint32_t controllerIndex = 0;
 
-    if (Settings.TaskDeviceSendData[event->ControllerIndex][event->TaskIndex] &&
-        Settings.ControllerEnabled[event->ControllerIndex] &&
-        Settings.Protocol[event->ControllerIndex])
-    {
-      protocolIndex_t ProtocolIndex = getProtocolIndex_from_ControllerIndex(event->ControllerIndex);
-
-      if (validUserVar(event)) {
-        String dummy;
-        CPluginCall(ProtocolIndex, CPlugin::Function::CPLUGIN_PROTOCOL_SEND, event, dummy);
-      }
-#ifndef BUILD_NO_DEBUG
-      else {
-        if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-          String log = F("Invalid value detected for controller ");
-          log += getCPluginNameFromProtocolIndex(ProtocolIndex);
-          addLogMove(LOG_LEVEL_DEBUG, log);
-        }
-      }
-#endif // ifndef BUILD_NO_DEBUG
-    }
+  if (!sendData_to_controllers(*event, controllerIndex)) {
+    // Took too long, send to the remaining controllers in a next loop.
+    EventStruct remaining;
+    remaining.deep_copy(event);
+    Scheduler.schedule_continuation(sendData_to_controllers, std::move(remaining), controllerIndex);
   }
 
   lastSend = millis();
@@ -266,21 +288,12 @@ bool MQTTConnect(controllerIndex_t controller_idx)
 
     return false;
   }
-  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-    String log;
-    log += F("MQTT : Connected to broker with client ID: ");
-    log += clientid;
-    addLogMove(LOG_LEVEL_INFO, log);
-  }
+  addLogFormat(LOG_LEVEL_INFO, F("MQTT : Connected to broker with client ID: %s"), clientid.c_str());
   String subscribeTo = ControllerSettings->Subscribe;
 
   parseSystemVariables(subscribeTo, false);
   MQTTclient.subscribe(subscribeTo.c_str());
-  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-    String log  = F("Subscribed to: ");
-    log += subscribeTo;
-    addLogMove(LOG_LEVEL_INFO, log);
-  }
+  addLogFormat(LOG_LEVEL_INFO, F("Subscribed to: %s"), subscribeTo.c_str());
 
   updateMQTTclient_connected();
   statusLED(true);
@@ -535,7 +548,7 @@ bool MQTTpublish(controllerIndex_t controller_idx, taskIndex_t taskIndex, const
   if (MQTT_queueFull(controller_idx)) {
     return false;
   }
-  const bool success = MQTTDelayHandler->addToQueue(std::unique_ptr<MQTT_queue_element>(new MQTT_queue_element(controller_idx, taskIndex, topic, payload, retained, callbackTask)));
+  const bool success = MQTTDelayHandler->addToQueue(std::unique_ptr<MQTT_queue_element>(new (MQTTDelayHandler->pool) MQTT_queue_element(controller_idx, taskIndex, topic, payload, retained, callbackTask)));
 
   scheduleNextMQTTdelayQueue();
   return success;
@@ -550,7 +563,7 @@ bool MQTTpublish(controllerIndex_t controller_idx, taskIndex_t taskIndex,  Strin
     return false;
   }
 
-  const bool success = MQTTDelayHandler->addToQueue(std::unique_ptr<MQTT_queue_element>(new MQTT_queue_element(controller_idx, taskIndex, std::move(topic), std::move(payload), retained, callbackTask)));
+  const bool success = MQTTDelayHandler->addToQueue(std::unique_ptr<MQTT_queue_element>(new (MQTTDelayHandler->pool) MQTT_queue_element(controller_idx, taskIndex, std::move(topic), std::move(payload), retained, callbackTask)));
 
   scheduleNextMQTTdelayQueue();
   return success;
@@ -11,6 +11,10 @@
 // ********************************************************************************
 void sendData(struct EventStruct *event, bool sendEvents = true);
 
+// Send to all enabled controllers for this task, starting at controller index 'state'.
+// Return false when interrupted as the scheduler time budget was exceeded.
+bool sendData_to_controllers(struct EventStruct& event, uint32_t& state);
+
 bool validUserVar(struct EventStruct *event);
 
 #if FEATURE_MQTT
@@ -14,6 +14,7 @@
 #include "../Globals/Plugins_other.h"
 #include "../Globals/RulesCalculate.h"
 #include "../Globals/Settings.h"
+#include "../Helpers/ArgumentTokenizer.h"
 #include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/ESPEasy_time_calc.h"
 #include "../Helpers/FS_Helper.h"
@@ -62,6 +63,12 @@ String FileNameToEvent(const String& fileName) {
 
 void checkRuleSets() {
   Cache.rulesHelper.closeAllFiles();
+
+  if (Settings.UseRules && Settings.OldRulesEngine() && Settings.EnableRulesCaching()) {
+    // Read and pre-compile the rules right away,
+    // so the first event does not have to wait for it.
+    Cache.rulesHelper.init();
+  }
 }
 
 /********************************************************************************************\
@@ -98,9 +105,7 @@ void rulesProcessing(const String& event) {
   const unsigned long timer = millis();
 #endif // ifndef BUILD_NO_DEBUG
 
-  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-    addLogMove(LOG_LEVEL_INFO, concat(F("EVENT: "), event));
-  }
+  addLogFormat(LOG_LEVEL_INFO, F("EVENT: %s"), event.c_str());
 
   if (Settings.OldRulesEngine()) {
     bool eventHandled = false;
@@ -109,8 +114,15 @@ void rulesProcessing(const String& event) {
       String filename;
       size_t pos = 0;
       if (Cache.rulesHelper.findMatchingRule(event, filename, pos)) {
-        const bool startOnMatched = true; // We already matched the event
-        eventHandled = rulesProcessingFile(filename, event, pos, startOnMatched);
+        #ifdef CACHE_RULES_IN_MEMORY
+        if (Cache.rulesHelper.getCompiledRules(filename) != nullptr) {
+          eventHandled = rulesProcessingCompiled(filename, event, pos);
+        } else
+        #endif // ifdef CACHE_RULES_IN_MEMORY
+        {
+          const bool startOnMatched = true; // We already matched the event
+          eventHandled = rulesProcessingFile(filename, event, pos, startOnMatched);
+        }
       }
     } else {
       for (uint8_t x = 0; x < RULESETS_MAX && !eventHandled; x++) {
@@ -127,8 +139,8 @@ void rulesProcessing(const String& event) {
     }
     # ifndef BUILD_NO_DEBUG
     else {
-      addLog(LOG_LEVEL_DEBUG, strformat(F("EVENT: %s is ingnored. File %s not found."),
-             event.c_str(), fileName.c_str()));
+      addLogFormat(LOG_LEVEL_DEBUG, F("EVENT: %s is ingnored. File %s not found."),
+                   event.c_str(), fileName.c_str());
     }
     # endif    // ifndef BUILD_NO_DEBUG
     #endif // WEBSERVER_NEW_RULES
@@ -136,9 +148,7 @@ void rulesProcessing(const String& event) {
 
 #ifndef BUILD_NO_DEBUG
 
-  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-    addLogMove(LOG_LEVEL_DEBUG, strformat(F("EVENT: %s Processing: %d ms"), event.c_str(), timePassedSince(timer)));
-  }
+  addLogFormat(LOG_LEVEL_DEBUG, F("EVENT: %s Processing: %d ms"), event.c_str(), timePassedSince(timer));
 #endif // ifndef BUILD_NO_DEBUG
   STOP_TIMER(RULES_PROCESSING);
   backgroundtasks();
@@ -236,6 +246,211 @@ bool rulesProcessingFile(const String& fileName,
 }
 
 
+#ifdef CACHE_RULES_IN_MEMORY
+
+/********************************************************************************************\
+   Rules processing using the pre-compiled rules lines
+ \*********************************************************************************************/
+// Return the part of the line to process with event values and templates substituted.
+// This is the compiled line itself when it does not need any substitution, else 'buffer' holds the result.
+const String& rulesPrepareLine(const RulesLine& rulesLine, const String& event, String& buffer) {
+  const String& part          = rulesLine.getPart();
+  const bool    mustSubstitute = rulesLine._hasEventVar || (substitute_eventvalue_CallBack_ptr != nullptr);
+  const bool    mustParse      = rulesLine._hasTemplate || (parseTemplate_CallBack_ptr != nullptr);
+
+  if (!mustSubstitute && !mustParse) {
+    return part;
+  }
+
+  // Both change the string in place
+  buffer = part;
+
+  if (mustSubstitute) {
+    substitute_eventvalue(buffer, event);
+  }
+
+  if (mustParse) {
+    buffer = parseTemplate(buffer);
+  }
+  return buffer;
+}
+
+bool rulesEvaluateCondition(const RulesLine& rulesLine, const String& event, uint8_t ifBlock) {
+  String check;
+  const String& prepared = rulesPrepareLine(rulesLine, event, check);
+
+  if (&prepared != &check) {
+    // conditionMatchExtended changes the string, so it needs a copy.
+    check = prepared;
+  }
+
+  check.toLowerCase();
+  check.trim();
+  const bool res = conditionMatchExtended(check);
+#ifndef BUILD_NO_DEBUG
+
+  addLogFormat(LOG_LEVEL_DEBUG, F("Lev.%d: [%s %s]=%s"),
+               ifBlock,
+               rulesLine._type == RulesLineType::If ? F("if") : F("elseif"),
+               check,
+               boolToString(res));
+#endif // ifndef BUILD_NO_DEBUG
+  return res;
+}
+
+void rulesExecuteCompiledCommand(const RulesLine& rulesLine, const String& event) {
+  String buffer;
+  const String& prepared = rulesPrepareLine(rulesLine, event, buffer);
+
+  if (rulesLine._restrict) {
+    String action = concat(F("restrict,"), prepared);
+
+    if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+      addLog(LOG_LEVEL_ERROR, concat(F("Rules : Prefix command with 'restrict': "), action));
+    }
+    executeRulesAction(action, event);
+  } else if ((substitute_eventvalue_CallBack_ptr == nullptr) && (prepared.indexOf(F("%event")) == -1)) {
+    // Nothing left to substitute, execute the compiled line as-is.
+    executeRulesCommand(prepared);
+  } else {
+    if (&prepared != &buffer) {
+      buffer = prepared;
+    }
+    executeRulesAction(buffer, event);
+  }
+}
+
+bool rulesProcessingCompiled(const String& fileName,
+                             const String& event,
+                             size_t        pos) {
+  const RulesHelperClass::RulesLines *lines = Cache.rulesHelper.getCompiledRules(fileName);
+
+  if ((lines == nullptr) || (pos >= lines->size()) ||
+      ((*lines)[pos]._type != RulesLineType::On)) {
+    return false;
+  }
+  #ifndef BUILD_NO_RAM_TRACKER
+  checkRAM(F("rulesProcessingCompiled"));
+  #endif // ifndef BUILD_NO_RAM_TRACKER
+
+  static uint8_t nestingLevel = 0;
+
+  nestingLevel++;
+
+  if (nestingLevel > RULES_MAX_NESTING_LEVEL) {
+    addLog(LOG_LEVEL_ERROR, F("EVENT: Error: Nesting level exceeded!"));
+    nestingLevel--;
+    return false;
+  }
+
+  // Executing a command may trigger reloading the rules, which invalidates 'lines'
+  const uint32_t generation = Cache.rulesHelper.getGeneration();
+
+  const RulesLine& onLine = (*lines)[pos];
+
+  // Only set when the "endon" of the block was reached
+  bool eventHandled = false;
+
+  if (onLine._isOneLiner) {
+    START_TIMER
+    rulesExecuteCompiledCommand(onLine, event);
+    eventHandled = true;
+    STOP_TIMER(RULES_PROCESS_MATCHED);
+  } else {
+    bool    condition[RULES_IF_MAX_NESTING_LEVEL];
+    bool    ifBranche[RULES_IF_MAX_NESTING_LEVEL];
+    uint8_t ifBlock     = 0;
+    uint8_t fakeIfBlock = 0;
+    bool    done        = false;
+
+    for (size_t i = pos + 1; !done && i < lines->size(); ++i) {
+      START_TIMER
+      const RulesLine& rulesLine = (*lines)[i];
+      const bool active          = !fakeIfBlock &&
+                                   (!ifBlock || (condition[ifBlock - 1] == ifBranche[ifBlock - 1]));
+
+      switch (rulesLine._type) {
+        case RulesLineType::On:
+          // Missing "endon"
+          done = true;
+          break;
+        case RulesLineType::EndOn:
+          done         = true;
+          eventHandled = true;
+          break;
+        case RulesLineType::If:
+
+          if (ifBlock < RULES_IF_MAX_NESTING_LEVEL) {
+            if (active) {
+              ifBlock++;
+              condition[ifBlock - 1] = rulesEvaluateCondition(rulesLine, event, ifBlock);
+              ifBranche[ifBlock - 1] = true;
+            } else {
+              fakeIfBlock++;
+            }
+          } else {
+            fakeIfBlock++;
+
+            addLogFormat(LOG_LEVEL_ERROR, F("Lev.%d: Error: IF Nesting level exceeded!"), ifBlock);
+          }
+          break;
+        case RulesLineType::ElseIf:
+
+          if (ifBlock && !fakeIfBlock && ifBranche[ifBlock - 1]) {
+            if (condition[ifBlock - 1]) {
+              ifBranche[ifBlock - 1] = false;
+            } else {
+              condition[ifBlock - 1] = rulesEvaluateCondition(rulesLine, event, ifBlock);
+            }
+          }
+          break;
+        case RulesLineType::Else:
+
+          if (ifBlock && !fakeIfBlock) {
+            ifBranche[ifBlock - 1] = false;
+#ifndef BUILD_NO_DEBUG
+            addLogFormat(LOG_LEVEL_DEBUG, F("Lev.%d: [else]=%s"),
+                         ifBlock,
+                         boolToString(condition[ifBlock - 1] == ifBranche[ifBlock - 1]));
+#endif // ifndef BUILD_NO_DEBUG
+          }
+          break;
+        case RulesLineType::EndIf:
+
+          if (fakeIfBlock) {
+            fakeIfBlock--;
+          } else if (ifBlock) {
+            ifBlock--;
+          }
+          break;
+        case RulesLineType::Command:
+
+          if (active) {
+            rulesExecuteCompiledCommand(rulesLine, event);
+
+            if (generation != Cache.rulesHelper.getGeneration()) {
+              // Rules were reloaded, the compiled lines are no longer valid.
+              // 'lines' may already be freed, so do not access it anymore.
+              done         = true;
+              eventHandled = true;
+            }
+          }
+          break;
+      }
+      STOP_TIMER(RULES_PROCESS_MATCHED);
+    }
+  }
+
+  nestingLevel--;
+  #ifndef BUILD_NO_RAM_TRACKER
+  checkRAM(F("rulesProcessingCompiled2"));
+  #endif // ifndef BUILD_NO_RAM_TRACKER
+  backgroundtasks();
+  return eventHandled;
+}
+
+#endif // ifdef CACHE_RULES_IN_MEMORY
+
 /********************************************************************************************\
    Parse string commands
  \*********************************************************************************************/
@@ -467,10 +682,15 @@ void parse_string_commands(String& line) {
   while (get_next_inner_bracket(line, startIndex, closingIndex, '}')) {
     // Command without opening and closing brackets.
     const String fullCommand = line.substring(startIndex + 1, closingIndex);
-    const String cmd_s_lower = parseString(fullCommand, 1, ':');
-    const String arg1        = parseStringKeepCaseNoTrim(fullCommand, 2, ':');
-    const String arg2        = parseStringKeepCaseNoTrim(fullCommand, 3, ':');
-    const String arg3        = parseStringKeepCaseNoTrim(fullCommand, 4, ':');
+    String cmd_s_lower, arg1, arg2, arg3;
+    {
+      const ArgumentTokenizer tokens(fullCommand.c_str(), ':');
+      const ArgumentTokenizer::ActiveScope activeTokens(tokens);
+      cmd_s_lower = parseString(fullCommand, 1, ':');
+      arg1        = parseStringKeepCaseNoTrim(fullCommand, 2, ':');
+      arg2        = parseStringKeepCaseNoTrim(fullCommand, 3, ':');
+      arg3        = parseStringKeepCaseNoTrim(fullCommand, 4, ':');
+    }
 
     if (cmd_s_lower.length() > 0) {
       String replacement; // maybe just replace with empty to avoid looping?
@@ -658,6 +878,9 @@ void substitute_eventvalue(String& line, const String& event) {
         argString = event.substring(equalsPos + 1);
       }
 
+      // Event values are only parsed once, for all %eventvalueX% in the line.
+      const ArgumentTokenizer argTokens(argString.c_str());
+
       // Replace %eventvalueX% with the actual value of the event.
       // For compatibility reasons also replace %eventvalue%  (argc = 0)
       line.replace(F("%eventvalue%"), F("%eventvalue1%"));
@@ -701,7 +924,7 @@ void substitute_eventvalue(String& line, const String& event) {
             if (argc > 0) {
               String tmpParam;
 
-              if (!GetArgv(argString.c_str(), tmpParam, argc)) {
+              if (!argTokens.getArgv(argc, tmpParam)) {
                 // Replace with default value for non existing event values
                 tmpParam = parseTemplate(defaultValue);
               }
@@ -967,24 +1190,42 @@ void processMatchedRule(String& action, const String& event,
   // process the action if it's a command and unconditional, or conditional and
   // the condition matches the if or else block.
   if (isCommand) {
-    substitute_eventvalue(action, event);
+    executeRulesAction(action, event);
+  }
+}
 
-    const bool executeRestricted = equals(parseString(action, 1), F("restrict"));
+void executeRulesAction(String& action, const String& event) {
+  substitute_eventvalue(action, event);
+  executeRulesCommand(action);
+}
 
-    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-      String actionlog = executeRestricted ? F("ACT  : (restricted) ") : F("ACT  : ");
-      actionlog += action;
-      addLogMove(LOG_LEVEL_INFO, actionlog);
-    }
+void executeRulesCommand(const String& action) {
+  bool   executeRestricted = false;
+  String restrictedAction;
+
+  {
+    // Only active while parsing here, as the action may refer to a compiled rules line,
+    // which is freed when the command reloads the rules.
+    const ArgumentTokenizer tokens(action.c_str());
+    const ArgumentTokenizer::ActiveScope activeTokens(tokens);
+    executeRestricted = equals(parseString(action, 1), F("restrict"));
 
     if (executeRestricted) {
-      ExecuteCommand_all({EventValueSource::Enum::VALUE_SOURCE_RULES_RESTRICTED, parseStringToEndKeepCase(action, 2)});
-    } else {
-      // Use action.c_str() here as we need to preserve the action string.
-      ExecuteCommand_all({EventValueSource::Enum::VALUE_SOURCE_RULES, action.c_str()});
+      restrictedAction = parseStringToEndKeepCase(action, 2);
     }
-    delay(0);
   }
+
+  addLogFormat(LOG_LEVEL_INFO,
+               executeRestricted ? F("ACT  : (restricted) %s") : F("ACT  : %s"),
+               action.c_str());
+
+  if (executeRestricted) {
+    ExecuteCommand_all({EventValueSource::Enum::VALUE_SOURCE_RULES_RESTRICTED, std::move(restrictedAction)});
+  } else {
+    // Use action.c_str() here as we need to preserve the action string.
+    ExecuteCommand_all({EventValueSource::Enum::VALUE_SOURCE_RULES, action.c_str()});
+  }
+  delay(0);
 }
 
 /********************************************************************************************\
@@ -1338,7 +1579,7 @@ void createRuleEvents(struct EventStruct *event) {
     eventQueue.add(event->TaskIndex, F("All"), eventvalues);
   } else {
     for (uint8_t varNr = 0; varNr < valueCount; varNr++) {
-      eventQueue.add(event->TaskIndex, getTaskValueName(event->TaskIndex, varNr), formatUserVarNoCheck(event, varNr));
+      eventQueue.addTaskValueEvent(event->TaskIndex, varNr, formatUserVarNoCheck(event, varNr));
     }
   }
 }
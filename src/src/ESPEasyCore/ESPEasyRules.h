@@ -7,6 +7,7 @@
 #include "../../ESPEasy_common.h"
 
 #include "../CustomBuild/ESPEasyLimits.h"
+#include "../Helpers/RulesHelper.h"
 
 
 #ifdef WEBSERVER_NEW_RULES
@@ -39,6 +40,19 @@ bool rulesProcessingFile(const String& fileName,
                          bool   startOnMatched = false);
 
 
+#ifdef CACHE_RULES_IN_MEMORY
+
+/********************************************************************************************\
+   Rules processing using the pre-compiled rules lines.
+   Start at the "on" line found at pos in the compiled rules of fileName,
+   which must already be matched with the event.
+   Return true when event was handled.
+ \*********************************************************************************************/
+bool rulesProcessingCompiled(const String& fileName,
+                             const String& event,
+                             size_t        pos);
+#endif // ifdef CACHE_RULES_IN_MEMORY
+
 
 /********************************************************************************************\
    Parse string commands
@@ -92,6 +106,13 @@ void processMatchedRule(String& action,
                         uint8_t  & ifBlock,
                         uint8_t  & fakeIfBlock);
 
+// Substitute event values and execute a rules action as command.
+void executeRulesAction(String      & action,
+                        const String& event);
+
+// Execute a rules action as command, which has no event values left to substitute.
+void executeRulesCommand(const String& action);
+
 
 /********************************************************************************************\
    Check expression
@@ -7,6 +7,7 @@
 #include "../Globals/ESPEasyWiFiEvent.h"
 #include "../Globals/Logging.h"
 #include "../Globals/Settings.h"
+#include "../Helpers/Convert.h"
 #include "../Helpers/Networking.h"
 #include "../Helpers/StringConverter.h"
 
@@ -191,66 +192,108 @@ bool loglevelActiveFor(uint8_t destination, uint8_t logLevel) {
   return logLevel <= logLevelSettings;
 }
 
+// When called from an ISR, you should not send out logs.
+// Allocating memory from within an ISR is a big no-no.
+// Also long-time blocking like sending logs (especially to a syslog server)
+// is also really not a good idea from an ISR call.
+static bool calledFromISR()
+{
+  #ifdef ESP32
+  return xPortInIsrContext();
+  #else
+  return false;
+  #endif
+}
+
+// Whether a log line must be stored in the log buffer, to be read by the serial, syslog or web log.
+static bool logBufferActiveFor(uint8_t logLevel)
+{
+  return loglevelActiveFor(LOG_TO_SERIAL, logLevel) ||
+         loglevelActiveFor(LOG_TO_SYSLOG, logLevel) ||
+         loglevelActiveFor(LOG_TO_WEBLOG, logLevel);
+}
+
 void addLog(uint8_t logLevel, const __FlashStringHelper *str)
 {
+  if (calledFromISR()) return;
+
   if (loglevelActiveFor(logLevel)) {
-    String copy;
-    if (!reserve_special(copy, strlen_P((PGM_P)str))) {
-      return;
+#if FEATURE_SD
+    if (loglevelActiveFor(LOG_TO_SDCARD, logLevel)) {
+      addToSDLog(logLevel, String(str));
+    }
+#endif
+    if (logBufferActiveFor(logLevel)) {
+      // Only the pointer to the flash string is stored.
+      Logging.add(logLevel, str);
+      process_serialLog();
     }
-    copy = str;
-    addToLogMove(logLevel, std::move(copy));
   }
 }
 
 void addLog(uint8_t logLevel, const char *line)
 {
+  if (calledFromISR()) return;
+
   // Please note all functions called from here handling line must be PROGMEM aware.
   if (loglevelActiveFor(logLevel)) {
-
-    String copy;
+    size_t length = 0;
     #ifdef USE_SECOND_HEAP
+    const bool inIram = mmu_is_iram(line);
+    if (inIram) {
+      while (mmu_get_uint8(line + length) != 0) {
+        ++length;
+      }
+    } else
+    #endif
     {
-      // Allow to store the logs in 2nd heap if present.
-      if (mmu_is_iram(line)) {
-        size_t length = 0;
-        const char* cur_char = line;
-        bool copying = false;
-        bool done = false;
-        while (!done) {
-          const uint8_t ch = mmu_get_uint8(cur_char++);
-          if (ch == 0) {
-            if (copying) {
-              done = true;
-            } else {
-              if (!reserve_special(copy, length)) {
-                return;
-              }
-              copying = true;
-              cur_char = line;
-            }
-          } else {
-            if (copying) {
-              copy +=  (char)ch;
-            } else {
-              ++length;
-            }
-          }
+      length = strlen_P(line);
+    }
+    if (length == 0) return;
+
+    // Copy to RAM, typical log lines fit in the buffer on the stack.
+    char        buf[128];
+    String      copy;
+    const char *text = buf;
+
+    if (length < sizeof(buf)) {
+      #ifdef USE_SECOND_HEAP
+      if (inIram) {
+        for (size_t i = 0; i < length; ++i) {
+          buf[i] = (char)mmu_get_uint8(line + i);
         }
-      } else {
-        if (!reserve_special(copy, strlen_P((PGM_P)line))) {
-          return;
+      } else
+      #endif
+      {
+        memcpy_P(buf, line, length);
+      }
+      buf[length] = '\0';
+    } else {
+      if (!copy.reserve(length)) {
+        return;
+      }
+      #ifdef USE_SECOND_HEAP
+      if (inIram) {
+        for (size_t i = 0; i < length; ++i) {
+          copy += (char)mmu_get_uint8(line + i);
         }
-        copy = line;
+      } else
+      #endif
+      {
+        copy = reinterpret_cast<const __FlashStringHelper *>(line);
       }
+      text = copy.c_str();
     }
-    #else 
-    if (!copy.reserve(strlen_P((PGM_P)line))) {
-      return;
+
+#if FEATURE_SD
+    if (loglevelActiveFor(LOG_TO_SDCARD, logLevel)) {
+      addToSDLog(logLevel, String(text));
+    }
+#endif
+    if (logBufferActiveFor(logLevel)) {
+      Logging.add(logLevel, text, length);
+      process_serialLog();
     }
-    copy = line;
-    #endif
-    addToLogMove(logLevel, std::move(copy));
   }
 }
 
@@ -259,35 +302,64 @@ void addLog(uint8_t logLevel, String&& string)
   addToLogMove(logLevel, std::move(string));
 }
 
+void addToLog(uint8_t logLevel, const LogFormat_t& logFormat)
+{
+  if (calledFromISR()) return;
+
+  if (logFormat.size() > LOG_FORMAT_DATA_SIZE) {
+    // Too large for a format record, store the rendered line as text.
+    String line;
+    LogFormat_t::render(logFormat.data(), logFormat.size(), line);
+    addToLogMove(logLevel, std::move(line));
+    return;
+  }
 
-#ifndef LIMIT_BUILD_SIZE
-#include "../Helpers/Memory.h"
+#if FEATURE_SD
+  if (loglevelActiveFor(LOG_TO_SDCARD, logLevel)) {
+    String line;
+    LogFormat_t::render(logFormat.data(), logFormat.size(), line);
+    addToSDLog(logLevel, line);
+  }
 #endif
+  if (logBufferActiveFor(logLevel)) {
+    Logging.add(logLevel, logFormat);
+    process_serialLog();
+  }
+}
 
-void addToSerialLog(uint8_t logLevel, const String& string)
+
+void process_serialLog()
 {
-  if (loglevelActiveFor(LOG_TO_SERIAL, logLevel)) {
-    ESPEasy_Console.addToSerialBuffer(format_msec_duration(millis()));
+  const uint8_t logLevel = getSerialLogLevel();
+  LogEntry_t entry;
+
+  while (Logging.getNext(LogConsumer_e::Serial, logLevel, entry)) {
+    String line;
+    line.reserve(entry._message.length() + 32);
+    line += format_msec_duration(entry._timestamp);
     #ifndef LIMIT_BUILD_SIZE
-    ESPEasy_Console.addToSerialBuffer(strformat(F(" : (%d) "), FreeMem()));
+    line += strformat(F(" : (%d) "), entry._freeMem);
     #endif
     {
-      String loglevelDisplayString = getLogLevelDisplayString(logLevel);
-      while (loglevelDisplayString.length() < 6) {
-        loglevelDisplayString += ' ';
+      const size_t levelStart = line.length();
+      line += getLogLevelDisplayString(entry._loglevel);
+      while ((line.length() - levelStart) < 6) {
+        line += ' ';
       }
-      ESPEasy_Console.addToSerialBuffer(loglevelDisplayString);
     }
-    ESPEasy_Console.addToSerialBuffer(F(" : "));
-    ESPEasy_Console.addToSerialBuffer(string);
+    line += F(" : ");
+    line += entry._message;
+    ESPEasy_Console.addToSerialBuffer(line);
     ESPEasy_Console.addNewlineToSerialBuffer();
   }
 }
 
-void addToSysLog(uint8_t logLevel, const String& string)
+void process_syslog()
 {
-  if (loglevelActiveFor(LOG_TO_SYSLOG, logLevel)) {
-    sendSyslog(logLevel, string);
+  LogEntry_t entry;
+
+  while (Logging.getNext(LogConsumer_e::Syslog, Settings.SyslogLevel, entry)) {
+    sendSyslog(entry._loglevel, entry._message.c_str(), entry._message.length());
   }
 }
 
@@ -312,46 +384,20 @@ void addToSDLog(uint8_t logLevel, const String& string)
 
 void addLog(uint8_t logLevel, const String& string)
 {
-  #ifdef ESP32
-  if (xPortInIsrContext()) {
-    // When called from an ISR, you should not send out logs.
-    // Allocating memory from within an ISR is a big no-no.
-    // Also long-time blocking like sending logs (especially to a syslog server) 
-    // is also really not a good idea from an ISR call.
-    return;
-  }
-  #endif
+  if (calledFromISR()) return;
 
   if (string.isEmpty()) return;
-  addToSerialLog(logLevel, string);
-  addToSysLog(logLevel, string);
   addToSDLog(logLevel, string);
-  if (loglevelActiveFor(LOG_TO_WEBLOG, logLevel)) {
+  if (logBufferActiveFor(logLevel)) {
     Logging.add(logLevel, string);
+    process_serialLog();
   }
 }
 
 void addToLogMove(uint8_t logLevel, String&& string)
 {
-  #ifdef ESP32
-  if (xPortInIsrContext()) {
-    // When called from an ISR, you should not send out logs.
-    // Allocating memory from within an ISR is a big no-no.
-    // Also long-time blocking like sending logs (especially to a syslog server) 
-    // is also really not a good idea from an ISR call.
-    return;
-  }
-  #endif
+  addLog(logLevel, static_cast<const String&>(string));
 
-  if (string.isEmpty()) return;
-  addToSerialLog(logLevel, string);
-  addToSysLog(logLevel, string);
-  addToSDLog(logLevel, string);
-
-  // May clear the string, so call as last one.
-  if (loglevelActiveFor(LOG_TO_WEBLOG, logLevel)) {
-    Logging.add(logLevel, std::move(string));
-  }
   // Make sure the string may no longer keep up memory
   string = String();
 }
@@ -4,6 +4,10 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../DataStructs/LogFormat.h"
+
+#include <initializer_list>
+
 #define LOG_LEVEL_NONE                      0
 #define LOG_LEVEL_ERROR                     1
 #define LOG_LEVEL_INFO                      2
@@ -56,5 +60,38 @@ void addLog(uint8_t logLevel, String&& string);
 void addLog(uint8_t logLevel, const String& string);
 void addToLogMove(uint8_t logLevel, String&& string);
 
+void addToLog(uint8_t logLevel, const LogFormat_t& logFormat);
+
+// Log a line with printf-style format, which is only rendered when read from the log buffer.
+// Prefer this over strformat() for frequently logged lines, as it does not allocate
+// when only the web log is active.
+// Usage: addLogFormat(LOG_LEVEL_INFO, F("EVENT: %s"), event.c_str());
+template<typename ... Args>
+void addLogFormat(uint8_t logLevel, const __FlashStringHelper *format, const Args& ... args)
+{
+  static_assert(sizeof...(Args) <= LOG_FORMAT_MAX_ARGS, "Too many arguments for addLogFormat");
+
+  if (loglevelActiveFor(logLevel)) {
+    LogFormat_t logFormat(format);
+    (void)std::initializer_list<int>{ (logFormat.add(args), 0)... };
+
+    if (logFormat.isTruncated()) {
+      // An argument did not fit, collect them again with room for all.
+      // This is rendered right away, as it is too large for a format record.
+      LogFormat_t fullFormat(format, logFormat.requiredSize());
+      (void)std::initializer_list<int>{ (fullFormat.add(args), 0)... };
+      addToLog(logLevel, fullFormat);
+    } else {
+      addToLog(logLevel, logFormat);
+    }
+  }
+}
+
+// Write the log lines not yet sent to the serial console.
+void process_serialLog();
+
+// Send the log lines not yet sent to the syslog server.
+void process_syslog();
+
 
 #endif 
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "../../ESPEasy-Globals.h"
 #include "../DataStructs/TimingStats.h"
 #include "../ESPEasyCore/ESPEasyNetwork.h"
+#include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../ESPEasyCore/Serial.h"
 #include "../Globals/NetworkState.h"
 #include "../Globals/Services.h"
@@ -74,6 +75,7 @@ void backgroundtasks()
    */
 
   process_serialWriteBuffer();
+  process_syslog();
 
   if (!UseRTOSMultitasking) {
     serial();
@@ -0,0 +1,5 @@
+#include "../Globals/HTTPClientPool.h"
+
+#if FEATURE_HTTP_CLIENT
+HTTPClientPool httpClientPool;
+#endif // if FEATURE_HTTP_CLIENT
@@ -0,0 +1,10 @@
+#ifndef GLOBALS_HTTPCLIENTPOOL_H
+#define GLOBALS_HTTPCLIENTPOOL_H
+
+#include "../Helpers/HTTPClientPool.h"
+
+#if FEATURE_HTTP_CLIENT
+extern HTTPClientPool httpClientPool;
+#endif // if FEATURE_HTTP_CLIENT
+
+#endif // GLOBALS_HTTPCLIENTPOOL_H
@@ -522,9 +522,16 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
   // info += lastTask;
   // addLog(LOG_LEVEL_INFO, info);
 
+      // Only offer the command to tasks running a plugin which may handle it.
+      const String cmd_lc = parseString(command, 1);
+
       for (taskIndex_t task = firstTask; task < lastTask; task++)
       {
-        bool retval = PluginCallForTask(task, Function, &TempEvent, command);
+        bool retval = false;
+
+        if (Plugin_acceptsCommand(Settings.getPluginID_for_task(task), cmd_lc)) {
+          retval = PluginCallForTask(task, Function, &TempEvent, command);
+        }
 
         if (!retval) {
           if (1 == (lastTask - firstTask)) {
@@ -61,9 +61,10 @@ CalculateReturnCode Calculate_preProcessed(const String& preprocessd_input,
 CalculateReturnCode Calculate(const String& input,
                               ESPEASY_RULES_FLOAT_TYPE      & result)
 {
-  CalculateReturnCode returnCode = Calculate_preProcessed(
-    RulesCalculate_t::preProces(input),
-    result);
+  START_TIMER;
+  CalculateReturnCode returnCode = RulesCalculate.doCalculate(input, result);
+
+  STOP_TIMER(COMPUTE_STATS);
 #ifndef LIMIT_BUILD_SIZE
   if (isError(returnCode)) {
     if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
@@ -0,0 +1,5 @@
+#include "../Globals/SettingsWriteBack.h"
+
+#if FEATURE_SETTINGS_WRITE_BACK
+SettingsWriteBack settingsWriteBack;
+#endif // if FEATURE_SETTINGS_WRITE_BACK
@@ -0,0 +1,10 @@
+#ifndef GLOBALS_SETTINGSWRITEBACK_H
+#define GLOBALS_SETTINGSWRITEBACK_H
+
+#include "../Helpers/SettingsWriteBack.h"
+
+#if FEATURE_SETTINGS_WRITE_BACK
+extern SettingsWriteBack settingsWriteBack;
+#endif // if FEATURE_SETTINGS_WRITE_BACK
+
+#endif // GLOBALS_SETTINGSWRITEBACK_H
@@ -0,0 +1,207 @@
+#include "../Helpers/ArgumentTokenizer.h"
+
+#include "../Helpers/StringConverter.h"
+
+
+const ArgumentTokenizer *ArgumentTokenizer::_active = nullptr;
+
+
+ArgumentTokenizer::ArgumentTokenizer(const char *line, char separator)
+  : _line(line), _separator(separator)
+{
+  tokenize(0);
+}
+
+ArgumentTokenizer::ArgumentTokenizer(const char *line, char separator, unsigned int stopAtArgc)
+  : _line(line), _separator(separator)
+{
+  tokenize(stopAtArgc);
+}
+
+bool ArgumentTokenizer::getBeginEnd(unsigned int argc, int& pos_begin, int& pos_end) const
+{
+  pos_begin = -1;
+  pos_end   = -1;
+
+  if (!hasArgument(argc)) {
+    return false;
+  }
+
+  if (argc > _nrStored) {
+    return findArgument(_line, argc, pos_begin, pos_end, _separator);
+  }
+  pos_begin = _begin[argc - 1];
+  pos_end   = _end[argc - 1];
+  return true;
+}
+
+bool ArgumentTokenizer::getBeginEndToEnd(unsigned int argc, int& pos_begin, int& pos_end) const
+{
+  // Loop over the arguments to find the first and last pos of the arguments.
+  pos_begin = _length;
+  pos_end   = pos_begin;
+  bool hasArgument = false;
+
+  for (; argc <= _nrArguments; ++argc) {
+    int tmppos_begin, tmppos_end;
+
+    if (!getBeginEnd(argc, tmppos_begin, tmppos_end)) {
+      break;
+    }
+    hasArgument = true;
+
+    if ((tmppos_begin < pos_begin) && (tmppos_begin >= 0)) {
+      pos_begin = tmppos_begin;
+    }
+
+    if (tmppos_end >= 0) {
+      pos_end = tmppos_end;
+    }
+  }
+
+  return hasArgument && (pos_begin >= 0) && (pos_begin != pos_end);
+}
+
+bool ArgumentTokenizer::getArgv(unsigned int argc, String& argvString) const
+{
+  int  pos_begin, pos_end;
+  bool hasArgument = getBeginEnd(argc, pos_begin, pos_end);
+
+  argvString = String();
+
+  if (!hasArgument) { return false; }
+
+  if ((pos_begin >= 0) && (pos_end >= 0) && (pos_end > pos_begin)) {
+    argvString.reserve(pos_end - pos_begin);
+    argvString.concat(_line + pos_begin, pos_end - pos_begin);
+    argvString.trim();
+    argvString = stripQuotes(argvString);
+  }
+  return true;
+}
+
+bool ArgumentTokenizer::findArgument(const char *line, unsigned int argc, int& pos_begin, int& pos_end, char separator)
+{
+  if (argc == 0) {
+    pos_begin = -1;
+    pos_end   = -1;
+    return false;
+  }
+  ArgumentTokenizer tokenizer(line, separator, argc);
+
+  pos_begin = tokenizer._lastBegin;
+  pos_end   = tokenizer._lastEnd;
+  return tokenizer._nrArguments == argc;
+}
+
+ArgumentTokenizer::ActiveScope::ActiveScope(const ArgumentTokenizer& tokenizer)
+  : _previous(ArgumentTokenizer::_active)
+{
+  ArgumentTokenizer::_active = &tokenizer;
+}
+
+ArgumentTokenizer::ActiveScope::~ActiveScope()
+{
+  ArgumentTokenizer::_active = _previous;
+}
+
+const ArgumentTokenizer * ArgumentTokenizer::getActive(const char *line, char separator)
+{
+  if ((_active != nullptr) && (_active->_line == line) && (_active->_separator == separator)) {
+    return _active;
+  }
+  return nullptr;
+}
+
+void ArgumentTokenizer::tokenize(unsigned int stopAtArgc)
+{
+  if (_line == nullptr) {
+    return;
+  }
+  _length = strlen(_line);
+
+  // Positions are stored as int16_t
+  const bool canStore = _length < INT16_MAX;
+
+  size_t string_pos         = 0;
+  int    pos_begin          = -1;
+  int    pos_end            = -1;
+  bool   parenthesis        = false;
+  char   matching_parenthesis = '"';
+
+  while (string_pos < _length)
+  {
+    char c, d, e; // c = current char, d,e = next char (if available)
+    c = _line[string_pos];
+    d = 0;
+    e = 0;
+
+    if ((string_pos + 1) < _length) {
+      d = _line[string_pos + 1];
+    }
+
+    if ((string_pos + 2) < _length) {
+      e = _line[string_pos + 2];
+    }
+
+    if  (!parenthesis && (((c == ' ') && (d == ' ')) ||
+                          ((c == _separator) && (d == ' ')))) {
+      // Consider multiple consequitive spaces as one.
+    }
+    else if  (!parenthesis && ((d == ' ') && (e == _separator))) {
+      // Skip the space.
+    }
+    else
+    {
+      // Found the start of the new argument.
+      if ((pos_begin == -1) && !parenthesis && !((c == _separator) || isParameterSeparatorChar(c))) {
+        pos_begin = string_pos;
+        pos_end   = string_pos;
+      }
+
+      if (pos_end != -1) {
+        ++pos_end;
+      }
+
+      // Check if we're in a set of parenthesis (any quote char or [])
+      if (!parenthesis && (isQuoteChar(c) || (c == '['))) {
+        parenthesis          = true;
+        matching_parenthesis = c;
+
+        if (c == '[') {
+          matching_parenthesis = ']';
+        }
+      } else if (parenthesis && (c == matching_parenthesis)) {
+        parenthesis = false;
+      }
+
+      if (!parenthesis && (isParameterSeparatorChar(d) || (d == _separator) || (d == 0))) // end of word
+      {
+        if (canStore && (_nrStored < ARGUMENT_TOKENIZER_MAX_ARGS)) {
+          _begin[_nrStored] = pos_begin;
+          _end[_nrStored]   = pos_end;
+          ++_nrStored;
+        }
+        ++_nrArguments;
+        _lastBegin = pos_begin;
+        _lastEnd   = pos_end;
+
+        if (_nrArguments == stopAtArgc)
+        {
+          return;
+        }
+
+        // new Argument separator found
+        pos_begin = -1;
+        pos_end   = -1;
+      }
+    }
+    string_pos++;
+  }
+
+  if (stopAtArgc != 0) {
+    // Requested argument not found
+    _lastBegin = -1;
+    _lastEnd   = -1;
+  }
+}
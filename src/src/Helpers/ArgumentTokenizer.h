@@ -0,0 +1,117 @@
+#ifndef HELPERS_ARGUMENTTOKENIZER_H
+#define HELPERS_ARGUMENTTOKENIZER_H
+
+#include "../../ESPEasy_common.h"
+
+// Max. number of argument positions kept per tokenized line.
+// Arguments beyond this are still counted, but their position is looked up by scanning the line again.
+#ifndef ARGUMENT_TOKENIZER_MAX_ARGS
+# define ARGUMENT_TOKENIZER_MAX_ARGS  16
+#endif // ifndef ARGUMENT_TOKENIZER_MAX_ARGS
+
+
+/*********************************************************************************************\
+   Single pass tokenizer for command lines and parameter lists, like: cmd,arg1,'arg 2',[var#name]
+   Only the begin and end position of each argument is stored, as offset into the original line.
+   The line must remain valid and unchanged during the lifetime of the tokenizer.
+
+   Argument index is 1-based (1 = command), just like GetArgv() and parseString().
+\*********************************************************************************************/
+class ArgumentTokenizer {
+public:
+
+  explicit ArgumentTokenizer(const char *line,
+                             char        separator = ',');
+
+  // Do not allow to tokenize a temporary string
+  ArgumentTokenizer(String&& line,
+                    char     separator = ',') = delete;
+
+  ArgumentTokenizer(const ArgumentTokenizer& other)            = delete;
+  ArgumentTokenizer& operator=(const ArgumentTokenizer& other) = delete;
+
+  // Nr of arguments, including the command
+  unsigned int nrArguments() const {
+    return _nrArguments;
+  }
+
+  // Same as HasArgv()
+  bool hasArgument(unsigned int argc) const {
+    return argc != 0 && argc <= _nrArguments;
+  }
+
+  // Same as GetArgvBeginEnd()
+  bool getBeginEnd(unsigned int argc,
+                   int        & pos_begin,
+                   int        & pos_end) const;
+
+  // Positions of all arguments starting at argc, as used by parseStringToEnd()
+  bool getBeginEndToEnd(unsigned int argc,
+                        int        & pos_begin,
+                        int        & pos_end) const;
+
+  // Same as GetArgv()
+  bool getArgv(unsigned int argc,
+               String     & argvString) const;
+
+  const char* c_str() const {
+    return _line;
+  }
+
+  char separator() const {
+    return _separator;
+  }
+
+  // Scan the line only up to the requested argument.
+  static bool findArgument(const char  *line,
+                           unsigned int argc,
+                           int        & pos_begin,
+                           int        & pos_end,
+                           char         separator);
+
+  // While a command is being executed, its tokenized command line can be made active.
+  // GetArgv(), parseString() etc. called on the same line will then use the stored positions,
+  // instead of parsing the line again for every argument.
+  class ActiveScope {
+public:
+
+    explicit ActiveScope(const ArgumentTokenizer& tokenizer);
+    ~ActiveScope();
+
+private:
+
+    const ArgumentTokenizer *_previous;
+  };
+
+  // Return the active tokenizer for this line, or nullptr when not available.
+  static const ArgumentTokenizer* getActive(const char *line,
+                                            char        separator);
+
+private:
+
+  ArgumentTokenizer(const char  *line,
+                    char         separator,
+                    unsigned int stopAtArgc);
+
+  // Scan the line, stop when argument stopAtArgc is found (0 = scan the entire line)
+  void tokenize(unsigned int stopAtArgc);
+
+  const char *_line;
+  size_t      _length = 0;
+
+  int16_t _begin[ARGUMENT_TOKENIZER_MAX_ARGS]{};
+  int16_t _end[ARGUMENT_TOKENIZER_MAX_ARGS]{};
+
+  // Position of the last found argument, used when stopping at a specific argument.
+  int _lastBegin = -1;
+  int _lastEnd   = -1;
+
+  uint16_t _nrArguments = 0;
+  uint16_t _nrStored    = 0;
+  char     _separator;
+
+  static const ArgumentTokenizer *_active;
+};
+
+
+#endif // ifndef HELPERS_ARGUMENTTOKENIZER_H
@@ -57,6 +57,16 @@ uint32_t calc_CRC32(const uint8_t *data, size_t length) {
   return crc;
 }
 
+uint32_t calc_FNV1a_32(const uint8_t *data, size_t length, uint32_t hash) {
+  if (data != nullptr) {
+    while (length--) {
+      hash ^= *data++;
+      hash *= 0x01000193u;
+    }
+  }
+  return hash;
+}
+
 uint8_t calc_CRC8(const uint8_t *data, size_t length)
 {
   /*
@@ -11,6 +11,14 @@ int IRAM_ATTR calc_CRC16(const char *ptr,
 uint32_t      calc_CRC32(const uint8_t *data,
                          size_t         length);
 
+// Fast non-cryptographic hash (FNV-1a), to be used for lookup tables.
+// Can be chained by passing the result of a previous call as 'hash'.
+#define FNV1A_32_INIT 0x811c9dc5u
+
+uint32_t      calc_FNV1a_32(const uint8_t *data,
+                            size_t         length,
+                            uint32_t       hash = FNV1A_32_INIT);
+
 uint8_t       calc_CRC8(const uint8_t *data,
                         size_t         length);
 
@@ -0,0 +1,403 @@
+#include "../Helpers/CompiledTemplate.h"
+
+#include "../DataStructs/TimingStats.h"
+
+#include "../ESPEasyCore/ESPEasyRules.h"
+
+#include "../Globals/Cache.h"
+#include "../Globals/ExtraTaskSettings.h"
+#include "../Globals/Plugins_other.h"
+#include "../Globals/Settings.h"
+
+#include "../Helpers/ESPEasy_Storage.h"
+#include "../Helpers/Numerical.h"
+#include "../Helpers/StringConverter.h"
+#include "../Helpers/StringParser.h"
+#include "../Helpers/SystemVariables.h"
+
+
+namespace {
+// Return the system variable matching exactly the name in str[start ... end)
+SystemVariables::Enum matchSystemVariable(const String& str, int start, int end)
+{
+  if ((start >= end) || (end > static_cast<int>(str.length()))) {
+    return SystemVariables::Enum::UNKNOWN;
+  }
+  const size_t length = end - start;
+
+  for (int i = SystemVariables::startIndex_beginWith(str[start]); i < SystemVariables::Enum::UNKNOWN; ++i) {
+    const SystemVariables::Enum enumval = static_cast<SystemVariables::Enum>(i);
+
+    switch (enumval) {
+      case SystemVariables::Enum::SUNRISE:
+      case SystemVariables::Enum::SUNSET:
+      case SystemVariables::Enum::VARIABLE:
+        // These need arguments, compiled templates do not support these.
+        break;
+      default:
+      {
+        const char *name = reinterpret_cast<const char *>(SystemVariables::toFlashString(enumval));
+
+        if ((strlen_P(name) == length) && (strncmp_P(str.c_str() + start, name, length) == 0)) {
+          return enumval;
+        }
+        break;
+      }
+    }
+  }
+  return SystemVariables::Enum::UNKNOWN;
+}
+
+// Characters which may change the meaning of the template when present in a system variable value.
+bool containsTemplateMarkup(const String& value)
+{
+  for (size_t i = 0; i < value.length(); ++i) {
+    switch (value[i]) {
+      case '%':
+      case '[':
+      case ']':
+      case '#':
+        return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
+
+CompiledTemplate::CompiledTemplate(const String& tmpString, bool useURLencode)
+{
+  set(tmpString, useURLencode);
+}
+
+void CompiledTemplate::set(const String& tmpString, bool useURLencode)
+{
+  if ((_useURLencode == useURLencode) && _source.equals(tmpString)) {
+    return;
+  }
+  clear();
+  _source       = tmpString;
+  _useURLencode = useURLencode;
+}
+
+void CompiledTemplate::clear()
+{
+  _source     = String();
+  _parsedText = String();
+  _segments.clear();
+  _renderedLength     = 0;
+  _compileAttempted   = false;
+  _isCompiled         = false;
+  _hasSystemVariables = false;
+}
+
+bool CompiledTemplate::isCompiled()
+{
+  if (!_compileAttempted || (_settingsGeneration != Cache.settingsGeneration)) {
+    compile();
+  }
+  return _isCompiled;
+}
+
+void CompiledTemplate::compile()
+{
+  START_TIMER;
+  _segments.clear();
+  _parsedText         = String();
+  _compileAttempted   = true;
+  _isCompiled         = false;
+  _hasSystemVariables = false;
+  _settingsGeneration = Cache.settingsGeneration;
+
+  if (_source.length() >= UINT16_MAX) {
+    STOP_TIMER(COMPILE_TEMPLATE);
+    return;
+  }
+
+  {
+    String text(_source);
+    parseSpecialCharacters(text, _useURLencode);
+
+    if (!text.equals(_source)) {
+      _parsedText = std::move(text);
+    }
+  }
+  const String& str = parsedText();
+
+  // %sunrise-1h%, %sunset+10m% and %vN% are computed using the arguments, so not supported.
+  if ((str.indexOf(F("%sunrise")) != -1) || (str.indexOf(F("%sunset")) != -1)) {
+    STOP_TIMER(COMPILE_TEMPLATE);
+    return;
+  }
+
+  for (int v_index = str.indexOf(F("%v")); v_index != -1; v_index = str.indexOf(F("%v"), v_index + 1)) {
+    // Same check as in parse_pct_v_num_pct() to exclude %valname% or %value%
+    if (!isalpha(str.charAt(v_index + 2))) {
+      STOP_TIMER(COMPILE_TEMPLATE);
+      return;
+    }
+  }
+
+  // Keep current loaded taskSettings to restore at the end.
+  const taskIndex_t currentTaskIndex = ExtraTaskSettings.TaskIndex;
+  bool canCompile                    = true;
+  bool rightJustify                  = false;
+
+  int startpos     = 0;
+  int lastStartpos = 0;
+  int endpos       = 0;
+  {
+    String deviceName, valueName, format;
+
+    while (canCompile && findNextDevValNameInString(str, startpos, endpos, deviceName, valueName, format)) {
+      if (str.substring(startpos, endpos).indexOf('%') != -1) {
+        // Reference contains a system variable, which may be resolved to a different reference.
+        canCompile = false;
+        break;
+      }
+      if (!addLiteral(lastStartpos, startpos)) {
+        canCompile = false;
+        break;
+      }
+
+      // Format is stored as offset in the text
+      int format_offset = str.indexOf('#', str.indexOf('#', startpos) + 1);
+
+      if ((format_offset == -1) || (format_offset > endpos)) {
+        format_offset = endpos;
+      } else {
+        ++format_offset;
+      }
+      const int format_length = endpos - format_offset;
+
+      if (format.indexOf('R') != -1) {
+        rightJustify = true;
+      }
+
+      // deviceName is lower case, so we can compare literal string (no need for equalsIgnoreCase)
+      const bool devNameEqInt = equals(deviceName, F("int"));
+
+      if (devNameEqInt || equals(deviceName, F("var")))
+      {
+        uint32_t varNum;
+
+        if (validUIntFromString(valueName, varNum)) {
+          addSegment(
+            devNameEqInt ? SegmentType::CustomIntVar : SegmentType::CustomVar,
+            format_offset, format_length,
+            varNum);
+        }
+      }
+      else if (equals(deviceName, F("plugin")) || valueName.startsWith(F("settings.")))
+      {
+        // Plugin requests and task settings are not supported
+        canCompile = false;
+      }
+      else
+      {
+        const taskIndex_t taskIndex = findTaskIndexByName(deviceName, true); // Check for enabled/disabled is done when rendering
+
+        if (validTaskIndex(taskIndex)) {
+          const uint8_t valueNr = findDeviceValueIndexByName(valueName, taskIndex);
+
+          if (valueNr == VARS_PER_TASK) {
+            // Would call PLUGIN_GET_CONFIG_VALUE
+            canCompile = false;
+          } else {
+            addSegment(SegmentType::TaskValue, format_offset, format_length, taskIndex, valueNr);
+          }
+        }
+      }
+
+      lastStartpos = endpos + 1;
+      startpos     = endpos + 1;
+    }
+  }
+
+  if (canCompile) {
+    canCompile = addLiteral(lastStartpos, str.length());
+
+    // Right justify uses the length of the template after replacing system variables.
+    if (_hasSystemVariables && rightJustify) {
+      canCompile = false;
+    }
+  }
+
+  _isCompiled = canCompile;
+
+  if (!_isCompiled) {
+    _segments.clear();
+  }
+
+  // Restore previous loaded taskSettings
+  if (validTaskIndex(currentTaskIndex))
+  {
+    LoadTaskSettings(currentTaskIndex);
+  }
+  STOP_TIMER(COMPILE_TEMPLATE);
+}
+
+bool CompiledTemplate::addLiteral(int start, int end)
+{
+  const String& str = parsedText();
+  int literalStart  = start;
+  int percent_pos   = str.indexOf('%', start);
+
+  while (percent_pos != -1 && percent_pos < end) {
+    const int closing_pos = str.indexOf('%', percent_pos + 1);
+
+    if ((closing_pos == -1) || (closing_pos >= end)) {
+      break;
+    }
+    const SystemVariables::Enum enumval = matchSystemVariable(str, percent_pos + 1, closing_pos);
+
+    if (enumval == SystemVariables::Enum::UNKNOWN) {
+      // Continue with the next '%', which may be the start of a system variable
+      percent_pos = closing_pos;
+    } else {
+      // Overlapping system variables like %ip%sysname% depend on the replacement order.
+      const int next_pos = str.indexOf('%', closing_pos + 1);
+
+      if ((next_pos != -1) &&
+          (matchSystemVariable(str, closing_pos + 1, next_pos) != SystemVariables::Enum::UNKNOWN)) {
+        return false;
+      }
+      addSegment(SegmentType::Literal,        literalStart, percent_pos - literalStart);
+      addSegment(SegmentType::SystemVariable, percent_pos,  closing_pos + 1 - percent_pos, enumval);
+      _hasSystemVariables = true;
+      literalStart        = closing_pos + 1;
+      percent_pos         = str.indexOf('%', literalStart);
+    }
+  }
+  addSegment(SegmentType::Literal, literalStart, end - literalStart);
+  return true;
+}
+
+void CompiledTemplate::addSegment(SegmentType type, int offset, int length, uint32_t index, uint8_t valueNr)
+{
+  if ((type == SegmentType::Literal) && (length <= 0)) {
+    return;
+  }
+  Segment segment;
+
+  segment.offset  = offset;
+  segment.length  = length;
+  segment.index   = index;
+  segment.valueNr = valueNr;
+  segment.type    = type;
+  _segments.push_back(segment);
+}
+
+String CompiledTemplate::render(uint8_t minimal_lineSize)
+{
+  if ((parseTemplate_CallBack_ptr != nullptr) || !isCompiled()) {
+    return render_fallback(minimal_lineSize);
+  }
+  #ifndef BUILD_NO_RAM_TRACKER
+  checkRAM(F("CompiledTemplate::render"));
+  #endif // ifndef BUILD_NO_RAM_TRACKER
+  START_TIMER;
+
+  // Keep current loaded taskSettings to restore at the end.
+  const taskIndex_t currentTaskIndex = ExtraTaskSettings.TaskIndex;
+  const String    & text             = parsedText();
+  String newString;
+
+  newString.reserve(std::max(static_cast<uint16_t>(minimal_lineSize), _renderedLength));
+
+  for (const Segment& segment : _segments) {
+    switch (segment.type) {
+      case SegmentType::Literal:
+        newString.concat(text.c_str() + segment.offset, segment.length);
+        break;
+      case SegmentType::SystemVariable:
+      {
+        const String value = SystemVariables::getSystemVariable(static_cast<SystemVariables::Enum>(segment.index));
+
+        if (containsTemplateMarkup(value)) {
+          // Value must be parsed as part of the template
+          if (validTaskIndex(currentTaskIndex)) {
+            LoadTaskSettings(currentTaskIndex);
+          }
+          STOP_TIMER(RENDER_TEMPLATE);
+          return render_fallback(minimal_lineSize);
+        }
+
+        if (_useURLencode) {
+          newString += URLEncode(value);
+        } else {
+          newString += value;
+        }
+        break;
+      }
+      case SegmentType::TaskValue:
+      {
+        if (Settings.TaskDeviceEnabled[segment.index]) {
+          String format = text.substring(segment.offset, segment.offset + segment.length);
+          transformTaskValue(newString, minimal_lineSize, segment.index, segment.valueNr, format, text);
+        }
+        break;
+      }
+      case SegmentType::CustomVar:
+      case SegmentType::CustomIntVar:
+      {
+        String format = text.substring(segment.offset, segment.offset + segment.length);
+        transformCustomVarValue(
+          newString,
+          minimal_lineSize,
+          segment.index,
+          segment.type == SegmentType::CustomIntVar,
+          format,
+          text);
+        break;
+      }
+    }
+  }
+
+  // Restore previous loaded taskSettings
+  if (validTaskIndex(currentTaskIndex))
+  {
+    LoadTaskSettings(currentTaskIndex);
+  }
+
+  parseStandardConversions(newString, _useURLencode);
+
+  // process other markups as well
+  parse_string_commands(newString);
+
+  // padding spaces
+  while (newString.length() < minimal_lineSize) {
+    newString += ' ';
+  }
+
+  _renderedLength = newString.length() < UINT16_MAX ? newString.length() : UINT16_MAX;
+
+  STOP_TIMER(RENDER_TEMPLATE);
+  return newString;
+}
+
+String CompiledTemplate::render_fallback(uint8_t minimal_lineSize) const
+{
+  String tmpString(_source);
+
+  return parseTemplate_padded(tmpString, minimal_lineSize, _useURLencode);
+}
+
+String parseTemplate_cached(const String& tmpString, bool useURLencode)
+{
+  static CompiledTemplate templates[COMPILED_TEMPLATE_CACHE_SIZE];
+  static uint8_t nextIndex = 0;
+
+  for (size_t i = 0; i < COMPILED_TEMPLATE_CACHE_SIZE; ++i) {
+    if ((templates[i].useURLencode() == useURLencode) && templates[i].source().equals(tmpString)) {
+      return templates[i].render();
+    }
+  }
+
+  // Replace the oldest entry
+  CompiledTemplate& compiledTemplate = templates[nextIndex];
+
+  nextIndex = (nextIndex + 1) % COMPILED_TEMPLATE_CACHE_SIZE;
+  compiledTemplate.set(tmpString, useURLencode);
+  return compiledTemplate.render();
+}
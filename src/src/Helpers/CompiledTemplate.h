@@ -0,0 +1,130 @@
+#ifndef HELPERS_COMPILEDTEMPLATE_H
+#define HELPERS_COMPILEDTEMPLATE_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataTypes/TaskIndex.h"
+
+#include <vector>
+
+// Nr of templates kept by parseTemplate_cached()
+#ifndef COMPILED_TEMPLATE_CACHE_SIZE
+  # ifdef ESP32
+    #  define COMPILED_TEMPLATE_CACHE_SIZE  8
+  # else
+    #  define COMPILED_TEMPLATE_CACHE_SIZE  4
+  # endif // ifdef ESP32
+#endif // ifndef COMPILED_TEMPLATE_CACHE_SIZE
+
+
+/*********************************************************************************************\
+   Template string, parsed once into segments of literal text and resolved references:
+   - %sysvar%              System variables, like %sysname% or %systime%
+   - [taskname#valuename]  Task values, optionally followed by #format
+   - [var#N] or [int#N]    Custom variables
+
+   Rendering gives the same result as parseTemplate_padded(),
+   but task names, value names and system variable names are only looked up when compiling.
+   The template is compiled again when the settings generation (Cache.settingsGeneration) changes.
+
+   Templates which cannot be compiled, e.g. containing %v1%, %sunrise-1h%, [plugin#...] or
+   [taskname#configvalue], are parsed via parseTemplate_padded() on each render.
+\*********************************************************************************************/
+class CompiledTemplate {
+public:
+
+  CompiledTemplate() = default;
+
+  explicit CompiledTemplate(const String& tmpString,
+                            bool          useURLencode = false);
+
+  // Set the template string, will be compiled on first use.
+  void set(const String& tmpString,
+           bool          useURLencode = false);
+
+  void clear();
+
+  const String& source() const {
+    return _source;
+  }
+
+  bool useURLencode() const {
+    return _useURLencode;
+  }
+
+  // Return true when the template is compiled and up-to-date with the current settings.
+  // Compile the template when needed.
+  bool isCompiled();
+
+  // Same as parseTemplate_padded(source, minimal_lineSize, useURLencode)
+  String render(uint8_t minimal_lineSize = 0);
+
+private:
+
+  enum class SegmentType : uint8_t {
+    Literal,
+    SystemVariable,
+    TaskValue,
+    CustomVar,
+    CustomIntVar
+  };
+
+  struct Segment {
+    // Literal text or format, as offset in the parsed text
+    uint16_t offset = 0;
+    uint16_t length = 0;
+
+    // SystemVariables::Enum, taskIndex or custom variable index
+    uint32_t    index   = 0;
+    uint8_t     valueNr = 0;
+    SegmentType type    = SegmentType::Literal;
+  };
+
+  void          compile();
+
+  // Split literal text into literal and system variable segments
+  // Return false when the system variables cannot be resolved at compile time.
+  bool          addLiteral(int start,
+                           int end);
+
+  void          addSegment(SegmentType type,
+                           int         offset,
+                           int         length,
+                           uint32_t    index   = 0,
+                           uint8_t     valueNr = 0);
+
+  // Template after special characters have been replaced.
+  // Only stored when different from the source.
+  const String& parsedText() const {
+    return _parsedText.isEmpty() ? _source : _parsedText;
+  }
+
+  String render_fallback(uint8_t minimal_lineSize) const;
+
+  String               _source;
+  String               _parsedText;
+  std::vector<Segment> _segments;
+
+  uint32_t _settingsGeneration{};
+
+  // Length of the last rendered string, used to reserve memory.
+  uint16_t _renderedLength{};
+
+  bool _useURLencode{};
+
+  // Set when compile() was called for the current settings generation.
+  bool _compileAttempted{};
+
+  // Set when the segments can be used to render the template.
+  bool _isCompiled{};
+  bool _hasSystemVariables{};
+};
+
+
+// Same as parseTemplate(), using a small cache of compiled templates.
+// Meant for templates used over and over again, like controller topics and URLs.
+String parseTemplate_cached(const String& tmpString,
+                            bool          useURLencode);
+
+
+#endif // ifndef HELPERS_COMPILEDTEMPLATE_H
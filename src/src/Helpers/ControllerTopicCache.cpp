@@ -0,0 +1,214 @@
+#include "../Helpers/ControllerTopicCache.h"
+
+#include "../Globals/Cache.h"
+#include "../Globals/Settings.h"
+
+#include "../Helpers/Misc.h"
+#include "../Helpers/StringConverter.h"
+
+
+namespace {
+// Names containing these characters may change the meaning of the template
+// when replaced before the template is parsed.
+bool containsMarkup(const String& name)
+{
+  for (size_t i = 0; i < name.length(); ++i) {
+    switch (name[i]) {
+      case '%':
+      case '[':
+      case ']':
+      case '#':
+      case '{':
+      case '&':
+        return true;
+    }
+  }
+  return false;
+}
+
+bool canReplaceBeforeParsing(const String& name, bool useURLencode)
+{
+  if (containsMarkup(name)) {
+    return false;
+  }
+
+  // URL encoded characters start with '%'
+  return !useURLencode || URLEncode(name).equals(name);
+}
+
+// Check whether event variables can be replaced before parsing the template.
+bool templateIsCacheable(const String& topicTemplate)
+{
+  // %val1% ... %valN% are the task values, which change on every send.
+  for (int pos = topicTemplate.indexOf(F("%val")); pos != -1; pos = topicTemplate.indexOf(F("%val"), pos + 1)) {
+    if (isDigit(topicTemplate.charAt(pos + 4))) {
+      return false;
+    }
+  }
+
+  // Event variables inside a [taskname#valuename] reference are only replaced after the reference was parsed.
+  int open_pos = topicTemplate.indexOf('[');
+
+  while (open_pos != -1) {
+    const int close_pos = topicTemplate.indexOf(']', open_pos);
+
+    if (close_pos == -1) {
+      break;
+    }
+    const int percent_pos = topicTemplate.indexOf('%', open_pos);
+
+    if ((percent_pos != -1) && (percent_pos < close_pos)) {
+      return false;
+    }
+    open_pos = topicTemplate.indexOf('[', close_pos);
+  }
+  return true;
+}
+} // namespace
+
+
+void ControllerTopicCache::setTemplate(controllerIndex_t controllerIndex, const String& topicTemplate, bool useURLencode)
+{
+  TemplateSource& templateSource = _templates[controllerIndex];
+
+  if ((templateSource.useURLencode == useURLencode) && templateSource.source.equals(topicTemplate)) {
+    return;
+  }
+  clear(controllerIndex);
+  templateSource.source       = topicTemplate;
+  templateSource.useURLencode = useURLencode;
+}
+
+void ControllerTopicCache::fill(controllerIndex_t controllerIndex)
+{
+  if (!validControllerIndex(controllerIndex)) { return; }
+
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+    if (Settings.TaskDeviceEnabled[taskIndex] && Settings.TaskDeviceSendData[controllerIndex][taskIndex]) {
+      Entry *entry = getEntry(controllerIndex, taskIndex, Settings.TaskDeviceID[controllerIndex][taskIndex]);
+
+      if (entry != nullptr) {
+        // Compile now, not when sending the first value
+        for (auto it = entry->topics.begin(); it != entry->topics.end(); ++it) {
+          it->isCompiled();
+        }
+      }
+    }
+  }
+}
+
+void ControllerTopicCache::clear(controllerIndex_t controllerIndex)
+{
+  for (auto it = _entries.begin(); it != _entries.end();) {
+    if ((it->first >> 8) == controllerIndex) {
+      it = _entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ControllerTopicCache::clear()
+{
+  _entries.clear();
+  _templates.clear();
+}
+
+bool ControllerTopicCache::render(const struct EventStruct *event, uint8_t taskValueIndex, String& topic)
+{
+  if ((event == nullptr) || (taskValueIndex >= VARS_PER_TASK)) {
+    return false;
+  }
+  Entry *entry = getEntry(event->ControllerIndex, event->TaskIndex, event->idx);
+
+  if (entry == nullptr) {
+    return false;
+  }
+  topic = entry->topics[taskValueIndex].render();
+  return true;
+}
+
+ControllerTopicCache::Entry * ControllerTopicCache::getEntry(controllerIndex_t controllerIndex, taskIndex_t taskIndex, unsigned int idx)
+{
+  if (!validControllerIndex(controllerIndex) || !validTaskIndex(taskIndex)) {
+    return nullptr;
+  }
+
+  if (_templates.find(controllerIndex) == _templates.end()) {
+    return nullptr;
+  }
+
+  auto it = _entries.find(makeKey(controllerIndex, taskIndex));
+
+  if (it == _entries.end()) {
+    it = _entries.emplace(makeKey(controllerIndex, taskIndex), Entry()).first;
+    prepare(it->second, controllerIndex, taskIndex, idx);
+  } else if ((it->second.settingsGeneration != Cache.settingsGeneration) || (it->second.idx != idx)) {
+    // Task or value names may have changed
+    prepare(it->second, controllerIndex, taskIndex, idx);
+  }
+  return it->second.cacheable ? &(it->second) : nullptr;
+}
+
+void ControllerTopicCache::prepare(Entry& entry, controllerIndex_t controllerIndex, taskIndex_t taskIndex, unsigned int idx) const
+{
+  entry.settingsGeneration = Cache.settingsGeneration;
+  entry.idx                = idx;
+  entry.cacheable          = false;
+
+  auto templateSource = _templates.find(controllerIndex);
+
+  if ((templateSource == _templates.end()) || !templateIsCacheable(templateSource->second.source)) {
+    entry.topics.clear();
+    return;
+  }
+  const bool useURLencode = templateSource->second.useURLencode;
+
+  // Replace the event variables which do not depend on the task values.
+  String topic(templateSource->second.source);
+  {
+    const String taskName = getTaskDeviceName(taskIndex);
+
+    if (!canReplaceBeforeParsing(taskName, useURLencode)) {
+      entry.topics.clear();
+      return;
+    }
+    repl(F("%id%"),      String(idx), topic, useURLencode);
+    repl(F("%tskname%"), taskName,    topic, useURLencode);
+  }
+
+  String valueNames[VARS_PER_TASK];
+
+  for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
+    valueNames[i] = getTaskValueName(taskIndex, i);
+
+    if (!canReplaceBeforeParsing(valueNames[i], useURLencode)) {
+      entry.topics.clear();
+      return;
+    }
+  }
+
+  if (topic.indexOf(F("%vname")) != -1) {
+    for (uint8_t i = 0; i < 4 && i < VARS_PER_TASK; ++i) {
+      String vname = F("%vname");
+      vname += (i + 1);
+      vname += '%';
+      repl(vname, valueNames[i], topic, useURLencode);
+    }
+  }
+
+  entry.topics.resize(VARS_PER_TASK);
+
+  const bool has_valname = topic.indexOf(F("%valname%")) != -1;
+
+  for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
+    if (has_valname) {
+      String valueTopic(topic);
+      repl(F("%valname%"), valueNames[i], valueTopic, useURLencode);
+      entry.topics[i].set(valueTopic, useURLencode);
+    } else {
+      entry.topics[i].set(topic, useURLencode);
+    }
+  }
+  entry.cacheable = true;
+}
@@ -0,0 +1,86 @@
+#ifndef HELPERS_CONTROLLERTOPICCACHE_H
+#define HELPERS_CONTROLLERTOPICCACHE_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataStructs/ESPEasy_EventStruct.h"
+#include "../DataTypes/ControllerIndex.h"
+#include "../DataTypes/TaskIndex.h"
+#include "../Helpers/CompiledTemplate.h"
+
+#include <map>
+#include <vector>
+
+
+/*********************************************************************************************\
+   Compiled controller topic per (controller, task, task value).
+
+   Same result as:
+     parseControllerVariables(topic, event, useURLencode);
+     parseSingleControllerVariable(topic, event, taskValueIndex, useURLencode);
+
+   The event variables which only depend on the settings (%id%, %tskname%, %vnameN%, %valname%)
+   are replaced once and the result is kept as a CompiledTemplate.
+   Entries are prepared again when the settings generation (Cache.settingsGeneration) changes,
+   e.g. when a task or task value is renamed.
+
+   Topics which use %valN% or where a replaced name contains template markup
+   are not cached and must be parsed by the caller.
+\*********************************************************************************************/
+class ControllerTopicCache {
+public:
+
+  // Set the topic template for the controller.
+  // Clears the cached topics of this controller when the template changes.
+  void setTemplate(controllerIndex_t controllerIndex,
+                   const String    & topicTemplate,
+                   bool              useURLencode = false);
+
+  // Prepare and compile the topics for all enabled tasks sending to the controller.
+  void fill(controllerIndex_t controllerIndex);
+
+  void clear(controllerIndex_t controllerIndex);
+
+  void clear();
+
+  // Render the topic of a task value into 'topic'.
+  // Return false when the topic cannot be cached, 'topic' is then left untouched.
+  bool render(const struct EventStruct *event,
+              uint8_t                   taskValueIndex,
+              String                  & topic);
+
+private:
+
+  struct Entry {
+    std::vector<CompiledTemplate> topics;
+    uint32_t                      settingsGeneration{};
+    unsigned int                  idx{};
+    bool                          cacheable{};
+  };
+
+  static uint16_t makeKey(controllerIndex_t controllerIndex,
+                          taskIndex_t       taskIndex) {
+    return (static_cast<uint16_t>(controllerIndex) << 8) | taskIndex;
+  }
+
+  // Return the up-to-date entry, or nullptr when not cacheable.
+  Entry* getEntry(controllerIndex_t controllerIndex,
+                  taskIndex_t       taskIndex,
+                  unsigned int      idx);
+
+  void   prepare(Entry           & entry,
+                 controllerIndex_t controllerIndex,
+                 taskIndex_t       taskIndex,
+                 unsigned int      idx) const;
+
+  struct TemplateSource {
+    String source;
+    bool   useURLencode{};
+  };
+
+  std::map<controllerIndex_t, TemplateSource>_templates;
+  std::map<uint16_t, Entry>                  _entries;
+};
+
+
+#endif // ifndef HELPERS_CONTROLLERTOPICCACHE_H
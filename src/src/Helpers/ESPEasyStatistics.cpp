@@ -3,6 +3,7 @@
 
 #if FEATURE_TIMING_STATS
 
+#include "../DataStructs/SchedulerTimerStats.h"
 #include "../DataStructs/TimingStats.h"
 #include "../WebServer/ESPEasy_WebServer.h"
 #include "../Helpers/Convert.h"
@@ -131,10 +132,48 @@ void jsonStatistics(bool clearStats) {
 
   json_close(true);   // Close misc list
 
+
+  json_open(true, F("scheduler"));
+  for (auto& x: schedulerTimerStats) {
+    if (x.second.getCount() != 0) {
+      json_open(); // open new scheduler timer item
+      json_prop(F("name"), getSchedulerTimerStatsName(x.first));
+      json_prop(F("id"),   String(x.first));
+      json_open(false, F("lateness"));
+      {
+        json_number(F("count"), String(x.second.getCount()));
+        json_number(F("max"),   String(x.second.getLatenessMax()));
+        json_number(F("avg"),   toString(x.second.getLatenessAvg(), 2));
+        json_prop(F("unit"), F("msec"));
+
+        // Histogram, bucket upper bound (inclusive) and nr of timers in that bucket
+        json_open(true, F("histogram"));
+        for (uint8_t bucket = 0; bucket < SCHEDULER_LATENESS_NR_BUCKETS; ++bucket) {
+          const uint32_t upperBound = SchedulerTimerStats::getBucketUpperBound(bucket);
+          json_open();
+          json_prop(F("le"), upperBound == UINT32_MAX ? String(F("+Inf")) : String(upperBound));
+          json_number(F("count"), String(x.second.getBucketCount(bucket)));
+          json_close();
+        }
+        json_close(true);
+      }
+      json_close(false);
+      json_open(false, F("exec"));
+      {
+        stream_json_timing_stats(x.second.getExecStats(), timeSinceLastReset);
+      }
+      json_close(false);
+      json_close();     // close scheduler timer item
+    }
+  }
+
+  json_close(true);   // Close scheduler list
+
   if (clearStats) {
     pluginStats.clear();
     controllerStats.clear();
     miscStats.clear();
+    schedulerTimerStats.clear();
     timingstats_last_reset = millis();
   }
 }
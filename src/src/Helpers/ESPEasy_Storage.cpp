@@ -34,6 +34,7 @@
 #include "../Globals/RuntimeData.h"
 #include "../Globals/SecuritySettings.h"
 #include "../Globals/Settings.h"
+#include "../Globals/SettingsWriteBack.h"
 #include "../Globals/WiFi_AP_Candidates.h"
 
 #include "../Helpers/ESPEasyRTC.h"
@@ -93,13 +94,18 @@ void flashCount()
   saveToRTC();
 }
 
+bool flashWriteLimitExceeded()
+{
+  return RTC.flashDayCounter > MAX_FLASHWRITES_PER_DAY;
+}
+
 String flashGuard()
 {
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("flashGuard"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
 
-  if (RTC.flashDayCounter > MAX_FLASHWRITES_PER_DAY)
+  if (flashWriteLimitExceeded())
   {
     String log = F("FS   : Daily flash write rate exceeded! (powercycle or send command 'resetFlashWriteCounter' to reset this)");
     addLog(LOG_LEVEL_ERROR, log);
@@ -175,7 +181,28 @@ bool fileExists(const String& fname) {
   return res;
 }
 
+namespace {
+fs::File doTryOpenFile(const String& fname, const String& mode, FileDestination_e destination = FileDestination_e::ANY);
+} // namespace
+
 fs::File tryOpenFile(const String& fname, const String& mode, FileDestination_e destination) {
+  #if FEATURE_SETTINGS_WRITE_BACK
+
+  if (settingsWriteBack.isPending(fname)) {
+    // Any other access to the file must see the saved settings.
+    if (mode.startsWith(F("w"))) {
+      // File will be truncated
+      settingsWriteBack.discard(fname);
+    } else {
+      settingsWriteBack.flush(fname);
+    }
+  }
+  #endif // if FEATURE_SETTINGS_WRITE_BACK
+  return doTryOpenFile(fname, mode, destination);
+}
+
+namespace {
+fs::File doTryOpenFile(const String& fname, const String& mode, FileDestination_e destination) {
   START_TIMER;
   fs::File f;
 
@@ -206,6 +233,7 @@ fs::File tryOpenFile(const String& fname, const String& mode, FileDestination_e
   STOP_TIMER(TRY_OPEN_FILE);
   return f;
 }
+} // namespace
 
 bool fileMatchesTaskSettingsType(const String& fname) {
   const String config_dat_file = patch_fname(getFileName(FileType::CONFIG_DAT));
@@ -215,6 +243,9 @@ bool fileMatchesTaskSettingsType(const String& fname) {
 
 bool tryRenameFile(const String& fname_old, const String& fname_new, FileDestination_e destination) {
   clearFileCaches();
+  #if FEATURE_SETTINGS_WRITE_BACK
+  settingsWriteBack.flush(fname_old);
+  #endif // if FEATURE_SETTINGS_WRITE_BACK
 
   if (fileExists(fname_old) && !fileExists(fname_new)) {
     if (fileMatchesTaskSettingsType(fname_old)) {
@@ -247,6 +278,9 @@ bool tryDeleteFile(const String& fname, FileDestination_e destination) {
       ControllerCache.closeOpenFiles();
     }
     #endif // if FEATURE_RTC_CACHE_STORAGE
+    #if FEATURE_SETTINGS_WRITE_BACK
+    settingsWriteBack.discard(fname);
+    #endif // if FEATURE_SETTINGS_WRITE_BACK
 
     if (fileMatchesTaskSettingsType(fname)) {
       clearAllCaches();
@@ -1182,6 +1216,9 @@ String SaveTaskSettings(taskIndex_t TaskIndex)
     // ExtraTaskSettings cache. This may prevent a reload.
     Cache.updateExtraTaskSettingsCache_afterLoad_Save();
 
+    // Default value names are cleared, so the stored content differs from what LoadTaskSettings() returns.
+    Cache.extraTaskSettings_lru.erase(TaskIndex);
+
     err = SaveToFile(SettingsType::Enum::TaskSettings_Type,
                      TaskIndex,
                      reinterpret_cast<const uint8_t *>(&ExtraTaskSettings),
@@ -1234,6 +1271,18 @@ String LoadTaskSettings(taskIndex_t TaskIndex)
     //    Cache.updateExtraTaskSettingsCache_afterLoad_Save();
     return EMPTY_STRING;
   }
+  {
+    ChecksumType checksum;
+
+    if (Cache.extraTaskSettings_lru.get(TaskIndex, ExtraTaskSettings, checksum)) {
+      // Already patched and validated when it was loaded from file.
+      if (!Cache.matchChecksumExtraTaskSettings(TaskIndex, checksum)) {
+        Cache.updateExtraTaskSettingsCache_afterLoad_Save();
+      }
+      STOP_TIMER(LOAD_TASK_SETTINGS_CACHED);
+      return EMPTY_STRING;
+    }
+  }
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("LoadTaskSettings"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
@@ -1257,6 +1306,10 @@ String LoadTaskSettings(taskIndex_t TaskIndex)
 
   ExtraTaskSettings.validate();
   Cache.updateExtraTaskSettingsCache_afterLoad_Save();
+
+  if (result.isEmpty()) {
+    Cache.extraTaskSettings_lru.put(ExtraTaskSettings, ExtraTaskSettings.computeChecksum());
+  }
   STOP_TIMER(LOAD_TASK_SETTINGS);
 
   return result;
@@ -1593,6 +1646,13 @@ String InitFile(SettingsType::SettingsFileEnum file_type)
  \*********************************************************************************************/
 String SaveToFile(const char *fname, int index, const uint8_t *memAddress, int datasize)
 {
+  #if FEATURE_SETTINGS_WRITE_BACK
+
+  if (settingsWriteBack.add(fname, index, memAddress, datasize)) {
+    clearAllButTaskCaches();
+    return EMPTY_STRING;
+  }
+  #endif // if FEATURE_SETTINGS_WRITE_BACK
   return doSaveToFile(fname, index, memAddress, datasize, "r+");
 }
 
@@ -1601,6 +1661,104 @@ String SaveToFile_trunc(const char *fname, int index, const uint8_t *memAddress,
   return doSaveToFile(fname, index, memAddress, datasize, "w+");
 }
 
+namespace {
+uint32_t saveToFile_pagesWritten = 0;
+uint32_t saveToFile_pagesSkipped = 0;
+} // namespace
+
+size_t getSaveToFilePageSize()
+{
+  const size_t pageSize = SpiffsPagesize();
+
+  if (pageSize < SAVE_TO_FILE_MIN_PAGE_SIZE) { return SAVE_TO_FILE_MIN_PAGE_SIZE; }
+
+  if (pageSize > SAVE_TO_FILE_MAX_PAGE_SIZE) { return SAVE_TO_FILE_MAX_PAGE_SIZE; }
+  return pageSize;
+}
+
+uint32_t getSaveToFilePagesWritten()
+{
+  return saveToFile_pagesWritten;
+}
+
+uint32_t getSaveToFilePagesSkipped()
+{
+  return saveToFile_pagesSkipped;
+}
+
+String writeChangedPages(fs::File& f, const char *fname, int index, const uint8_t *memAddress, int datasize, bool compareWithFile)
+{
+  SPIFFS_CHECK(f.seek(index, fs::SeekSet), fname);
+
+  // Data is staged per file system page, so the file system gets complete page writes.
+  // Also avoids writing directly from memAddress.
+  // See https://github.com/esp8266/Arduino/commit/b1da9eda467cc935307d553692fdde2e670db258#r32622483
+  const size_t pageSize = getSaveToFilePageSize();
+  std::unique_ptr<uint8_t[]> pageBuffer(new (std::nothrow) uint8_t[2 * pageSize]);
+
+  if (!pageBuffer) {
+    #ifndef BUILD_NO_DEBUG
+    const String log = strformat(F("SaveToFile: %s ERROR, Not enough memory"), fname);
+    #else // ifndef BUILD_NO_DEBUG
+    const String log = F("Save error");
+    #endif // ifndef BUILD_NO_DEBUG
+    addLog(LOG_LEVEL_ERROR, log);
+    return log;
+  }
+  uint8_t *stagedData = pageBuffer.get();
+  uint8_t *fileData   = stagedData + pageSize;
+
+  const size_t fileSize     = compareWithFile ? f.size() : 0;
+  size_t       filePos      = index;
+  uint32_t     pagesWritten = 0;
+  uint32_t     pagesSkipped = 0;
+
+  for (int x = 0; x < datasize;)
+  {
+    // First chunk may be shorter, to align the next writes with the pages.
+    const size_t chunkSize = std::min(
+      pageSize - (filePos % pageSize),
+      static_cast<size_t>(datasize - x));
+    memcpy(stagedData, memAddress + x, chunkSize);
+
+    bool unchanged = false;
+
+    if ((filePos + chunkSize) <= fileSize) {
+      // Skip pages with the same content, to save on flash wear.
+      unchanged = (f.read(fileData, chunkSize) == chunkSize) &&
+                  (memcmp(stagedData, fileData, chunkSize) == 0);
+
+      if (!unchanged) {
+        SPIFFS_CHECK(f.seek(filePos, fs::SeekSet), fname);
+      }
+    }
+
+    if (unchanged) {
+      ++pagesSkipped;
+    } else {
+      SPIFFS_CHECK(f.write(stagedData, chunkSize) == chunkSize, fname);
+      ++pagesWritten;
+    }
+    filePos += chunkSize;
+    x       += chunkSize;
+
+    // one page done, do some background tasks
+    delay(0);
+  }
+  saveToFile_pagesWritten += pagesWritten;
+  saveToFile_pagesSkipped += pagesSkipped;
+  #ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLogMove(LOG_LEVEL_INFO, strformat(F("FILE : Saved %s offset: %d size: %d pages written: %u unchanged: %u"),
+                                         fname, index, datasize,
+                                         static_cast<unsigned>(pagesWritten),
+                                         static_cast<unsigned>(pagesSkipped)));
+  }
+  #endif // ifndef BUILD_NO_DEBUG
+  return EMPTY_STRING;
+}
+
 // See for mode description: https://github.com/esp8266/Arduino/blob/master/doc/filesystem.rst
 String doSaveToFile(const char *fname, int index, const uint8_t *memAddress, int datasize, const char *mode)
 {
@@ -1637,40 +1795,18 @@ String doSaveToFile(const char *fname, int index, const uint8_t *memAddress, int
   }
   #endif // ifndef BUILD_NO_DEBUG
   delay(1);
-  unsigned long timer = millis() + 50;
-  fs::File f          = tryOpenFile(fname, mode);
+  fs::File f = tryOpenFile(fname, mode);
 
   if (f) {
     clearAllButTaskCaches();
     SPIFFS_CHECK(f,                          fname);
-    SPIFFS_CHECK(f.seek(index, fs::SeekSet), fname);
-    const uint8_t *pointerToByteToSave = memAddress;
-
-    for (int x = 0; x < datasize; x++)
-    {
-      // See https://github.com/esp8266/Arduino/commit/b1da9eda467cc935307d553692fdde2e670db258#r32622483
-      uint8_t byteToSave = *pointerToByteToSave;
-      SPIFFS_CHECK(f.write(&byteToSave, 1), fname);
-      pointerToByteToSave++;
-
-      if (x % 256 == 0) {
-        // one page written, do some background tasks
-        timer = millis() + 50;
-        delay(0);
-      }
-
-      if (timeOutReached(timer)) {
-        timer += 50;
-        delay(0);
-      }
-    }
+    // Only existing content can be compared, the "w" modes truncate the file.
+    const String err = writeChangedPages(f, fname, index, memAddress, datasize, mode[0] == 'r');
     f.close();
-    #ifndef BUILD_NO_DEBUG
 
-    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-      addLogMove(LOG_LEVEL_INFO, strformat(F("FILE : Saved %s offset: %d size: %d"), fname, index, datasize));
+    if (!err.isEmpty()) {
+      return err;
     }
-    #endif // ifndef BUILD_NO_DEBUG
   } else {
     #ifndef BUILD_NO_DEBUG
     const String log = strformat(F("SaveToFile: %s ERROR, Cannot save to file"), fname);
@@ -1760,9 +1896,13 @@ String LoadFromFile(const char *fname, int offset, uint8_t *memAddress, int data
   checkRAM(F("LoadFromFile"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
 
-  fs::File f = tryOpenFile(fname, "r");
+  // Do not write pending settings, but combine them with the file content.
+  fs::File f = doTryOpenFile(fname, "r");
   SPIFFS_CHECK(f, fname);
   const int fileSize = f.size();
+  #if FEATURE_SETTINGS_WRITE_BACK
+  const int memSize = datasize;
+  #endif // if FEATURE_SETTINGS_WRITE_BACK
 
   if (fileSize > offset) {
     SPIFFS_CHECK(f.seek(offset, fs::SeekSet), fname);
@@ -1778,6 +1918,9 @@ String LoadFromFile(const char *fname, int offset, uint8_t *memAddress, int data
     SPIFFS_CHECK(f.read(memAddress, datasize), fname);
   }
   f.close();
+  #if FEATURE_SETTINGS_WRITE_BACK
+  settingsWriteBack.applyPending(fname, offset, memAddress, memSize);
+  #endif // if FEATURE_SETTINGS_WRITE_BACK
 
   STOP_TIMER(LOADFILE_STATS);
   delay(0);
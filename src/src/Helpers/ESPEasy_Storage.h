@@ -27,6 +27,9 @@ String FileError(int line, const char *fname);
  \*********************************************************************************************/
 void flashCount();
 
+// Daily flash write limit reached, thus flashGuard() will return an error
+bool flashWriteLimitExceeded();
+
 String flashGuard();
 
 String appendLineToFile(const String& fname, const String& line);
@@ -289,6 +292,32 @@ String SaveToFile(const char *fname, int index, const uint8_t *memAddress, int d
 
 String SaveToFile_trunc(const char *fname, int index, const uint8_t *memAddress, int datasize);
 
+// Size of the chunks written by doSaveToFile(), based on SpiffsPagesize()
+#ifndef SAVE_TO_FILE_MIN_PAGE_SIZE
+# define SAVE_TO_FILE_MIN_PAGE_SIZE  64
+#endif // ifndef SAVE_TO_FILE_MIN_PAGE_SIZE
+#ifndef SAVE_TO_FILE_MAX_PAGE_SIZE
+# define SAVE_TO_FILE_MAX_PAGE_SIZE  1024
+#endif // ifndef SAVE_TO_FILE_MAX_PAGE_SIZE
+
+size_t   getSaveToFilePageSize();
+
+// Statistics of doSaveToFile()
+// Pages with the same content as the file are not written.
+uint32_t getSaveToFilePagesWritten();
+
+uint32_t getSaveToFilePagesSkipped();
+
+// Write data to the open file at position index, in page aligned chunks.
+// With compareWithFile set, pages with the same content as the file are not written.
+String writeChangedPages(fs::File  & f,
+                         const char    *fname,
+                         int            index,
+                         const uint8_t *memAddress,
+                         int            datasize,
+                         bool           compareWithFile);
+
+// Data is written in page aligned chunks, unchanged pages are skipped.
 // See for mode description: https://github.com/esp8266/Arduino/blob/master/doc/filesystem.rst
 String doSaveToFile(const char *fname, int index, const uint8_t *memAddress, int datasize, const char *mode);
 
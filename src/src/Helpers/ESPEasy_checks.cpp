@@ -98,17 +98,10 @@ void run_compiletime_checks() {
   #endif
 
 
-  // LogStruct is mainly dependent on the number of lines.
-  // Has to be round up to multiple of 4.
-  #if ESP_IDF_VERSION_MAJOR > 3
-  // String class has increased with 4 bytes
-  const unsigned int LogStructSize = ((13u + 24 * LOG_STRUCT_MESSAGE_LINES) + 3) & ~3;
-  #else
-  const unsigned int LogStructSize = ((13u + 20 * LOG_STRUCT_MESSAGE_LINES) + 3) & ~3;
-  #endif
-  check_size<LogStruct,                             LogStructSize>(); // Is not stored
+  // LogStruct only holds a pointer to the log buffer.
+  check_size<LogStruct,                             28u>(); // Is not stored
   check_size<DeviceStruct,                          9u>(); // Is not stored
-  check_size<ProtocolStruct,                        4u>();
+  check_size<ProtocolStruct,                        8u>(); // Is not stored
   #if FEATURE_NOTIFIER
   check_size<NotificationStruct,                    3u>();
   #endif // if FEATURE_NOTIFIER
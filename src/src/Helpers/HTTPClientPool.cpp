@@ -0,0 +1,129 @@
+#include "../Helpers/HTTPClientPool.h"
+
+#if FEATURE_HTTP_CLIENT
+
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/StringConverter.h"
+
+
+HTTPClientPool::Connection * HTTPClientPool::acquire(const String& host, uint16_t port, bool& reused)
+{
+  reused = false;
+  closeIdle();
+
+  Connection *connection = nullptr;
+
+  for (auto it = _connections.begin(); it != _connections.end() && connection == nullptr; ++it) {
+    if (!(*it)->inUse && ((*it)->port == port) && (*it)->host.equalsIgnoreCase(host)) {
+      connection = it->get();
+    }
+  }
+
+  if (connection == nullptr) {
+    if (_connections.size() >= HTTP_CLIENT_POOL_MAX_SOCKETS) {
+      // Make room by closing the least recently used idle connection.
+      size_t lru_index = _connections.size();
+
+      for (size_t i = 0; i < _connections.size(); ++i) {
+        if (!_connections[i]->inUse &&
+            ((lru_index == _connections.size()) ||
+             timeDiff(_connections[i]->lastUsed, _connections[lru_index]->lastUsed) > 0)) {
+          lru_index = i;
+        }
+      }
+
+      if (lru_index == _connections.size()) {
+        return nullptr;
+      }
+      close(lru_index);
+    }
+
+    std::unique_ptr<Connection> newConnection(new (std::nothrow) Connection());
+
+    if (!newConnection) {
+      return nullptr;
+    }
+    newConnection->host = host;
+    newConnection->port = port;
+    newConnection->http.setReuse(true);
+    connection          = newConnection.get();
+    _connections.push_back(std::move(newConnection));
+  } else {
+    reused = connection->client.connected();
+  }
+
+  connection->inUse = true;
+  ++_nrRequests;
+
+  if (reused) {
+    ++_nrReused;
+  }
+  return connection;
+}
+
+void HTTPClientPool::release(Connection *connection, bool keepAlive)
+{
+  if (connection == nullptr) { return; }
+
+  for (size_t i = 0; i < _connections.size(); ++i) {
+    if (_connections[i].get() == connection) {
+      // Only closes the socket when the server did not agree on keep-alive.
+      connection->http.end();
+      connection->inUse    = false;
+      connection->lastUsed = millis();
+
+      if (!keepAlive || !connection->client.connected()) {
+        close(i);
+      }
+      return;
+    }
+  }
+}
+
+void HTTPClientPool::closeIdle()
+{
+  for (size_t i = _connections.size(); i > 0; --i) {
+    const Connection& connection = *_connections[i - 1];
+
+    if (!connection.inUse &&
+        ((timePassedSince(connection.lastUsed) > HTTP_CLIENT_POOL_IDLE_TIMEOUT) ||
+         !_connections[i - 1]->client.connected())) {
+      close(i - 1);
+    }
+  }
+}
+
+void HTTPClientPool::closeAll()
+{
+  for (size_t i = _connections.size(); i > 0; --i) {
+    if (!_connections[i - 1]->inUse) {
+      close(i - 1);
+    }
+  }
+}
+
+float HTTPClientPool::getReuseRatio() const
+{
+  if (_nrRequests == 0) { return 0.0f; }
+  return (100.0f * _nrReused) / _nrRequests;
+}
+
+void HTTPClientPool::close(size_t index)
+{
+  if (index >= _connections.size()) { return; }
+
+  # ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE)) {
+    addLogMove(LOG_LEVEL_DEBUG_MORE, strformat(
+                 F("HTTP : Close connection to %s:%u"),
+                 _connections[index]->host.c_str(),
+                 _connections[index]->port));
+  }
+  # endif // ifndef BUILD_NO_DEBUG
+  _connections[index]->client.stop();
+  _connections.erase(_connections.begin() + index);
+}
+
+#endif // if FEATURE_HTTP_CLIENT
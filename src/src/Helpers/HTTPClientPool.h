@@ -0,0 +1,86 @@
+#ifndef HELPERS_HTTPCLIENTPOOL_H
+#define HELPERS_HTTPCLIENTPOOL_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_HTTP_CLIENT
+
+# include <WiFiClient.h>
+
+# ifdef ESP8266
+#  include <ESP8266HTTPClient.h>
+# endif // ifdef ESP8266
+# ifdef ESP32
+#  include <HTTPClient.h>
+# endif // ifdef ESP32
+
+# include <memory>
+# include <vector>
+
+
+/*********************************************************************************************\
+* HTTPClientPool
+* Keeps HTTP/1.1 connections open (keep-alive) per host:port,
+* so consecutive requests to the same host do not need a new TCP connection.
+* Shared by all HTTP based controllers and the SendToHTTP command.
+*
+* Connections are closed when idle for HTTP_CLIENT_POOL_IDLE_TIMEOUT msec,
+* when closed by the server or when a request failed.
+* At most HTTP_CLIENT_POOL_MAX_SOCKETS connections are kept open.
+\*********************************************************************************************/
+class HTTPClientPool {
+public:
+
+  struct Connection {
+    WiFiClient    client;
+    HTTPClient    http;
+    String        host;
+    unsigned long lastUsed{};
+    uint16_t      port{};
+    bool          inUse{};
+  };
+
+  // Return a connection for host:port, or nullptr when all sockets are in use.
+  // 'reused' is set when the connection to the host is still open.
+  Connection* acquire(const String& host,
+                      uint16_t      port,
+                      bool        & reused);
+
+  // Return the connection to the pool.
+  // Set keepAlive to false to close the connection, e.g. on errors.
+  void        release(Connection *connection,
+                      bool        keepAlive);
+
+  // Close connections which are idle for too long or closed by the server.
+  void        closeIdle();
+
+  void        closeAll();
+
+  size_t      getNrConnections() const {
+    return _connections.size();
+  }
+
+  uint32_t getNrRequests() const {
+    return _nrRequests;
+  }
+
+  uint32_t getNrReused() const {
+    return _nrReused;
+  }
+
+  // Percentage of requests sent over an already open connection.
+  float getReuseRatio() const;
+
+private:
+
+  void close(size_t index);
+
+  std::vector<std::unique_ptr<Connection> >_connections;
+
+  uint32_t _nrRequests{};
+  uint32_t _nrReused{};
+};
+
+#endif // if FEATURE_HTTP_CLIENT
+
+#endif // ifndef HELPERS_HTTPCLIENTPOOL_H
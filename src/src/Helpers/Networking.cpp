@@ -20,6 +20,7 @@
 #endif
 
 #include "../Globals/EventQueue.h"
+#include "../Globals/HTTPClientPool.h"
 #include "../Globals/NetworkState.h"
 #include "../Globals/Nodes.h"
 #include "../Globals/ResetFactoryDefaultPref.h"
@@ -97,7 +98,7 @@ void etharp_gratuitous_r(struct netif *netif) {
 /*********************************************************************************************\
    Syslog client
 \*********************************************************************************************/
-void sendSyslog(uint8_t logLevel, const String& message)
+void sendSyslog(uint8_t logLevel, const char *message, size_t length)
 {
   if ((Settings.Syslog_IP[0] != 0) && NetworkConnected())
   {
@@ -143,10 +144,10 @@ void sendSyslog(uint8_t logLevel, const String& message)
     }
 
     #ifdef ESP8266
-    portUDP.write(message.c_str(), message.length());
+    portUDP.write(message, length);
     #endif // ifdef ESP8266
     #ifdef ESP32
-    portUDP.write(reinterpret_cast<const uint8_t *>(message.c_str()), message.length());
+    portUDP.write(reinterpret_cast<const uint8_t *>(message), length);
     #endif // ifdef ESP32
 
     portUDP.endPacket();
@@ -1674,6 +1675,52 @@ String send_via_http(const String& logIdentifier,
                      const String& postStr,
                      int         & httpCode,
                      bool          must_check_reply) {
+  // Keep the connection open only when the reply is read.
+  // Otherwise a late reply would be read as the reply to the next request.
+  // Redirects may leave the connection open to another host.
+  if (must_check_reply && !Settings.SendToHTTP_follow_redirects()) {
+    bool reused                            = false;
+    HTTPClientPool::Connection *connection = httpClientPool.acquire(host, port, reused);
+
+    if (connection != nullptr) {
+      START_TIMER;
+      httpCode = http_authenticate(
+        logIdentifier,
+        connection->client,
+        connection->http,
+        timeout,
+        user,
+        pass,
+        host,
+        port,
+        uri,
+        HttpMethod,
+        header,
+        postStr,
+        must_check_reply);
+
+      String response;
+
+      if (httpCode > 0) {
+        // Read the complete reply, so the connection can be used for the next request.
+        response = connection->http.getString();
+#ifndef BUILD_NO_DEBUG
+        if (!response.isEmpty()) {
+          log_http_result(connection->http, logIdentifier, host, HttpMethod, httpCode, response);
+        }
+#endif
+      }
+      httpClientPool.release(connection, httpCode > 0);
+
+      if (reused) {
+        STOP_TIMER(HTTP_SEND_REUSED_CONNECTION);
+      } else {
+        STOP_TIMER(HTTP_SEND_NEW_CONNECTION);
+      }
+      return response;
+    }
+  }
+
   WiFiClient client;
   HTTPClient http;
   http.setReuse(false);
@@ -20,7 +20,7 @@
 /*********************************************************************************************\
    Syslog client
 \*********************************************************************************************/
-void sendSyslog(uint8_t logLevel, const String& message);
+void sendSyslog(uint8_t logLevel, const char *message, size_t length);
 
 
 #if FEATURE_ESPEASY_P2P
@@ -21,12 +21,14 @@
 #include "../Globals/ESPEasy_Scheduler.h"
 #include "../Globals/ESPEasy_time.h"
 #include "../Globals/EventQueue.h"
+#include "../Globals/HTTPClientPool.h"
 #include "../Globals/MainLoopCommand.h"
 #include "../Globals/MQTT.h"
 #include "../Globals/NetworkState.h"
 #include "../Globals/RTC.h"
 #include "../Globals/Services.h"
 #include "../Globals/Settings.h"
+#include "../Globals/SettingsWriteBack.h"
 #include "../Globals/Statistics.h"
 #include "../Globals/WiFi_AP_Candidates.h"
 #include "../Helpers/ESPEasyRTC.h"
@@ -102,6 +104,9 @@ void run10TimesPerSecond() {
   #ifndef USE_RTOS_MULTITASKING
     web_server.handleClient();
   #endif
+  #if FEATURE_SETTINGS_WRITE_BACK
+  settingsWriteBack.loop();
+  #endif
 }
 
 
@@ -185,6 +190,11 @@ void runOncePerSecond()
   getInternalTemperature(); // Just read the value every second to hopefully get a valid next reading on original ESP32
   #endif // if FEATURE_INTERNAL_TEMPERATURE && defined(ESP32_CLASSIC)
 
+  #if FEATURE_HTTP_CLIENT
+  // Close kept open HTTP connections which are no longer used
+  httpClientPool.closeIdle();
+  #endif // if FEATURE_HTTP_CLIENT
+
   checkResetFactoryPin();
   STOP_TIMER(PLUGIN_CALL_1PS);
 }
@@ -285,56 +295,80 @@ void schedule_all_MQTTimport_tasks() {
   }
 }
 
+// Process a single MQTT queue element.
+// Return true when it can be removed from the queue.
+static bool processMQTTdelayQueueElement(const MQTT_queue_element& element) {
+  if (element._call_PLUGIN_PROCESS_CONTROLLER_DATA) {
+    struct EventStruct TempEvent(element._taskIndex);
+    String dummy;
+
+    // FIXME TD-er: Do we need anything from the element in the event?
+//    TempEvent.String1 = element._topic;
+//    TempEvent.String2 = element._payload;
+    return PluginCall(PLUGIN_PROCESS_CONTROLLER_DATA, &TempEvent, dummy);
+  }
+
+  if (MQTTclient.publish(element._topic.c_str(), element._payload.c_str(), element._retained)) {
+    if (WiFiEventData.connectionFailures > 0) {
+      --WiFiEventData.connectionFailures;
+    }
+    return true;
+  }
+#ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    String log = F("MQTT : process MQTT queue not published, ");
+    log += MQTTDelayHandler->sendQueue.size();
+    log += F(" items left in queue");
+    addLogMove(LOG_LEVEL_DEBUG, log);
+  }
+#endif // ifndef BUILD_NO_DEBUG
+  return false;
+}
+
 void processMQTTdelayQueue() {
   if (MQTTDelayHandler == nullptr) {
     return;
   }
   runPeriodicalMQTT(); // Update MQTT connected state.
-  if (!MQTTclient_connected) {
+  if (!MQTTclient_connected || !MQTTDelayHandler->batchReady()) {
     scheduleNextMQTTdelayQueue();
     return;
   }
 
   START_TIMER;
-  MQTT_queue_element *element(static_cast<MQTT_queue_element *>(MQTTDelayHandler->getNext()));
+  const unsigned long start = millis();
 
-  if (element == nullptr) { return; }
+  // With batch send enabled, publish all elements of the batch
+  // without handling the MQTT client loop in between.
+  const size_t batchSize = MQTTDelayHandler->getBatchSize();
+  size_t nrProcessed     = 0;
+  bool   processed       = true;
 
-  bool handled = false;
+  while (processed && nrProcessed < batchSize) {
+    if ((nrProcessed != 0) && Scheduler.sliceBudgetExceeded()) {
+      break;
+    }
+    MQTT_queue_element *element(static_cast<MQTT_queue_element *>(MQTTDelayHandler->getNext()));
 
-  if (element->_call_PLUGIN_PROCESS_CONTROLLER_DATA) {
-    struct EventStruct TempEvent(element->_taskIndex);
-    String dummy;
+    if (element == nullptr) { break; }
 
-    // FIXME TD-er: Do we need anything from the element in the event?
-//    TempEvent.String1 = element->_topic;
-//    TempEvent.String2 = element->_payload;
-    if (PluginCall(PLUGIN_PROCESS_CONTROLLER_DATA, &TempEvent, dummy)) {
-      handled = true;
-      MQTTDelayHandler->markProcessed(true);
-    } else {
-      MQTTDelayHandler->markProcessed(false);
-    }
-  } else
-  if (!handled) {
-    if (MQTTclient.publish(element->_topic.c_str(), element->_payload.c_str(), element->_retained)) {
-      if (WiFiEventData.connectionFailures > 0) {
-        --WiFiEventData.connectionFailures;
-      }
-      MQTTDelayHandler->markProcessed(true);
-    } else {
-      MQTTDelayHandler->markProcessed(false);
-#ifndef BUILD_NO_DEBUG
+    processed = processMQTTdelayQueueElement(*element);
+    MQTTDelayHandler->markProcessed(processed);
 
-      if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-        String log = F("MQTT : process MQTT queue not published, ");
-        log += MQTTDelayHandler->sendQueue.size();
-        log += F(" items left in queue");
-        addLogMove(LOG_LEVEL_DEBUG, log);
-      }
-#endif // ifndef BUILD_NO_DEBUG
+    if (processed) {
+      ++nrProcessed;
     }
   }
+
+  if (nrProcessed == 0 && processed) {
+    // Nothing in the queue
+    return;
+  }
+
+  if (MQTTDelayHandler->adaptive_send_rate) {
+    MQTTDelayHandler->updateAdaptiveRate(!processed, timePassedSince(start), nrProcessed);
+  }
   Scheduler.setIntervalTimerOverride(SchedulerIntervalTimer_e::TIMER_MQTT, 10); // Make sure the MQTT is being processed as soon as possible.
   scheduleNextMQTTdelayQueue();
   STOP_TIMER(MQTT_DELAY_QUEUE);
@@ -487,6 +521,9 @@ void prepareShutdown(IntendedRebootReason_e reason)
   process_serialWriteBuffer();
   flushAndDisconnectAllClients();
   saveUserVarToRTC();
+  #if FEATURE_SETTINGS_WRITE_BACK
+  settingsWriteBack.flush();
+  #endif
   setWifiMode(WIFI_OFF);
   ESPEASY_FS.end();
   process_serialWriteBuffer();
@@ -156,6 +156,17 @@ void RulesHelperClass::init()
       const size_t pos_start_line = pos;
       const String rulesLine      = readLn(filename, pos, moreAvailable, searchNextOnBlock);
 
+#ifndef CACHE_RULES_IN_MEMORY
+
+      if (RulesFileCache::isOnLine(rulesLine)) {
+        RulesFileCache *fileCache = getFileCache(filename);
+
+        if (fileCache != nullptr) {
+          fileCache->addOnLine(pos_start_line);
+        }
+      }
+#endif // ifndef CACHE_RULES_IN_MEMORY
+
       if (_eventCache.addLine(
             rulesLine,
             filename,
@@ -174,57 +185,48 @@ void RulesHelperClass::init()
 #endif // ifndef BUILD_NO_DEBUG
       }
     }
+#ifndef CACHE_RULES_IN_MEMORY
+    RulesFileCache *fileCache = getFileCache(filename);
+
+    if (fileCache != nullptr) {
+      fileCache->setLineIndexComplete();
+    }
+#endif // ifndef CACHE_RULES_IN_MEMORY
   }
   _eventCache.initialize();
 }
 
 void RulesHelperClass::closeAllFiles() {
-  for (auto it = _fileHandleMap.begin(); it != _fileHandleMap.end();) {
-    #ifdef CACHE_RULES_IN_MEMORY
-    it = _fileHandleMap.erase(it);
-    #else // ifdef CACHE_RULES_IN_MEMORY
-    it->second.close();
-    it = _fileHandleMap.erase(it);
-    #endif // ifdef CACHE_RULES_IN_MEMORY
-  }
+  _fileHandleMap.clear();
   _eventCache.clear();
+  ++_generation;
 }
 
 #ifndef CACHE_RULES_IN_MEMORY
-size_t RulesHelperClass::read(const String& filename, size_t& pos, uint8_t *buffer, size_t length)
+RulesFileCache * RulesHelperClass::getFileCache(const String& filename)
 {
-  if (!Settings.UseRules || !fileExists(filename)) {
-    return 0;
-  }
-  auto it = _fileHandleMap.begin();
-
-  if (it != _fileHandleMap.end()) {
-    if (!it->first.equals(filename)) {
-      // Switched to a new file.
-      // Close this handle first to make sure we don't keep too many file handles open.
-      it->second.close();
-      _fileHandleMap.erase(it);
-      it = _fileHandleMap.end();
-    }
+  if (!Settings.UseRules) {
+    return nullptr;
   }
+  auto it = _fileHandleMap.find(filename);
 
   if (it == _fileHandleMap.end()) {
-    // No open file handle found, so try to open it.
-    _fileHandleMap.emplace(filename, tryOpenFile(filename, "r"));
-    it = _fileHandleMap.find(filename);
-  }
-
-  if (!it->second) {
-    return 0;
+    if (!fileExists(filename)) {
+      return nullptr;
+    }
+    it = _fileHandleMap.emplace(
+      std::piecewise_construct,
+      std::forward_as_tuple(filename),
+      std::forward_as_tuple()).first;
   }
 
-  if (it->second.position() != pos) {
-    it->second.seek(pos);
+  // Make sure we don't keep too many file handles open.
+  for (auto other = _fileHandleMap.begin(); other != _fileHandleMap.end(); ++other) {
+    if (other != it) {
+      other->second.closeFile();
+    }
   }
-  const size_t ret = it->second.read(buffer, length);
-
-  pos = it->second.position();
-  return ret;
+  return &(it->second);
 }
 
 #endif // ifndef CACHE_RULES_IN_MEMORY
@@ -272,12 +274,8 @@ bool RulesHelperClass::addChar(char c, String& line,   bool& firstNonSpaceRead)
 }
 
 #ifdef CACHE_RULES_IN_MEMORY
-String RulesHelperClass::readLn(const String& filename,
-                                size_t      & pos,
-                                bool        & moreAvailable,
-                                bool          searchNextOnBlock)
+const RulesHelperClass::RulesLines * RulesHelperClass::getCompiledRules(const String& filename)
 {
-  moreAvailable = false;
   auto it = _fileHandleMap.find(filename);
 
   if (it == _fileHandleMap.end()) {
@@ -289,13 +287,9 @@ String RulesHelperClass::readLn(const String& filename,
       String     tmpStr;
       bool firstNonSpaceRead = false;
 
-      // Keep track of which line we're reading for the event cache.
-      size_t readPos = 0;
-
       while (f.available()) {
         if (addChar(char(f.read()), tmpStr, firstNonSpaceRead)) {
-          lines.push_back(tmpStr);
-          ++readPos;
+          lines.emplace_back(tmpStr);
 
           firstNonSpaceRead = false;
           tmpStr.clear();
@@ -305,7 +299,7 @@ String RulesHelperClass::readLn(const String& filename,
       if (tmpStr.length() > 0) {
         rules_strip_trailing_comments(tmpStr);
         check_rules_line_user_errors(tmpStr);
-        lines.push_back(tmpStr);
+        lines.emplace_back(tmpStr);
         tmpStr.clear();
       }
 # ifndef BUILD_NO_DEBUG
@@ -322,14 +316,30 @@ String RulesHelperClass::readLn(const String& filename,
     }
   }
 
-  if (it != _fileHandleMap.end()) {
-    while (pos < it->second.size()) {
+  if (it == _fileHandleMap.end()) {
+    return nullptr;
+  }
+  return &(it->second);
+}
+
+String RulesHelperClass::readLn(const String& filename,
+                                size_t      & pos,
+                                bool        & moreAvailable,
+                                bool          searchNextOnBlock)
+{
+  moreAvailable = false;
+  const RulesLines *lines = getCompiledRules(filename);
+
+  if (lines != nullptr) {
+    while (pos < lines->size()) {
       ++pos;
-      moreAvailable = pos < it->second.size();
+      moreAvailable = pos < lines->size();
+
+      const RulesLine& line = (*lines)[pos - 1];
 
       if (!searchNextOnBlock ||
-          it->second[pos - 1].substring(0, 3).equalsIgnoreCase(F("on "))) {
-        return it->second[pos - 1];
+          (line._type == RulesLineType::On)) {
+        return line._line;
       }
     }
   }
@@ -348,9 +358,19 @@ String RulesHelperClass::readLn(const String& filename,
   HeapSelectDram ephemeral;
   #endif // ifdef USE_SECOND_HEAP
 
-  std::vector<uint8_t> buf;
+  moreAvailable = false;
+  RulesFileCache *fileCache = getFileCache(filename);
 
-  buf.resize(RULES_BUFFER_SIZE);
+  if (fileCache == nullptr) {
+    return EMPTY_STRING;
+  }
+
+  if (searchNextOnBlock && fileCache->lineIndexComplete()) {
+    // Skip all lines up to the next "On" line
+    if (!fileCache->findNextOnLine(pos)) {
+      return EMPTY_STRING;
+    }
+  }
 
   bool firstNonSpaceRead = false;
 
@@ -360,19 +380,17 @@ String RulesHelperClass::readLn(const String& filename,
 
   line.reserve(longestLineSize);
 
-  bool done = false;
-
-  while (!done) {
+  while (true) {
     const size_t startPos = pos;
-    int len               = read(filename, pos, &buf[0], RULES_BUFFER_SIZE);
-    moreAvailable = len != 0;
+    size_t len            = 0;
+    const uint8_t *data   = fileCache->getData(filename, pos, len);
 
-    if (!moreAvailable) { done = true; }
+    moreAvailable = data != nullptr;
 
-    for (int x = 0; x < len; x++) {
-      int data = buf[x];
+    if (!moreAvailable) { break; }
 
-      if (addChar(char(data), line, firstNonSpaceRead)) {
+    for (size_t x = 0; x < len; x++) {
+      if (addChar(char(data[x]), line, firstNonSpaceRead)) {
         if (line.length() > longestLineSize) {
           longestLineSize = line.length();
         }
@@ -381,11 +399,8 @@ String RulesHelperClass::readLn(const String& filename,
         // so we must make sure the position is reflecting the end of the line.
         pos = startPos + x;
 
-        if (!searchNextOnBlock ||
-            line.substring(0, 3).equalsIgnoreCase(F("on ")))
+        if (!searchNextOnBlock || RulesFileCache::isOnLine(line))
         {
-          done = true;
-
           return line;
         } else {
           // Not starting with "on " which we need, so continue to search for a matching line
@@ -393,6 +408,7 @@ String RulesHelperClass::readLn(const String& filename,
         }
       }
     }
+    pos = startPos + len;
   }
   rules_strip_trailing_comments(line);
   check_rules_line_user_errors(line);
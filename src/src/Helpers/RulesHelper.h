@@ -4,13 +4,15 @@
 #include "../../ESPEasy_common.h"
 
 #include "../DataStructs/RulesEventCache.h"
+#include "../DataStructs/RulesFileCache.h"
+#include "../DataStructs/RulesLine.h"
 
 #include <FS.h>
 #include <map>
 
-#ifdef ESP32
+#if defined(ESP32) && !defined(NO_CACHE_RULES_IN_MEMORY)
 # define CACHE_RULES_IN_MEMORY
-#endif // ifdef ESP32
+#endif // if defined(ESP32) && !defined(NO_CACHE_RULES_IN_MEMORY)
 
 
 // Helper class to handle reading from the rules file(s).
@@ -28,6 +30,12 @@
 class RulesHelperClass {
 public:
 
+#ifdef CACHE_RULES_IN_MEMORY
+
+  // Cache the entire rules file contents in memory, in pre-compiled form
+  typedef std::vector<RulesLine> RulesLines;
+#endif // ifdef CACHE_RULES_IN_MEMORY
+
   RulesHelperClass();
 
   ~RulesHelperClass();
@@ -40,13 +48,26 @@ public:
                         String      & filename,
                         size_t      & pos);
 
+  // Incremented each time the cached rules are discarded.
+  // Used to detect the rules were reloaded while processing a block of lines.
+  uint32_t getGeneration() const {
+    return _generation;
+  }
+
+#ifdef CACHE_RULES_IN_MEMORY
+
+  // Return the pre-compiled lines of a rules file.
+  // The file will be read when not yet present in the cache.
+  // Return nullptr when the file could not be read.
+  const RulesLines* getCompiledRules(const String& filename);
+#endif // ifdef CACHE_RULES_IN_MEMORY
+
 private:
 
 #ifndef CACHE_RULES_IN_MEMORY
-  size_t read(const String& filename,
-              size_t      & pos,
-              uint8_t      *buffer,
-              size_t        length);
+
+  // Return the read cache of the rules file, or nullptr when the file does not exist.
+  RulesFileCache* getFileCache(const String& filename);
 
 #endif // ifndef CACHE_RULES_IN_MEMORY
 
@@ -64,19 +85,18 @@ public:
 private:
 
 #ifdef CACHE_RULES_IN_MEMORY
-
-  // Cache the entire rules file contents in memory
-  typedef std::vector<String>         RulesLines;
   typedef std::map<String, RulesLines>FileHandleMap;
 #else // ifdef CACHE_RULES_IN_MEMORY
 
-  // Keep a handle to a file for low-memory systems
-  typedef std::map<String, fs::File> FileHandleMap;
+  // Keep a read cache per file for low-memory systems
+  typedef std::map<String, RulesFileCache> FileHandleMap;
 #endif // ifdef CACHE_RULES_IN_MEMORY
 
   RulesEventCache _eventCache;
 
   FileHandleMap _fileHandleMap;
+
+  uint32_t _generation = 0;
 };
 
 #endif // ifndef HELPERS_RULESHELPER_H
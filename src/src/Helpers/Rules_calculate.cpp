@@ -8,11 +8,12 @@
 #include "../Helpers/StringConverter.h"
 
 
-RulesCalculate_t::RulesCalculate_t() {
-  for (int i = 0; i < STACK_SIZE; ++i) {
-    globalstack[i] = 0.0;
-  }
-}
+// Variables bound to a compiled expression are replaced by a single character
+// in a range we don't expect in the rules.
+#define COMPILED_EXPRESSION_VAR_CHAR 0x10
+
+static_assert(CALCULATE_CACHE_MAX_OPERANDS >= COMPILED_EXPRESSION_MAX_VARS, "Operands also hold the variables");
+static_assert((COMPILED_EXPRESSION_VAR_CHAR + CALCULATE_CACHE_MAX_OPERANDS) <= ' ', "Too many operands for the range of variable characters");
 
 /********************************************************************************************\
    Calculate function for simple expressions
@@ -28,10 +29,17 @@ bool RulesCalculate_t::is_number(char oc, char c)
     (c == '.')   ||                                // A decimal point of a floating point number.
     ((oc == '0') && ((c == 'x') || (c == 'b'))) || // HEX (0x) or BIN (0b) prefixes.
     isxdigit(c)  ||                                // HEX digit also includes normal decimal numbers
+    is_variable(c) ||                              // Variable bound to a compiled expression
     (is_operator(oc) && (c == '-'))                // Beginning of a negative number after an operator.
   ;
 }
 
+bool RulesCalculate_t::is_variable(char c)
+{
+  return c >= COMPILED_EXPRESSION_VAR_CHAR &&
+         c < (COMPILED_EXPRESSION_VAR_CHAR + CALCULATE_CACHE_MAX_OPERANDS);
+}
+
 bool RulesCalculate_t::is_operator(char c)
 {
   return c == '+' || c == '-' || c == '*' || c == '/' || c == '^' || c == '%';
@@ -71,26 +79,6 @@ bool RulesCalculate_t::is_unary_operator(char c)
   */
 }
 
-CalculateReturnCode RulesCalculate_t::push(ESPEASY_RULES_FLOAT_TYPE value)
-{
-  if (sp != sp_max) // Full
-  {
-    *(++sp) = value;
-    return CalculateReturnCode::OK;
-  }
-  return CalculateReturnCode::ERROR_STACK_OVERFLOW;
-}
-
-ESPEASY_RULES_FLOAT_TYPE RulesCalculate_t::pop()
-{
-  if (sp != (globalstack - 1)) { // empty
-    return *(sp--);
-  }
-  else {
-    return 0.0;
-  }
-}
-
 ESPEASY_RULES_FLOAT_TYPE RulesCalculate_t::apply_operator(char op, ESPEASY_RULES_FLOAT_TYPE first, ESPEASY_RULES_FLOAT_TYPE second)
 {
   switch (op)
@@ -261,52 +249,33 @@ ESPEASY_RULES_FLOAT_TYPE RulesCalculate_t::apply_unary_operator(char op, ESPEASY
   return ret;
 }
 
-/*
-   char * RulesCalculate_t::next_token(char *linep)
-   {
-   while (isspace(*(linep++))) {}
-
-   while (*linep && !isspace(*(linep++))) {}
-   return linep;
-   }
- */
-CalculateReturnCode RulesCalculate_t::RPNCalculate(char *token)
+CalculateReturnCode CompiledExpression::emit(const char *token)
 {
-  CalculateReturnCode ret = CalculateReturnCode::OK;
-
   if (token[0] == 0) {
-    return ret; // Don't bother for an empty string
+    return CalculateReturnCode::OK; // Don't bother for an empty string
   }
 
-  if (is_operator(token[0]) && (token[1] == 0))
+  if (RulesCalculate_t::is_operator(token[0]) && (token[1] == 0))
   {
-    ESPEASY_RULES_FLOAT_TYPE second = pop();
-    ESPEASY_RULES_FLOAT_TYPE first  = pop();
-
-    ret = push(apply_operator(token[0], first, second));
-
-// FIXME TD-er: Regardless whether it is an error, all code paths return ret;
-//    if (isError(ret)) { return ret; }
-  } else if (is_unary_operator(token[0]) && (token[1] == 0))
+    _tokens.emplace_back(RPN_token_t::Type::Operator, token[0]);
+  } else if (RulesCalculate_t::is_unary_operator(token[0]) && (token[1] == 0))
   {
-    ESPEASY_RULES_FLOAT_TYPE first = pop();
-
-    ret = push(apply_unary_operator(token[0], first));
-
-// FIXME TD-er: Regardless whether it is an error, all code paths return ret;
-//    if (isError(ret)) { return ret; }
+    _tokens.emplace_back(RPN_token_t::Type::UnaryOperator, token[0]);
+  } else if (RulesCalculate_t::is_variable(token[0]) && (token[1] == 0))
+  {
+    _tokens.emplace_back(RPN_token_t::Type::Variable, token[0] - COMPILED_EXPRESSION_VAR_CHAR);
+  } else if ((token[0] == '-') && RulesCalculate_t::is_variable(token[1]) && (token[2] == 0))
+  {
+    // Negative variable, e.g. "2*-%value%"
+    _tokens.emplace_back(RPN_token_t::Type::Variable, token[1] - COMPILED_EXPRESSION_VAR_CHAR);
+    _tokens.emplace_back(-1.0);
+    _tokens.emplace_back(RPN_token_t::Type::Operator, '*');
   } else {
-    // Fetch next if there is any
     ESPEASY_RULES_FLOAT_TYPE value{};
     validDoubleFromString(token, value);
-
-    ret = push(value); // If it is a value, push to the stack
-
-// FIXME TD-er: Regardless whether it is an error, all code paths return ret;
-//    if (isError(ret)) { return ret; }
+    _tokens.emplace_back(value);
   }
-
-  return ret;
+  return CalculateReturnCode::OK;
 }
 
 // operators
@@ -355,12 +324,13 @@ unsigned int RulesCalculate_t::op_arg_count(const char c)
   return 0;
 }
 
-CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RULES_FLOAT_TYPE *result)
+CalculateReturnCode CompiledExpression::compile_preProcessed(const char *input)
 {
-
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("Calculate"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
+  _tokens.clear();
+
   const char *strpos = input, *strend = input + strlen(input);
   char token[TOKEN_LENGTH];
   char c, oc, *TokenPos = token;
@@ -369,8 +339,6 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
   char sc;                         // used for record stack element
   CalculateReturnCode error = CalculateReturnCode::OK;
 
-  // *sp=0; // bug, it stops calculating after 50 times
-  sp = globalstack - 1;
   oc = c = 0;
 
   if (input[0] == '=') {
@@ -392,17 +360,17 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
     if (c != ' ')
     {
       // If the token is a number (identifier), then add it to the token queue.
-      if (is_number(oc, c))
+      if (RulesCalculate_t::is_number(oc, c))
       {
         *TokenPos = c;
         ++TokenPos;
       }
 
       // If the token is an operator, op1, then:
-      else if (is_operator(c) || is_unary_operator(c))
+      else if (RulesCalculate_t::is_operator(c) || RulesCalculate_t::is_unary_operator(c))
       {
         *(TokenPos) = 0; // Mark end of token string
-        error       = RPNCalculate(token);
+        error       = emit(token);
         TokenPos    = token;
 
         if (isError(error)) { return error; }
@@ -416,10 +384,10 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
           // or op1 has precedence less than that of op2,
           // The differing operator priority decides pop / push
           // If 2 operators have equal priority then associativity decides.
-          if (is_operator(sc) &&
+          if (RulesCalculate_t::is_operator(sc) &&
               (
-                (op_left_assoc(c) && (op_preced(c) <= op_preced(sc))) ||
-                (op_preced(c) < op_preced(sc))
+                (RulesCalculate_t::op_left_assoc(c) && (RulesCalculate_t::op_preced(c) <= RulesCalculate_t::op_preced(sc))) ||
+                (RulesCalculate_t::op_preced(c) < RulesCalculate_t::op_preced(sc))
               )
               )
           {
@@ -427,7 +395,7 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
             *TokenPos = sc;
             ++TokenPos;
             *(TokenPos) = 0; // Mark end of token string
-            error       = RPNCalculate(token);
+            error       = emit(token);
             TokenPos    = token;
 
             if (isError(error)) { return error; }
@@ -461,7 +429,7 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
         while (sl > 0)
         {
           *(TokenPos) = 0; // Mark end of token string
-          error       = RPNCalculate(token);
+          error       = emit(token);
           TokenPos    = token;
 
           if (isError(error)) { return error; }
@@ -514,7 +482,7 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
     }
 
     *(TokenPos) = 0; // Mark end of token string
-    error       = RPNCalculate(token);
+    error       = emit(token);
     TokenPos    = token;
 
     if (isError(error)) { return error; }
@@ -524,21 +492,278 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
   }
 
   *(TokenPos) = 0; // Mark end of token string
-  error       = RPNCalculate(token);
-  TokenPos    = token;
+  return emit(token);
+}
 
-  if (isError(error))
-  {
-    *result = 0;
-    return error;
+CalculateReturnCode CompiledExpression::compile(const String& expression,
+                                                const __FlashStringHelper * const variableNames[],
+                                                uint8_t nrVariables)
+{
+  for (size_t i = 0; i < expression.length(); ++i) {
+    if (RulesCalculate_t::is_variable(expression[i])) {
+      // Would refer to a variable which is not bound
+      return CalculateReturnCode::ERROR_UNKNOWN_TOKEN;
+    }
+  }
+
+  String input = expression;
+
+  for (uint8_t i = 0; i < nrVariables && i < COMPILED_EXPRESSION_MAX_VARS; ++i) {
+    input.replace(variableNames[i], String(static_cast<char>(COMPILED_EXPRESSION_VAR_CHAR + i)));
+  }
+  const CalculateReturnCode returnCode = compile_preProcessed(RulesCalculate_t::preProces(input).c_str());
+
+  if (!isError(returnCode)) {
+    fold();
+  }
+  return returnCode;
+}
+
+void CompiledExpression::fold()
+{
+  // In RPN, the operands of an operator are the last emitted sub-expressions.
+  // When these are all plain values, the result can be computed right away.
+  size_t out = 0;
+
+  for (size_t i = 0; i < _tokens.size(); ++i) {
+    const RPN_token_t token = _tokens[i];
+
+    if ((token.type == RPN_token_t::Type::Operator) &&
+        (out >= 2) &&
+        (_tokens[out - 1].type == RPN_token_t::Type::Value) &&
+        (_tokens[out - 2].type == RPN_token_t::Type::Value)) {
+      _tokens[out - 2].value = RulesCalculate_t::apply_operator(token.op, _tokens[out - 2].value, _tokens[out - 1].value);
+      --out;
+    } else if ((token.type == RPN_token_t::Type::UnaryOperator) &&
+               (out >= 1) &&
+               (_tokens[out - 1].type == RPN_token_t::Type::Value)) {
+      _tokens[out - 1].value = RulesCalculate_t::apply_unary_operator(token.op, _tokens[out - 1].value);
+    } else {
+      _tokens[out] = token;
+      ++out;
+    }
+  }
+  _tokens.resize(out, RPN_token_t(0));
+}
+
+const CompiledExpression * CompiledExpression_LRU::get(const String& preprocessed, CalculateReturnCode& returnCode)
+{
+  returnCode = CalculateReturnCode::OK;
+
+  for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+    if (it->expression.equals(preprocessed)) {
+      if (it != _entries.begin()) {
+        // Move to the front, as most recently used
+        _entries.splice(_entries.begin(), _entries, it);
+      }
+      return &(_entries.front().compiled);
+    }
+  }
+
+  Entry entry;
+
+  returnCode = entry.compiled.compile_preProcessed(preprocessed.c_str());
+
+  if (isError(returnCode)) {
+    return nullptr;
+  }
+  entry.expression = preprocessed;
+
+  # ifdef USE_SECOND_HEAP
+  HeapSelectDram ephemeral;
+  # endif // ifdef USE_SECOND_HEAP
+
+  _entries.emplace_front(std::move(entry));
+
+  while (_entries.size() > CALCULATE_CACHE_SIZE) {
+    _entries.pop_back();
+  }
+  return &(_entries.front().compiled);
+}
+
+CalculateReturnCode CompiledExpression::eval(const ESPEASY_RULES_FLOAT_TYPE vars[],
+                                             ESPEASY_RULES_FLOAT_TYPE     & result) const
+{
+  ESPEASY_RULES_FLOAT_TYPE stack[STACK_SIZE]{};
+  int sp = -1;
+
+  result = 0;
+
+  for (auto it = _tokens.begin(); it != _tokens.end(); ++it) {
+    ESPEASY_RULES_FLOAT_TYPE value{};
+
+    switch (it->type) {
+      case RPN_token_t::Type::Value:
+        value = it->value;
+        break;
+      case RPN_token_t::Type::Variable:
+
+        if (vars != nullptr) {
+          value = vars[static_cast<uint8_t>(it->op)];
+        }
+        break;
+      case RPN_token_t::Type::Operator:
+      {
+        // Popping from an empty stack yields 0
+        const ESPEASY_RULES_FLOAT_TYPE second = sp >= 0 ? stack[sp--] : 0;
+        const ESPEASY_RULES_FLOAT_TYPE first  = sp >= 0 ? stack[sp--] : 0;
+        value = RulesCalculate_t::apply_operator(it->op, first, second);
+        break;
+      }
+      case RPN_token_t::Type::UnaryOperator:
+      {
+        const ESPEASY_RULES_FLOAT_TYPE first = sp >= 0 ? stack[sp--] : 0;
+        value = RulesCalculate_t::apply_unary_operator(it->op, first);
+        break;
+      }
+    }
+
+    if (sp >= (STACK_SIZE - 1)) {
+      return CalculateReturnCode::ERROR_STACK_OVERFLOW;
+    }
+    stack[++sp] = value;
+  }
+
+  if (sp >= 0) {
+    result = stack[sp];
   }
-  *result = *sp;
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("Calculate2"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
   return CalculateReturnCode::OK;
 }
 
+CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RULES_FLOAT_TYPE *result)
+{
+  CalculateReturnCode error = _expression.compile_preProcessed(input);
+
+  if (isError(error)) {
+    *result = 0;
+    return error;
+  }
+  return _expression.eval(nullptr, *result);
+}
+
+bool RulesCalculate_t::extractOperands(String& preprocessed, ESPEASY_RULES_FLOAT_TYPE operands[], uint8_t& nrOperands)
+{
+  // Follow the tokenizer of CompiledExpression::compile_preProcessed() to find the numbers,
+  // as these depend on the previous character and only end at an operator or ')'.
+  nrOperands = 0;
+
+  const size_t length    = preprocessed.length();
+  size_t readPos         = 0;
+  size_t writePos        = 0;
+  size_t nrSpaces        = 0; // Spaces within the number read so far
+  size_t nrOpenParenthes = 0; // '(' within the number read so far
+  char   token[TOKEN_LENGTH];
+  size_t tokenLength = 0;
+  char   c           = 0;
+  char   oc          = 0;
+
+  if ((length != 0) && (preprocessed[0] == '=')) {
+    ++readPos;
+    ++writePos;
+
+    if (readPos < length) {
+      c = preprocessed[readPos];
+    }
+  }
+
+  while (readPos <= length) {
+    const bool atEnd = readPos == length;
+
+    if (!atEnd) {
+      if (tokenLength >= (TOKEN_LENGTH - 1)) {
+        // Let the compiler report the error
+        return false;
+      }
+      oc = c;
+      c  = preprocessed[readPos];
+
+      if (is_variable(c)) { return false; }
+
+      if ((c == ' ') || (c == '(')) {
+        if (tokenLength == 0) {
+          preprocessed[writePos++] = c;
+        } else if (c == ' ') {
+          ++nrSpaces;
+        } else {
+          ++nrOpenParenthes;
+        }
+        ++readPos;
+        continue;
+      }
+
+      if (is_number(oc, c)) {
+        token[tokenLength++] = c;
+        ++readPos;
+        continue;
+      }
+    }
+
+    if (tokenLength != 0) {
+      token[tokenLength] = 0;
+
+      if ((tokenLength == 1) && is_operator(token[0])) {
+        // A '-' after an operator is not a number on its own.
+        preprocessed[writePos++] = token[0];
+      } else {
+        if (nrOperands >= CALCULATE_CACHE_MAX_OPERANDS) { return false; }
+        ESPEASY_RULES_FLOAT_TYPE value{};
+        validDoubleFromString(token, value);
+        operands[nrOperands]     = value;
+        preprocessed[writePos++] = static_cast<char>(COMPILED_EXPRESSION_VAR_CHAR + nrOperands);
+        ++nrOperands;
+      }
+
+      // Keep these within the token, as the tokenizer does not end a number on them.
+      for (; nrOpenParenthes != 0; --nrOpenParenthes) {
+        preprocessed[writePos++] = '(';
+      }
+
+      for (; nrSpaces != 0; --nrSpaces) {
+        preprocessed[writePos++] = ' ';
+      }
+      tokenLength = 0;
+    }
+
+    if (atEnd) { break; }
+    preprocessed[writePos++] = c;
+    ++readPos;
+  }
+  preprocessed.remove(writePos);
+  return true;
+}
+
+CalculateReturnCode RulesCalculate_t::doCalculate(const String& input, ESPEASY_RULES_FLOAT_TYPE& result)
+{
+  ESPEASY_RULES_FLOAT_TYPE operands[CALCULATE_CACHE_MAX_OPERANDS]{};
+  uint8_t nrOperands = 0;
+
+  _cacheKey = input;
+  preProcesInPlace(_cacheKey);
+
+  if (!extractOperands(_cacheKey, operands, nrOperands)) {
+    // Not suited for the cache, parse the expression as-is.
+    CalculateReturnCode error = _expression.compile_preProcessed(preProces(input).c_str());
+
+    if (isError(error)) {
+      result = 0;
+      return error;
+    }
+    return _expression.eval(nullptr, result);
+  }
+
+  CalculateReturnCode error          = CalculateReturnCode::OK;
+  const CompiledExpression *compiled = _cache.get(_cacheKey, error);
+
+  if (compiled == nullptr) {
+    result = 0;
+    return error;
+  }
+  return compiled->eval(operands, result);
+}
+
 void preProcessReplace(String& input, UnaryOperator op) {
   String find = toString(op);
 
@@ -617,6 +842,12 @@ String RulesCalculate_t::preProces(const String& input)
 {
   String preprocessed = input;
 
+  preProcesInPlace(preprocessed);
+  return preprocessed;
+}
+
+void RulesCalculate_t::preProcesInPlace(String& preprocessed)
+{
   const UnaryOperator operators[] = {
     UnaryOperator::Not
     ,UnaryOperator::Log
@@ -661,6 +892,4 @@ String RulesCalculate_t::preProces(const String& input)
       preProcessReplace(preprocessed, op);
     }
   }
-  return preprocessed;
 }
-
@@ -4,6 +4,9 @@
 
 #include "../../ESPEasy_common.h"
 
+#include <list>
+#include <vector>
+
 /********************************************************************************************\
    Calculate function for simple expressions
  \*********************************************************************************************/
@@ -13,6 +16,15 @@
 #define TOKEN_LENGTH 25
 #define OPERATOR_STACK_SIZE 32
 
+// Nr. of compiled expressions kept to skip parsing repeated expressions in Calculate()
+#ifndef CALCULATE_CACHE_SIZE
+# ifdef ESP32
+#  define CALCULATE_CACHE_SIZE 16
+# else // ifdef ESP32
+#  define CALCULATE_CACHE_SIZE 4
+# endif // ifdef ESP32
+#endif // ifndef CALCULATE_CACHE_SIZE
+
 enum class CalculateReturnCode : uint8_t{
   OK                           = 0u,
   ERROR_STACK_OVERFLOW         = 1u,
@@ -57,59 +69,167 @@ void   preProcessReplace(String      & input,
 bool   angleDegree(UnaryOperator op);
 const __FlashStringHelper* toString(UnaryOperator op);
 
+/********************************************************************************************\
+   Compiled expression
+   An expression is converted once into a flat array of RPN tokens.
+   Variables (e.g. %value% and %pvalue% in a task value formula) are bound to
+   numeric slots, so evaluating does not need any string operations or allocations.
+ \*********************************************************************************************/
+
+// Max. number of variables which can be bound to an expression.
+#define COMPILED_EXPRESSION_MAX_VARS 4
+
+// Max. number of numerical values taken out of an expression in Calculate() as operands,
+// so expressions only differing in their values share the same compiled expression.
+#ifndef CALCULATE_CACHE_MAX_OPERANDS
+# define CALCULATE_CACHE_MAX_OPERANDS 16
+#endif // ifndef CALCULATE_CACHE_MAX_OPERANDS
+
+struct RPN_token_t {
+  enum class Type : uint8_t {
+    Value,
+    Variable,
+    Operator,
+    UnaryOperator
+  };
+
+  RPN_token_t(ESPEASY_RULES_FLOAT_TYPE val) : value(val), type(Type::Value) {}
+
+  RPN_token_t(Type t, char c) : type(t), op(c) {}
+
+  ESPEASY_RULES_FLOAT_TYPE value{};
+  Type                     type = Type::Value;
+
+  // Operator character or variable index
+  char op = 0;
+};
+
+class CompiledExpression {
+public:
+
+  // Compile an expression, including replacing function names like log, sin, etc.
+  // All occurrences of variableNames[i] will be bound to vars[i] when calling eval()
+  // Constant sub-expressions are folded into a single value.
+  CalculateReturnCode compile(const String& expression,
+                              const __FlashStringHelper * const variableNames[] = nullptr,
+                              uint8_t                           nrVariables     = 0);
+
+  // Compile an expression which already has been processed by RulesCalculate_t::preProces()
+  CalculateReturnCode compile_preProcessed(const char *input);
+
+  CalculateReturnCode eval(const ESPEASY_RULES_FLOAT_TYPE vars[],
+                           ESPEASY_RULES_FLOAT_TYPE     & result) const;
+
+  bool isCompiled() const {
+    return !_tokens.empty();
+  }
+
+  void clear() {
+    _tokens.clear();
+  }
+
+private:
+
+  CalculateReturnCode emit(const char *token);
+
+  // Replace operators on constant values by their result.
+  void                fold();
+
+  std::vector<RPN_token_t>_tokens;
+};
+
+// Least recently used set of compiled expressions,
+// keyed on the preprocessed expression with its values replaced by operands.
+class CompiledExpression_LRU {
+public:
+
+  // Return the compiled expression, compile it when not present.
+  // Return nullptr on compile error.
+  const CompiledExpression* get(const String       & preprocessed,
+                                CalculateReturnCode& returnCode);
+
+  void clear() {
+    _entries.clear();
+  }
+
+private:
+
+  struct Entry {
+    String             expression;
+    CompiledExpression compiled;
+  };
+
+  std::list<Entry>_entries;
+};
+
 class RulesCalculate_t {
 private:
 
-  ESPEASY_RULES_FLOAT_TYPE globalstack[STACK_SIZE]{};
-  ESPEASY_RULES_FLOAT_TYPE *sp     = globalstack - 1;
-  const ESPEASY_RULES_FLOAT_TYPE *sp_max = &globalstack[STACK_SIZE - 1];
+  friend class CompiledExpression;
 
   // Check if it matches part of a number (identifier)
   // @param oc  Previous character
   // @param c   Current character
-  bool                is_number(char oc,
-                                char c);
-
-  bool                is_operator(char c);
-
-  bool                is_unary_operator(char c);
+  static bool                     is_number(char oc,
+                                            char c);
 
-  CalculateReturnCode push(ESPEASY_RULES_FLOAT_TYPE value);
+  static bool                     is_operator(char c);
 
-  ESPEASY_RULES_FLOAT_TYPE              pop();
+  static bool                     is_unary_operator(char c);
 
-  ESPEASY_RULES_FLOAT_TYPE              apply_operator(char   op,
-                                     ESPEASY_RULES_FLOAT_TYPE first,
-                                     ESPEASY_RULES_FLOAT_TYPE second);
+  // Variables bound to a compiled expression are represented by a single character
+  static bool                     is_variable(char c);
 
-  ESPEASY_RULES_FLOAT_TYPE apply_unary_operator(char   op,
-                              ESPEASY_RULES_FLOAT_TYPE first);
+  // Replace the numerical values in a preprocessed expression by variables and store their values in operands.
+  // Return false when the expression cannot be handled this way, e.g. when it has too many values.
+  static bool                     extractOperands(String                 & preprocessed,
+                                                  ESPEASY_RULES_FLOAT_TYPE operands[],
+                                                  uint8_t                & nrOperands);
 
-  //  char              * next_token(char *linep);
+  static ESPEASY_RULES_FLOAT_TYPE apply_operator(char                     op,
+                                                 ESPEASY_RULES_FLOAT_TYPE first,
+                                                 ESPEASY_RULES_FLOAT_TYPE second);
 
-  CalculateReturnCode RPNCalculate(char *token);
+  static ESPEASY_RULES_FLOAT_TYPE apply_unary_operator(char                     op,
+                                                       ESPEASY_RULES_FLOAT_TYPE first);
 
   // operators
   // precedence   operators         associativity
   // 3            !                 right to left
   // 2            * / %             left to right
   // 1            + - ^             left to right
-  int          op_preced(const char c);
+  static int          op_preced(const char c);
 
-  bool         op_left_assoc(const char c);
+  static bool         op_left_assoc(const char c);
 
-  unsigned int op_arg_count(const char c);
+  static unsigned int op_arg_count(const char c);
+
+  // Keep the compiled expression to re-use its allocated memory
+  CompiledExpression _expression;
+
+  CompiledExpression_LRU _cache;
+
+  // Kept to re-use its allocated memory for the cache key
+  String _cacheKey;
 
 public:
 
-  RulesCalculate_t();
+  RulesCalculate_t() = default;
 
   CalculateReturnCode doCalculate(const char *input,
                                   ESPEASY_RULES_FLOAT_TYPE     *result);
 
+  // Calculate an expression which has not been processed by preProces()
+  // Compiled expressions are kept, so repeated expressions do not need to be parsed again.
+  // This also applies to expressions only differing in their values, e.g. after substituting rules variables.
+  CalculateReturnCode doCalculate(const String            & input,
+                                  ESPEASY_RULES_FLOAT_TYPE& result);
+
   // Try to replace multi byte operators with single character ones.
   // For example log, sin, cos, tan.
   static String preProces(const String& input);
+
+  static void   preProcesInPlace(String& input);
 };
 
 
@@ -4,6 +4,7 @@
 #include "../../_Plugin_Helper.h"
 
 #include "../DataStructs/Scheduler_IntendedRebootTimerID.h"
+#include "../DataStructs/SchedulerTimerStats.h"
 #include "../DataStructs/TimingStats.h"
 
 #include "../ESPEasyCore/ESPEasyRules.h"
@@ -38,6 +39,17 @@ void ESPEasy_Scheduler::handle_schedule() {
   unsigned long mixed_id = 0;
 
   if (timePassedSince(last_system_event_run) < 500) {
+    if (!Continuations.empty()) {
+      // Alternate continuations with timers which are due, so neither can starve the other.
+      if (continuation_turn || !msecTimerHandler.isTimerDue()) {
+        continuation_turn = false;
+        process_continuation();
+        STOP_TIMER(HANDLE_SCHEDULER_CONTINUATION);
+        return;
+      }
+      continuation_turn = true;
+    }
+
     // Make sure system event queue will be looked at every now and then.
     mixed_id = msecTimerHandler.getNextId(timer);
   }
@@ -65,6 +77,15 @@ void ESPEasy_Scheduler::handle_schedule() {
 
   delay(0); // See: https://github.com/letscontrolit/ESPEasy/issues/1818#issuecomment-425351328
 
+#if FEATURE_TIMING_STATS
+  // How late the timer is handled compared to its scheduled time
+  const long     lateness_msec = timePassedSince(timer);
+  const uint64_t dispatchStart = getMicros64();
+#endif // if FEATURE_TIMING_STATS
+
+  slice_start_usec = getMicros64();
+  slice_active     = true;
+
   switch (timerID.getTimerType()) {
     case SchedulerTimerType_e::ConstIntervalTimer:
       process_interval_timer(timerID, timer);
@@ -92,6 +113,10 @@ void ESPEasy_Scheduler::handle_schedule() {
       // - IntendedReboot is just used to mark the intended reboot reason in RTC.
       break;
   }
+  slice_active = false;
+#if FEATURE_TIMING_STATS
+  addSchedulerTimerStat(getSchedulerTimerStatsKey(timerID), lateness_msec, dispatchStart);
+#endif // if FEATURE_TIMING_STATS
   STOP_TIMER(HANDLE_SCHEDULER_TASK);
 }
 
@@ -4,6 +4,7 @@
 #include "../../ESPEasy_common.h"
 
 #include "../DataStructs/EventStructCommandWrapper.h"
+#include "../DataStructs/SchedulerContinuation.h"
 #include "../DataStructs/SchedulerTimerID.h"
 #include "../DataStructs/SystemTimerStruct.h"
 
@@ -284,6 +285,23 @@ void                 setPluginTaskTimer(unsigned long msecFromNow,
   void process_system_event_queue();
 
 
+  /*********************************************************************************************\
+  * Time budgeted execution
+  * Each action handled by handle_schedule() gets a time budget of SCHEDULER_SLICE_BUDGET_USEC.
+  * Long running work which can be split up should check sliceBudgetExceeded()
+  * and queue the remaining work via schedule_continuation().
+  * Continuations are handled before scheduled timers, alternating with timers which are due.
+  \*********************************************************************************************/
+  bool sliceBudgetExceeded() const;
+
+  // Note, the event will be moved
+  void schedule_continuation(SchedulerContinuation_fp fp,
+                             struct EventStruct    && event,
+                             uint32_t                 state);
+
+  void process_continuation();
+
+
   /*********************************************************************************************\
   * Statistics
   \*********************************************************************************************/
@@ -306,6 +324,12 @@ private:
 
   std::list<EventStructCommandWrapper>ScheduledEventQueue;
 
+  std::list<SchedulerContinuation>Continuations;
+
+  uint64_t      slice_start_usec              = 0;
+  bool          slice_active                  = false;
+  bool          continuation_turn             = true;
+
   unsigned long last_system_event_run         = 0;
   unsigned long timer_gratuitous_arp_interval = 5000;
 };
@@ -0,0 +1,56 @@
+#include "../Helpers/Scheduler.h"
+
+#include "../Helpers/ESPEasy_time_calc.h"
+
+
+/*********************************************************************************************\
+* Time budgeted execution
+\*********************************************************************************************/
+bool ESPEasy_Scheduler::sliceBudgetExceeded() const {
+#if SCHEDULER_SLICE_BUDGET_USEC > 0
+
+  if (!slice_active) {
+    // Not called from a scheduled action, so not able to continue later.
+    return false;
+  }
+  return usecPassedSince(slice_start_usec) > SCHEDULER_SLICE_BUDGET_USEC;
+#else // if SCHEDULER_SLICE_BUDGET_USEC > 0
+  return false;
+#endif // if SCHEDULER_SLICE_BUDGET_USEC > 0
+}
+
+void ESPEasy_Scheduler::schedule_continuation(
+  SchedulerContinuation_fp fp,
+  struct EventStruct    && event,
+  uint32_t                 state) {
+  if (fp == nullptr) { return; }
+
+  // Make sure emplace_back is not done on the 2nd heap
+  #ifdef USE_SECOND_HEAP
+  HeapSelectDram ephemeral;
+  #endif // ifdef USE_SECOND_HEAP
+  Continuations.emplace_back(fp, std::move(event), state);
+}
+
+void ESPEasy_Scheduler::process_continuation() {
+  if (Continuations.empty()) { return; }
+
+  #ifdef USE_SECOND_HEAP
+  HeapSelectDram ephemeral;
+  #endif // ifdef USE_SECOND_HEAP
+
+  slice_start_usec = getMicros64();
+  slice_active     = true;
+
+  SchedulerContinuation& continuation = Continuations.front();
+  const bool done                     = continuation.fp(continuation.event, continuation.state);
+
+  slice_active = false;
+
+  if (done) {
+    Continuations.pop_front();
+  } else if (Continuations.size() > 1) {
+    // Not yet done, let the other continuations have their turn first.
+    Continuations.splice(Continuations.end(), Continuations, Continuations.begin());
+  }
+}
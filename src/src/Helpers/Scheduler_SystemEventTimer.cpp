@@ -1,6 +1,7 @@
 #include "../Helpers/Scheduler.h"
 
 #include "../DataStructs/Scheduler_SystemEventQueueTimerID.h"
+#include "../DataStructs/SchedulerTimerStats.h"
 #include "../DataStructs/TimingStats.h"
 
 #include "../Globals/CPlugins.h"
@@ -184,6 +185,11 @@ void ESPEasy_Scheduler::process_system_event_queue() {
   // Else the line string could be used.
   String tmpString;
 
+#if FEATURE_TIMING_STATS
+  // Lateness of a system event is the time it has been waiting in the queue.
+  const long lateness_msec = timePassedSince(ScheduledEventQueue.front().queued);
+#endif // if FEATURE_TIMING_STATS
+
   switch (ptr_type) {
     case SchedulerPluginPtrType_e::TaskPlugin:
     {
@@ -218,6 +224,12 @@ void ESPEasy_Scheduler::process_system_event_queue() {
       break;
 #endif // if FEATURE_NOTIFIER
   }
+#if FEATURE_TIMING_STATS
+  addSchedulerTimerStat(
+    getSchedulerTimerStatsKey(timerID),
+    lateness_msec,
+    statisticsTimerStart);
+#endif // if FEATURE_TIMING_STATS
   ScheduledEventQueue.pop_front();
   STOP_TIMER(PROCESS_SYSTEM_EVENT_QUEUE);
 }
@@ -0,0 +1,232 @@
+#include "../Helpers/SettingsWriteBack.h"
+
+#if FEATURE_SETTINGS_WRITE_BACK
+
+# include "../DataStructs/TimingStats.h"
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Helpers/ESPEasy_Storage.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/StringConverter.h"
+
+
+bool SettingsWriteBack::add(const String& fname, int offset, const uint8_t *data, int datasize)
+{
+  if ((offset < 0) || (datasize <= 0) || (data == nullptr)) {
+    return false;
+  }
+
+  if (flashWriteLimitExceeded()) {
+    // Let the caller return the error of flashGuard(), as the data could not be written later.
+    return false;
+  }
+
+  if ((_pendingBytes + datasize) > SETTINGS_WRITE_BACK_MAX_PENDING) {
+    // Write what is pending first, to keep the order of writes.
+    flush();
+
+    if ((_pendingBytes + datasize) > SETTINGS_WRITE_BACK_MAX_PENDING) {
+      return false;
+    }
+  }
+
+  if (!fileExists(fname)) {
+    // Will be created by the caller
+    return false;
+  }
+
+  int fileIndex = find(fname);
+
+  if (fileIndex < 0) {
+    if (_files.empty()) {
+      _firstChange = millis();
+    }
+    _files.emplace_back();
+    _files.back().fname = patch_fname(fname);
+    fileIndex           = _files.size() - 1;
+  }
+  std::vector<Range>& ranges = _files[fileIndex].ranges;
+
+  // Merge with all overlapping and adjacent ranges
+  int  start = offset;
+  int  end   = offset + datasize;
+  auto first = ranges.begin();
+
+  while (first != ranges.end() && (first->offset + static_cast<int>(first->data.size())) < start) {
+    ++first;
+  }
+  auto last = first;
+
+  while (last != ranges.end() && last->offset <= end) {
+    start = std::min(start, last->offset);
+    end   = std::max(end, last->offset + static_cast<int>(last->data.size()));
+    ++last;
+  }
+
+  Range merged;
+  merged.offset = start;
+  merged.data.resize(end - start);
+
+  for (auto it = first; it != last; ++it) {
+    memcpy(&merged.data[it->offset - start], it->data.data(), it->data.size());
+    _pendingBytes -= it->data.size();
+  }
+  memcpy(&merged.data[offset - start], data, datasize);
+  _pendingBytes += merged.data.size();
+
+  ranges.insert(ranges.erase(first, last), std::move(merged));
+
+  _lastChange = millis();
+  ++_nrSaves;
+  return true;
+}
+
+void SettingsWriteBack::applyPending(const String& fname, int offset, uint8_t *memAddress, int datasize) const
+{
+  const int fileIndex = find(fname);
+
+  if (fileIndex < 0) { return; }
+
+  const std::vector<Range>& ranges = _files[fileIndex].ranges;
+
+  for (auto it = ranges.begin(); it != ranges.end(); ++it) {
+    const int start = std::max(offset, it->offset);
+    const int end   = std::min(offset + datasize, it->offset + static_cast<int>(it->data.size()));
+
+    if (start < end) {
+      memcpy(memAddress + (start - offset), &(it->data[start - it->offset]), end - start);
+    }
+  }
+}
+
+bool SettingsWriteBack::isPending(const String& fname) const
+{
+  return find(fname) >= 0;
+}
+
+void SettingsWriteBack::loop()
+{
+  if (_files.empty()) { return; }
+
+  if ((timePassedSince(_lastChange) >= SETTINGS_WRITE_BACK_DELAY) ||
+      (timePassedSince(_firstChange) >= SETTINGS_WRITE_BACK_MAX_DELAY)) {
+    const String err = flush();
+
+    if (!err.isEmpty()) {
+      addLog(LOG_LEVEL_ERROR, concat(F("FILE : Write-back failed, will retry: "), err));
+
+      // Try again after SETTINGS_WRITE_BACK_DELAY
+      _firstChange = millis();
+      _lastChange  = _firstChange;
+    }
+  }
+}
+
+String SettingsWriteBack::flush()
+{
+  String res;
+  size_t index = 0;
+
+  while (index < _files.size()) {
+    const String err = commit(index);
+
+    if (!err.isEmpty()) {
+      // Data is kept in the pending list
+      if (res.isEmpty()) {
+        res = err;
+      }
+      ++index;
+    }
+  }
+  return res;
+}
+
+String SettingsWriteBack::flush(const String& fname)
+{
+  const int fileIndex = find(fname);
+
+  if (fileIndex < 0) {
+    return EMPTY_STRING;
+  }
+  return commit(fileIndex);
+}
+
+void SettingsWriteBack::discard(const String& fname)
+{
+  const int fileIndex = find(fname);
+
+  if (fileIndex < 0) { return; }
+
+  for (auto it = _files[fileIndex].ranges.begin(); it != _files[fileIndex].ranges.end(); ++it) {
+    _pendingBytes -= it->data.size();
+  }
+  _files.erase(_files.begin() + fileIndex);
+}
+
+int SettingsWriteBack::find(const String& fname) const
+{
+  const String patched = patch_fname(fname);
+
+  for (size_t i = 0; i < _files.size(); ++i) {
+    if (_files[i].fname.equalsIgnoreCase(patched)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+String SettingsWriteBack::commit(size_t index)
+{
+  if (index >= _files.size()) {
+    return EMPTY_STRING;
+  }
+
+  START_TIMER;
+
+  // All changes to the file are counted as a single flash write.
+  String err = flashGuard();
+
+  if (!err.isEmpty()) {
+    return err;
+  }
+
+  // Take out of the pending files while writing, as opening the file will otherwise try to flush it again.
+  PendingFile file(std::move(_files[index]));
+
+  _files.erase(_files.begin() + index);
+
+  fs::File f = tryOpenFile(file.fname, F("r+"));
+
+  if (f) {
+    for (auto it = file.ranges.begin(); it != file.ranges.end() && err.isEmpty(); ++it) {
+      err = writeChangedPages(f, file.fname.c_str(), it->offset, it->data.data(), it->data.size(), true);
+    }
+    f.close();
+  } else {
+    err = FileError(__LINE__, file.fname.c_str());
+  }
+
+  if (!err.isEmpty()) {
+    // Keep the pending data, so it is not lost and can be written later.
+    _files.insert(_files.begin() + index, std::move(file));
+    return err;
+  }
+
+  for (auto it = file.ranges.begin(); it != file.ranges.end(); ++it) {
+    _pendingBytes -= it->data.size();
+  }
+  ++_nrCommits;
+  STOP_TIMER(SAVE_SETTINGS_WRITE_BACK);
+
+  # ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLogMove(LOG_LEVEL_INFO, strformat(
+                 F("FILE : Write-back %s, %d ranges"),
+                 file.fname.c_str(),
+                 static_cast<int>(file.ranges.size())));
+  }
+  # endif // ifndef BUILD_NO_DEBUG
+  return err;
+}
+
+#endif // if FEATURE_SETTINGS_WRITE_BACK
@@ -0,0 +1,102 @@
+#ifndef HELPERS_SETTINGSWRITEBACK_H
+#define HELPERS_SETTINGSWRITEBACK_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_SETTINGS_WRITE_BACK
+
+# include <vector>
+
+
+/*********************************************************************************************\
+* SettingsWriteBack
+* Collects the data saved to the settings files (config.dat, security.dat, etc.) in RAM
+* and writes it to the file system when no settings were saved for a short while.
+* Consecutive saves, e.g. task settings followed by the custom task settings and the
+* basic settings, or a number of 'config' commands from rules, then result in a single
+* write per file, only of the pages with changed content.
+*
+* Dirty ranges are kept per file. Overlapping and adjacent ranges are merged,
+* so the last saved data is written.
+*
+* LoadFromFile() combines the file content with the pending data.
+* Any other file access, via tryOpenFile(), first writes the pending data of that file.
+\*********************************************************************************************/
+class SettingsWriteBack {
+public:
+
+  // Keep the data to be saved to fname at offset.
+  // Return false when the data must be written to the file directly.
+  bool   add(const String & fname,
+             int             offset,
+             const uint8_t  *data,
+             int             datasize);
+
+  // Copy the pending data of fname overlapping the given range to memAddress.
+  void   applyPending(const String& fname,
+                      int           offset,
+                      uint8_t      *memAddress,
+                      int           datasize) const;
+
+  bool   isPending(const String& fname) const;
+
+  bool   empty() const {
+    return _files.empty();
+  }
+
+  // Write the pending data when the settings were not changed for a while.
+  void   loop();
+
+  // Write all pending data.
+  // Return the first error, the data which could not be written is kept.
+  String flush();
+
+  // Write the pending data of fname.
+  String flush(const String& fname);
+
+  // Forget the pending data of fname, e.g. when the file is deleted or truncated.
+  void   discard(const String& fname);
+
+  size_t getPendingBytes() const {
+    return _pendingBytes;
+  }
+
+  // Nr of saves collected
+  uint32_t getNrSaves() const {
+    return _nrSaves;
+  }
+
+  // Nr of times a file was written, each counted as a single flash write.
+  uint32_t getNrCommits() const {
+    return _nrCommits;
+  }
+
+private:
+
+  struct Range {
+    int                 offset{};
+    std::vector<uint8_t>data;
+  };
+
+  struct PendingFile {
+    String             fname;
+    std::vector<Range> ranges; // Sorted on offset, not overlapping
+  };
+
+  int    find(const String& fname) const;
+
+  // Write the data of the file and remove it from the pending list.
+  // On error the data is kept in the pending list.
+  String commit(size_t index);
+
+  std::vector<PendingFile>_files;
+  size_t _pendingBytes{};
+  unsigned long _firstChange{};
+  unsigned long _lastChange{};
+  uint32_t _nrSaves{};
+  uint32_t _nrCommits{};
+};
+
+#endif // if FEATURE_SETTINGS_WRITE_BACK
+
+#endif // ifndef HELPERS_SETTINGSWRITEBACK_H
@@ -17,6 +17,8 @@
 #include "../Globals/Plugins.h"
 #include "../Globals/Settings.h"
 
+#include "../Helpers/ArgumentTokenizer.h"
+#include "../Helpers/CompiledTemplate.h"
 #include "../Helpers/Convert.h"
 #include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/Misc.h"
@@ -829,24 +831,24 @@ String to_internal_string(const String& input, char replaceSpace) {
     // FIXME TD-er: parseString* should use index starting at 0.
 \*********************************************************************************************/
 String parseString(const char * string, uint8_t indexFind, char separator, bool trimResult) {
-  return parseString(String(string), indexFind, separator, trimResult);
-}
-
-String parseString(const String& string, uint8_t indexFind, char separator, bool trimResult) {
   String result = parseStringKeepCase(string, indexFind, separator, trimResult);
 
   result.toLowerCase();
   return result;
 }
 
+String parseString(const String& string, uint8_t indexFind, char separator, bool trimResult) {
+  return parseString(string.c_str(), indexFind, separator, trimResult);
+}
+
 String parseStringKeepCaseNoTrim(const String& string, uint8_t indexFind, char separator) {
   return parseStringKeepCase(string, indexFind, separator, false);
 }
 
-String parseStringKeepCase(const String& string, uint8_t indexFind, char separator, bool trimResult) {
+String parseStringKeepCase(const char * string, uint8_t indexFind, char separator, bool trimResult) {
   String result;
 
-  if (!GetArgv(string.c_str(), result, indexFind, separator)) {
+  if (!GetArgv(string, result, indexFind, separator)) {
     return EMPTY_STRING;
   }
   if (trimResult) {
@@ -855,6 +857,10 @@ String parseStringKeepCase(const String& string, uint8_t indexFind, char separat
   return stripQuotes(result);
 }
 
+String parseStringKeepCase(const String& string, uint8_t indexFind, char separator, bool trimResult) {
+  return parseStringKeepCase(string.c_str(), indexFind, separator, trimResult);
+}
+
 String parseStringToEnd(const String& string, uint8_t indexFind, char separator, bool trimResult) {
   String result = parseStringToEndKeepCase(string, indexFind, separator, trimResult);
 
@@ -866,34 +872,29 @@ String parseStringToEndKeepCaseNoTrim(const String& string, uint8_t indexFind, c
   return parseStringToEndKeepCase(string, indexFind, separator, false);
 }
 
-String parseStringToEndKeepCase(const String& string, uint8_t indexFind, char separator, bool trimResult) {
-  // Loop over the arguments to find the first and last pos of the arguments.
-  int  pos_begin = string.length();
-  int  pos_end = pos_begin;
-  int  tmppos_begin, tmppos_end = -1;
-  uint8_t nextArgument = indexFind;
-  bool hasArgument  = false;
-
-  while (GetArgvBeginEnd(string.c_str(), nextArgument, tmppos_begin, tmppos_end, separator))
-  {
-    hasArgument = true;
+String parseStringToEndKeepCase(const char * string, uint8_t indexFind, char separator, bool trimResult) {
+  int  pos_begin, pos_end;
+  bool hasArgument;
 
-    if ((tmppos_begin < pos_begin) && (tmppos_begin >= 0)) {
-      pos_begin = tmppos_begin;
-    }
+  const ArgumentTokenizer *active = ArgumentTokenizer::getActive(string, separator);
 
-    if ((tmppos_end >= 0)) {
-      pos_end = tmppos_end;
-    }
-    ++nextArgument;
+  if (active != nullptr) {
+    hasArgument = active->getBeginEndToEnd(indexFind, pos_begin, pos_end);
+  } else {
+    const ArgumentTokenizer tokenizer(string, separator);
+    hasArgument = tokenizer.getBeginEndToEnd(indexFind, pos_begin, pos_end);
   }
 
-  if (!hasArgument || (pos_begin < 0) || (pos_begin == pos_end)) {
+  if (!hasArgument) {
     return EMPTY_STRING;
   }
 
   String result;
-  move_special(result, string.substring(pos_begin, pos_end));
+
+  if (pos_end > pos_begin) {
+    result.reserve(pos_end - pos_begin);
+    result.concat(string + pos_begin, pos_end - pos_begin);
+  }
 
   if (trimResult) {
     result.trim();
@@ -901,21 +902,25 @@ String parseStringToEndKeepCase(const String& string, uint8_t indexFind, char se
   return stripQuotes(result);
 }
 
+String parseStringToEndKeepCase(const String& string, uint8_t indexFind, char separator, bool trimResult) {
+  return parseStringToEndKeepCase(string.c_str(), indexFind, separator, trimResult);
+}
+
 String tolerantParseStringKeepCase(const char * string,
                                    uint8_t      indexFind,
                                    char         separator,
                                    bool         trimResult)
 {
-  return tolerantParseStringKeepCase(String(string), indexFind, separator, trimResult);
+  if (Settings.TolerantLastArgParse()) {
+    return parseStringToEndKeepCase(string, indexFind, separator, trimResult);
+  }
+  return parseStringKeepCase(string, indexFind, separator, trimResult);
 }
 
 
 String tolerantParseStringKeepCase(const String& string, uint8_t indexFind, char separator, bool trimResult)
 {
-  if (Settings.TolerantLastArgParse()) {
-    return parseStringToEndKeepCase(string, indexFind, separator, trimResult);
-  }
-  return parseStringKeepCase(string, indexFind, separator, trimResult);
+  return tolerantParseStringKeepCase(string.c_str(), indexFind, separator, trimResult);
 }
 
 /*****************************************************************************
@@ -1295,7 +1300,8 @@ void parseSpecialCharacters(String& s, bool useURLencode)
    replace other system variables like %sysname%, %systime%, %ip%
  \*********************************************************************************************/
 void parseControllerVariables(String& s, struct EventStruct *event, bool useURLencode) {
-  s = parseTemplate(s, useURLencode);
+  // Controller templates (topics, URLs, bodies) are used over and over again, so keep them compiled.
+  s = parseTemplate_cached(s, useURLencode);
   parseEventVariables(s, event, useURLencode);
 }
 
@@ -1490,9 +1496,9 @@ void parseStandardConversions(String& s, bool useURLencode) {
    Find positional parameter in a char string
  \*********************************************************************************************/
 bool HasArgv(const char *string, unsigned int argc) {
-  String argvString;
+  int pos_begin, pos_end;
 
-  return GetArgv(string, argvString, argc);
+  return GetArgvBeginEnd(string, argc, pos_begin, pos_end);
 }
 
 bool GetArgv(const char *string, String& argvString, unsigned int argc, char separator) {
@@ -1513,73 +1519,10 @@ bool GetArgv(const char *string, String& argvString, unsigned int argc, char sep
 }
 
 bool GetArgvBeginEnd(const char *string, const unsigned int argc, int& pos_begin, int& pos_end, char separator) {
-  pos_begin = -1;
-  pos_end   = -1;
-  if (string == nullptr) {
-    return false;
-  }
-  size_t string_len = strlen(string);
-  unsigned int string_pos = 0, argc_pos = 0;
-  bool parenthesis          = false;
-  char matching_parenthesis = '"';
-
-  while (string_pos < string_len)
-  {
-    char c, d, e; // c = current char, d,e = next char (if available)
-    c = string[string_pos];
-    d = 0;
-    e = 0;
+  const ArgumentTokenizer *active = ArgumentTokenizer::getActive(string, separator);
 
-    if ((string_pos + 1) < string_len) {
-      d = string[string_pos + 1];
-    }
-    if ((string_pos + 2) < string_len) {
-      e = string[string_pos + 2];
-    }
-
-    if  (!parenthesis && (((c == ' ') && (d == ' ')) || 
-                          ((c == separator) && (d == ' ')))) {
-      // Consider multiple consequitive spaces as one.
-    }
-    else if  (!parenthesis && ((d == ' ') && (e == separator))) {
-      // Skip the space.      
-    }
-    else
-    {
-      // Found the start of the new argument.
-      if (pos_begin == -1 && !parenthesis && !((c == separator) || isParameterSeparatorChar(c))) {
-        pos_begin = string_pos;
-        pos_end   = string_pos;
-      }
-      if (pos_end != -1) {
-        ++pos_end;
-      }
-
-      // Check if we're in a set of parenthesis (any quote char or [])
-      if (!parenthesis && (isQuoteChar(c) || (c == '['))) {
-        parenthesis          = true;
-        matching_parenthesis = c;
-
-        if (c == '[') {
-          matching_parenthesis = ']';
-        }
-      } else if (parenthesis && (c == matching_parenthesis)) {
-        parenthesis = false;
-      }
-
-      if (!parenthesis && (isParameterSeparatorChar(d) || (d == separator) || (d == 0))) // end of word
-      {
-        argc_pos++;
-        if (argc_pos == argc)
-        {
-          return true;
-        }
-        // new Argument separator found
-        pos_begin = -1;
-        pos_end   = -1;
-      }
-    }
-    string_pos++;
+  if (active != nullptr) {
+    return active->getBeginEnd(argc, pos_begin, pos_end);
   }
-  return false;
+  return ArgumentTokenizer::findArgument(string, argc, pos_begin, pos_end, separator);
 }
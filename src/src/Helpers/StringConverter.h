@@ -286,6 +286,11 @@ String parseString(const String& string,
                    char          separator = ',',
                    bool          trimResult = true);
 
+String parseStringKeepCase(const char *  string,
+                           uint8_t       indexFind,
+                           char          separator = ',',
+                           bool          trimResult = true);
+
 String parseStringKeepCase(const String& string,
                            uint8_t       indexFind,
                            char          separator = ',',
@@ -300,6 +305,11 @@ String parseStringToEnd(const String& string,
                         char          separator = ',',
                         bool          trimResult = true);
 
+String parseStringToEndKeepCase(const char *  string,
+                                uint8_t       indexFind,
+                                char          separator = ',',
+                                bool          trimResult = true);
+
 String parseStringToEndKeepCase(const String& string,
                                 uint8_t       indexFind,
                                 char          separator = ',',
@@ -78,27 +78,7 @@ String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize, bool us
         uint32_t varNum;
 
         if (validUIntFromString(valueName, varNum)) {
-          unsigned char nr_decimals = maxNrDecimals_fpType(getCustomFloatVar(varNum));
-          bool trimTrailingZeros    = true;
-
-          if (devNameEqInt) {
-            nr_decimals = 0;
-          } else if (!format.isEmpty())
-          {
-            // There is some formatting here, so do not throw away decimals
-            trimTrailingZeros = false;
-          }
-          #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
-          String value = doubleToString(getCustomFloatVar(varNum), nr_decimals, trimTrailingZeros);
-          #else
-          String value = floatToString(getCustomFloatVar(varNum), nr_decimals, trimTrailingZeros);
-          #endif
-          transformValue(
-            newString, 
-            minimal_lineSize, 
-            std::move(value), 
-            format, 
-            tmpString);
+          transformCustomVarValue(newString, minimal_lineSize, varNum, devNameEqInt, format, tmpString);
         }
       }
       else if (equals(deviceName, F("plugin")))
@@ -137,11 +117,7 @@ String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize, bool us
             if (valueNr != VARS_PER_TASK) {
               // here we know the task and value, so find the uservar
               // Try to format and transform the values
-              bool   isvalid;
-              String value = formatUserVar(taskIndex, valueNr, isvalid);
-
-              if (isvalid) {
-                transformValue(newString, minimal_lineSize, std::move(value), format, tmpString);
+              if (transformTaskValue(newString, minimal_lineSize, taskIndex, valueNr, format, tmpString)) {
                 isHandled = true;
               }
             } else {
@@ -603,6 +579,55 @@ void transformValue(
   #endif // ifndef BUILD_NO_RAM_TRACKER
 }
 
+void transformCustomVarValue(
+  String      & newString,
+  uint8_t       lineSize,
+  uint32_t      varNum,
+  bool          asInt,
+  String      & valueFormat,
+  const String& tmpString)
+{
+  unsigned char nr_decimals = maxNrDecimals_fpType(getCustomFloatVar(varNum));
+  bool trimTrailingZeros    = true;
+
+  if (asInt) {
+    nr_decimals = 0;
+  } else if (!valueFormat.isEmpty())
+  {
+    // There is some formatting here, so do not throw away decimals
+    trimTrailingZeros = false;
+  }
+  #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+  String value = doubleToString(getCustomFloatVar(varNum), nr_decimals, trimTrailingZeros);
+  #else
+  String value = floatToString(getCustomFloatVar(varNum), nr_decimals, trimTrailingZeros);
+  #endif
+  transformValue(
+    newString, 
+    lineSize, 
+    std::move(value), 
+    valueFormat, 
+    tmpString);
+}
+
+bool transformTaskValue(
+  String      & newString,
+  uint8_t       lineSize,
+  taskIndex_t   taskIndex,
+  uint8_t       valueNr,
+  String      & valueFormat,
+  const String& tmpString)
+{
+  // Try to format and transform the values
+  bool   isvalid;
+  String value = formatUserVar(taskIndex, valueNr, isvalid);
+
+  if (isvalid) {
+    transformValue(newString, lineSize, std::move(value), valueFormat, tmpString);
+  }
+  return isvalid;
+}
+
 // Find the first (enabled) task with given name
 // Return INVALID_TASK_INDEX when not found, else return taskIndex
 taskIndex_t findTaskIndexByName(String deviceName, bool allowDisabled)
@@ -740,7 +765,7 @@ bool findNextDevValNameInString(const String& input, int& startpos, int& endpos,
 /********************************************************************************************\
    Check to see if a given argument is a valid taskIndex (argc = 0 => command)
  \*********************************************************************************************/
-taskIndex_t parseCommandArgumentTaskIndex(const String& string, unsigned int argc)
+taskIndex_t parseCommandArgumentTaskIndex(const char *string, unsigned int argc)
 {
   taskIndex_t taskIndex = INVALID_TASK_INDEX;
   const int   ti        = parseCommandArgumentInt(string, argc);
@@ -752,10 +777,15 @@ taskIndex_t parseCommandArgumentTaskIndex(const String& string, unsigned int arg
   return taskIndex;
 }
 
+taskIndex_t parseCommandArgumentTaskIndex(const String& string, unsigned int argc)
+{
+  return parseCommandArgumentTaskIndex(string.c_str(), argc);
+}
+
 /********************************************************************************************\
    Get int from command argument (argc = 0 => command)
  \*********************************************************************************************/
-int parseCommandArgumentInt(const String& string, unsigned int argc,
+int parseCommandArgumentInt(const char *string, unsigned int argc,
                             int errorValue)
 {
   int value = 0;
@@ -764,24 +794,39 @@ int parseCommandArgumentInt(const String& string, unsigned int argc,
     // No need to check for the command (argc == 0)
     String TmpStr;
 
-    if (GetArgv(string.c_str(), TmpStr, argc + 1)) {
+    if (GetArgv(string, TmpStr, argc + 1)) {
       value = CalculateParam(TmpStr, errorValue);
     }
   }
   return value;
 }
 
+int parseCommandArgumentInt(const String& string, unsigned int argc,
+                            int errorValue)
+{
+  return parseCommandArgumentInt(string.c_str(), argc, errorValue);
+}
+
 /********************************************************************************************\
    Parse a command string to event struct
  \*********************************************************************************************/
 void parseCommandString(struct EventStruct *event, const String& string)
+{
+  const ArgumentTokenizer tokens(string.c_str());
+
+  parseCommandString(event, tokens);
+}
+
+void parseCommandString(struct EventStruct *event, const ArgumentTokenizer& tokens)
 {
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("parseCommandString"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
-  event->Par1 = parseCommandArgumentInt(string, 1);
-  event->Par2 = parseCommandArgumentInt(string, 2);
-  event->Par3 = parseCommandArgumentInt(string, 3);
-  event->Par4 = parseCommandArgumentInt(string, 4);
-  event->Par5 = parseCommandArgumentInt(string, 5);
+  int *par[] = { &event->Par1, &event->Par2, &event->Par3, &event->Par4, &event->Par5 };
+  String TmpStr;
+
+  for (unsigned int i = 0; i < NR_ELEMENTS(par); ++i) {
+    // Argument 1 is the command
+    *par[i] = tokens.getArgv(i + 2, TmpStr) ? CalculateParam(TmpStr, 0) : 0;
+  }
 }
@@ -4,6 +4,7 @@
 #include "../../ESPEasy_common.h"
 
 #include "../Globals/Plugins.h"
+#include "../Helpers/ArgumentTokenizer.h"
 
 /********************************************************************************************\
    Parse string template
@@ -35,6 +36,25 @@ void transformValue(
   const String& tmpString);
 
 
+// Format custom variable [var#N] or [int#N] and append to newString
+void transformCustomVarValue(
+  String      & newString,
+  uint8_t       lineSize,
+  uint32_t      varNum,
+  bool          asInt,
+  String      & valueFormat,
+  const String& tmpString);
+
+// Format task value and append to newString
+// Return false when the task value is not valid.
+bool transformTaskValue(
+  String      & newString,
+  uint8_t       lineSize,
+  taskIndex_t   taskIndex,
+  uint8_t       valueNr,
+  String      & valueFormat,
+  const String& tmpString);
+
 
 // Find the first (enabled) task with given name
 // Return INVALID_TASK_INDEX when not found, else return taskIndex
@@ -68,6 +88,9 @@ bool findNextDevValNameInString(const String& input,
 /********************************************************************************************\
    Check to see if a given argument is a valid taskIndex (argc = 0 => command)
  \*********************************************************************************************/
+taskIndex_t parseCommandArgumentTaskIndex(const char   *string,
+                                          unsigned int  argc);
+
 taskIndex_t parseCommandArgumentTaskIndex(const String& string,
                                           unsigned int  argc);
 
@@ -75,6 +98,10 @@ taskIndex_t parseCommandArgumentTaskIndex(const String& string,
 /********************************************************************************************\
    Get int from command argument (argc = 0 => command)
  \*********************************************************************************************/
+int parseCommandArgumentInt(const char   *string,
+                            unsigned int  argc,
+                            int errorValue = 0);
+
 int parseCommandArgumentInt(const String& string,
                             unsigned int  argc,
                             int errorValue = 0);
@@ -85,5 +112,8 @@ int parseCommandArgumentInt(const String& string,
 void parseCommandString(struct EventStruct *event,
                         const String      & string);
 
+void parseCommandString(struct EventStruct      *event,
+                        const ArgumentTokenizer& tokens);
+
 
 #endif
\ No newline at end of file
@@ -30,9 +30,12 @@ const __FlashStringHelper * toString(ControllerSettingsStruct::VarType parameter
     case ControllerSettingsStruct::CONTROLLER_MAX_QUEUE_DEPTH:          return  F("Max Queue Depth");        
     case ControllerSettingsStruct::CONTROLLER_MAX_RETRIES:              return  F("Max Retries");            
     case ControllerSettingsStruct::CONTROLLER_FULL_QUEUE_ACTION:        return  F("Full Queue Action");      
+    case ControllerSettingsStruct::CONTROLLER_SPILL_BUDGET:             return  F("Queue Flash Budget");
     case ControllerSettingsStruct::CONTROLLER_ALLOW_EXPIRE:             return  F("Allow Expire");           
     case ControllerSettingsStruct::CONTROLLER_DEDUPLICATE:              return  F("De-duplicate");           
     case ControllerSettingsStruct::CONTROLLER_USE_LOCAL_SYSTEM_TIME:    return  F("Use Local System Time");
+    case ControllerSettingsStruct::CONTROLLER_BATCH_SEND:               return  F("Batch Send");
+    case ControllerSettingsStruct::CONTROLLER_ADAPTIVE_SEND_RATE:       return  F("Adaptive Send Rate");
     
     case ControllerSettingsStruct::CONTROLLER_CHECK_REPLY:              return  F("Check Reply");            
 
@@ -204,6 +207,18 @@ void addControllerParameterForm(const ControllerSettingsStruct& ControllerSettin
       addFormSelector(displayName, internalName, 2, options, nullptr, nullptr, ControllerSettings.DeleteOldest, false);
       break;
     }
+    case ControllerSettingsStruct::CONTROLLER_SPILL_BUDGET:
+    {
+      #if FEATURE_CONTROLLER_QUEUE_SPILL
+      addFormNumericBox(displayName, internalName,
+                        ControllerSettings.spillSegments() * (CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE / 1024),
+                        0,
+                        CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS * (CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE / 1024));
+      addUnit(F("kB"));
+      addFormNote(F("Store messages on the file system when the queue is full. 0 = disabled"));
+      #endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+      break;
+    }
     case ControllerSettingsStruct::CONTROLLER_ALLOW_EXPIRE:
       addFormCheckBox(displayName, internalName, ControllerSettings.allowExpire());
       break;
@@ -213,6 +228,20 @@ void addControllerParameterForm(const ControllerSettingsStruct& ControllerSettin
     case ControllerSettingsStruct::CONTROLLER_USE_LOCAL_SYSTEM_TIME:
       addFormCheckBox(displayName, internalName, ControllerSettings.useLocalSystemTime());
       break;      
+    case ControllerSettingsStruct::CONTROLLER_BATCH_SEND:
+      addFormCheckBox(displayName, internalName, ControllerSettings.batchSend());
+      addFormNote(strformat(
+        F("Collect up to %d messages or wait max. %d msec before sending them in one go"),
+        CONTROLLER_BATCH_MAX_ELEMENTS,
+        CONTROLLER_BATCH_MAX_WAIT));
+      break;
+    case ControllerSettingsStruct::CONTROLLER_ADAPTIVE_SEND_RATE:
+      addFormCheckBox(displayName, internalName, ControllerSettings.adaptiveSendRate());
+      addFormNote(strformat(
+        F("Adjust send interval (%u ... %d msec) from send duration and queue depth. With Batch Send also the messages per run"),
+        ControllerSettings.MinimalTimeBetweenMessages,
+        CONTROLLER_ADAPTIVE_MAX_DELAY));
+      break;
     case ControllerSettingsStruct::CONTROLLER_CHECK_REPLY:
     {
       const __FlashStringHelper * options[2] = {
@@ -335,6 +364,20 @@ void saveControllerParameterForm(ControllerSettingsStruct        & ControllerSet
     case ControllerSettingsStruct::CONTROLLER_FULL_QUEUE_ACTION:
       ControllerSettings.DeleteOldest = getFormItemInt(internalName, ControllerSettings.DeleteOldest);
       break;
+    case ControllerSettingsStruct::CONTROLLER_SPILL_BUDGET:
+    {
+      #if FEATURE_CONTROLLER_QUEUE_SPILL
+      const int segment_kB = CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE / 1024;
+      int budget_kB        = getFormItemInt(internalName, ControllerSettings.spillSegments() * segment_kB);
+
+      if (budget_kB < 0) { budget_kB = 0; }
+      int nrSegments = (budget_kB + segment_kB - 1) / segment_kB;
+
+      if (nrSegments > CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS) { nrSegments = CONTROLLER_QUEUE_SPILL_MAX_SEGMENTS; }
+      ControllerSettings.spillSegments(nrSegments);
+      #endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+      break;
+    }
     case ControllerSettingsStruct::CONTROLLER_ALLOW_EXPIRE:
       ControllerSettings.allowExpire(isFormItemChecked(internalName));
       break;
@@ -344,6 +387,12 @@ void saveControllerParameterForm(ControllerSettingsStruct        & ControllerSet
     case ControllerSettingsStruct::CONTROLLER_USE_LOCAL_SYSTEM_TIME:
       ControllerSettings.useLocalSystemTime(isFormItemChecked(internalName));
       break;
+    case ControllerSettingsStruct::CONTROLLER_BATCH_SEND:
+      ControllerSettings.batchSend(isFormItemChecked(internalName));
+      break;
+    case ControllerSettingsStruct::CONTROLLER_ADAPTIVE_SEND_RATE:
+      ControllerSettings.adaptiveSendRate(isFormItemChecked(internalName));
+      break;
     case ControllerSettingsStruct::CONTROLLER_CHECK_REPLY:
       ControllerSettings.MustCheckReply = getFormItemInt(internalName, ControllerSettings.MustCheckReply);
       break;
@@ -2086,6 +2086,57 @@ constexpr const Plugin_ptr_t PROGMEM Plugin_ptr[] =
 bool _Plugin_init_setupDone = false;
 
 
+// Command prefixes handled by a plugin in PLUGIN_WRITE, separated by '|' and in lower case.
+// PLUGIN_WRITE is only offered to tasks running such a plugin when the command starts with one of these prefixes.
+// Plugins not listed here will be offered all commands which are not handled by a previous task.
+struct Plugin_command_prefixes_t {
+  uint8_t     pluginID;
+  const char *prefixes;
+};
+
+#ifdef USES_P012
+const char P012_command_prefixes[] PROGMEM = "lcd";           // lcd, lcdcmd
+#endif // ifdef USES_P012
+#ifdef USES_P023
+const char P023_command_prefixes[] PROGMEM = "oled";          // oled, oledcmd
+#endif // ifdef USES_P023
+#ifdef USES_P036
+const char P036_command_prefixes[] PROGMEM = "oledframedcmd";
+#endif // ifdef USES_P036
+#ifdef USES_P038
+const char P038_command_prefixes[] PROGMEM = "neo";           // neopixel, neopixelall, neopixelline, etc.
+#endif // ifdef USES_P038
+#ifdef USES_P073
+const char P073_command_prefixes[] PROGMEM = "7d|7output";    // 7dn, 7dt, 7dst, 7output, etc.
+#endif // ifdef USES_P073
+#ifdef USES_P104
+const char P104_command_prefixes[] PROGMEM = "dotmatrix";
+#endif // ifdef USES_P104
+
+constexpr const Plugin_command_prefixes_t PROGMEM Plugin_command_prefixes[] =
+{
+#ifdef USES_P012
+  { 12,  P012_command_prefixes },
+#endif // ifdef USES_P012
+#ifdef USES_P023
+  { 23,  P023_command_prefixes },
+#endif // ifdef USES_P023
+#ifdef USES_P036
+  { 36,  P036_command_prefixes },
+#endif // ifdef USES_P036
+#ifdef USES_P038
+  { 38,  P038_command_prefixes },
+#endif // ifdef USES_P038
+#ifdef USES_P073
+  { 73,  P073_command_prefixes },
+#endif // ifdef USES_P073
+#ifdef USES_P104
+  { 104, P104_command_prefixes },
+#endif // ifdef USES_P104
+  { 0,   nullptr } // Keep as last one, to never have an empty array
+};
+
+
 constexpr size_t DeviceIndex_to_Plugin_id_size = NR_ELEMENTS(DeviceIndex_to_Plugin_id);
 
 // Lowest plugin ID included in the build
@@ -2211,6 +2262,43 @@ boolean PluginCall(deviceIndex_t deviceIndex, uint8_t function, struct EventStru
   return false;
 }
 
+bool Plugin_acceptsCommand(pluginID_t pluginID, const String& command)
+{
+  for (size_t i = 0; i < NR_ELEMENTS(Plugin_command_prefixes); ++i) {
+    Plugin_command_prefixes_t entry;
+    memcpy_P(&entry, &Plugin_command_prefixes[i], sizeof(entry));
+
+    if ((entry.prefixes != nullptr) && (entry.pluginID == pluginID.value)) {
+      // Check each prefix
+      const char *prefix = entry.prefixes;
+      size_t pos         = 0;
+      bool   match       = true;
+
+      while (true) {
+        const char c = pgm_read_byte(prefix++);
+
+        if ((c == '|') || (c == '\0')) {
+          if (match) { return true; }
+
+          if (c == '\0') { return false; }
+
+          // Next prefix
+          pos   = 0;
+          match = true;
+        } else {
+          if (match) {
+            match = (pos < command.length()) && (tolower(command[pos]) == c);
+          }
+          ++pos;
+        }
+      }
+    }
+  }
+
+  // Plugin did not register any command prefix
+  return true;
+}
+
 void PluginSetup()
 {
   if (_Plugin_init_setupDone) return;
@@ -20,6 +20,10 @@ deviceIndex_t getDeviceIndex_sorted(deviceIndex_t deviceIndex);
 
 boolean PluginCall(deviceIndex_t deviceIndex, uint8_t function, struct EventStruct *event, String& string);
 
+// Check whether a plugin may handle the command in PLUGIN_WRITE, based on the command prefixes registered for the plugin.
+// Returns true when no command prefixes are registered for the plugin.
+bool Plugin_acceptsCommand(pluginID_t pluginID, const String& command);
+
 // Get the sizeof() in number of bits for the number of actually included plugins in the build
 unsigned getNrBitsDeviceIndex();
 unsigned getNrBuiltInDeviceIndex();
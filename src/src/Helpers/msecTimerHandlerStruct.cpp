@@ -6,10 +6,15 @@
 
 #define MAX_SCHEDULER_WAIT_TIME 50 // Max delay used in the scheduler for passing idle time.
 
+// Heap positions are stored as uint16_t (+1) in the index, which must have at least 2x the slots.
+#define MSEC_TIMER_HANDLER_MAX_SIZE  (UINT16_MAX / 2)
+
   msecTimerHandlerStruct::msecTimerHandlerStruct() : get_called(0), get_called_ret_id(0), max_queue_length(0),
     last_exec_time_usec(0), total_idle_time_usec(0),  idle_time_pct(0.0f), is_idle(false), eco_mode(true)
   {
     last_log_start_time = millis();
+    _timer_heap.reserve(MSEC_TIMER_HANDLER_INITIAL_SIZE);
+    rebuildIndex(2 * MSEC_TIMER_HANDLER_INITIAL_SIZE);
   }
 
   void msecTimerHandlerStruct::setEcoMode(bool enabled) {
@@ -17,14 +22,51 @@
   }
 
   void msecTimerHandlerStruct::registerAt(unsigned long id, unsigned long timer) {
-    timer_id_couple item(id, timer);
+    if (id == 0) { return; }
+
+    // Make sure only one is present with the same id.
+    const uint16_t slot = findSlot(id);
+
+    if (_timer_index[slot] != 0) {
+      // Reschedule existing timer
+      const size_t pos     = _timer_index[slot] - 1;
+      timer_entry& entry   = _timer_heap[pos];
+      const bool   earlier = timeDiff(entry._timer, timer) < 0;
+
+      entry._timer    = timer;
+      entry._sequence = ++_sequence;
+
+      if (earlier) {
+        siftUp(pos);
+      } else {
+        siftDown(pos);
+        siftUp(pos);
+      }
+      return;
+    }
+
+    if (!reserve()) { return; }
+
+    timer_entry entry;
 
-    insert(item);
+    entry._id       = id;
+    entry._timer    = timer;
+    entry._sequence = ++_sequence;
+
+    // Index may have been rebuilt, so look up the slot again.
+    entry._slot = findSlot(id);
+    _timer_heap.emplace_back(entry);
+    _timer_index[entry._slot] = _timer_heap.size();
+    siftUp(_timer_heap.size() - 1);
   }
 
   void msecTimerHandlerStruct::remove(unsigned long id) {
-    timer_id_couple item(id, 0);
-    remove(item);
+    if (id == 0) { return; }
+    const uint16_t slot = findSlot(id);
+
+    if (_timer_index[slot] != 0) {
+      removeAt(_timer_index[slot] - 1);
+    }
   }
 
   // Check if timeout has been reached and also return its set timer.
@@ -32,7 +74,7 @@
   unsigned long msecTimerHandlerStruct::getNextId(unsigned long& timer) {
     ++get_called;
 
-    if (_timer_ids.empty()) {
+    if (_timer_heap.empty()) {
       recordIdle();
 
       if (eco_mode) {
@@ -40,8 +82,8 @@
       }
       return 0;
     }
-    timer_id_couple item = _timer_ids.front();
-    const long passed    = timePassedSince(item._timer);
+    const timer_entry& item = _timer_heap.front();
+    const long passed       = timePassedSince(item._timer);
 
     if (passed < 0) {
       // No timeOutReached
@@ -61,24 +103,30 @@
       return 0;
     }
     recordRunning();
-    unsigned long size = _timer_ids.size();
+    unsigned long size = _timer_heap.size();
 
     if (size > max_queue_length) { max_queue_length = size; }
-    _timer_ids.pop_front();
+    const unsigned long id = item._id;
     timer = item._timer;
+    removeAt(0);
     ++get_called_ret_id;
-    return item._id;
+    return id;
   }
 
+  bool msecTimerHandlerStruct::isTimerDue() const {
+    if (_timer_heap.empty()) { return false; }
+    return timePassedSince(_timer_heap.front()._timer) >= 0;
+  }
 
   bool msecTimerHandlerStruct::getTimerForId(unsigned long id, unsigned long& timer) const {
-    for (auto it = _timer_ids.begin(); it != _timer_ids.end(); ++it) {
-      if (it->_id == id) {
-        timer = it->_timer;
-        return true;
-      }
+    if (id == 0) { return false; }
+    const uint16_t slot = findSlot(id);
+
+    if (_timer_index[slot] == 0) {
+      return false;
     }
-    return false;
+    timer = _timer_heap[_timer_index[slot] - 1]._timer;
+    return true;
   }
 
   String msecTimerHandlerStruct::getQueueStats() {
@@ -110,38 +158,139 @@
     return idle_time_pct;
   }
 
-  struct match_id {
-    match_id(unsigned long id) : _id(id) {}
+  bool msecTimerHandlerStruct::isBefore(const timer_entry& a, const timer_entry& b) {
+    // timediff < 0, means timer a is set before timer b
+    const long diff = timeDiff(b._timer, a._timer);
 
-    bool operator()(const timer_id_couple& item) {
-      return _id == item._id;
+    if (diff != 0) {
+      return diff < 0;
     }
 
-    unsigned long _id;
-  };
+    // Timers set for the same time, the last one set is handled first.
+    return static_cast<int32_t>(a._sequence - b._sequence) > 0;
+  }
 
-  void msecTimerHandlerStruct::insert(const timer_id_couple& item) {
-    if (item._id == 0) { return; }
+  uint16_t msecTimerHandlerStruct::findSlot(unsigned long id) const {
+    const uint32_t mask = _timer_index.size() - 1;
 
-    // Make sure only one is present with the same id.
-    _timer_ids.remove_if(match_id(item._id));
-    const bool mustSort = !_timer_ids.empty();
-    _timer_ids.push_front(item);
+    // Mix the bits, as the timer ID has the timer type in the lower bits.
+    uint32_t hash = id;
+
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3b;
+    hash ^= hash >> 16;
 
-    if (mustSort) {
-      _timer_ids.sort(); // TD-er: Must check if this is an expensive operation.
+    uint32_t slot = hash & mask;
+
+    while (_timer_index[slot] != 0 && _timer_heap[_timer_index[slot] - 1]._id != id) {
+      slot = (slot + 1) & mask;
     }
+    return slot;
+  }
+
+  void msecTimerHandlerStruct::removeAt(size_t pos) {
+    const uint32_t mask = _timer_index.size() - 1;
+
+    // Remove from the index, using backward shift deletion to keep the probe sequences intact.
+    uint32_t slot = _timer_heap[pos]._slot;
+    uint32_t next = (slot + 1) & mask;
+
+    _timer_index[slot] = 0;
 
-    // It should be a relative light operation, to insert into a sorted list.
-    // Perhaps it is better to use std::set ????
-    // Keep in mind: order is based on timer, uniqueness is based on id.
+    while (_timer_index[next] != 0) {
+      timer_entry& moved = _timer_heap[_timer_index[next] - 1];
+      const uint16_t home = findSlot(moved._id);
+
+      if (home != next) {
+        // An earlier slot became available in the probe sequence of this id.
+        _timer_index[home] = _timer_index[next];
+        _timer_index[next] = 0;
+        moved._slot        = home;
+      }
+      next = (next + 1) & mask;
+    }
+
+    // Move last element to the removed position and restore the heap order.
+    const size_t last = _timer_heap.size() - 1;
+
+    if (pos != last) {
+      place(std::move(_timer_heap[last]), pos);
+      _timer_heap.pop_back();
+      siftDown(pos);
+      siftUp(pos);
+    } else {
+      _timer_heap.pop_back();
+    }
   }
 
-  void msecTimerHandlerStruct::remove(const timer_id_couple& item) {
-    if (item._id == 0) { return; }
+  void msecTimerHandlerStruct::place(timer_entry&& entry, size_t pos) {
+    _timer_index[entry._slot] = pos + 1;
+    _timer_heap[pos]          = std::move(entry);
+  }
 
-    // Make sure only one is present with the same id.
-    _timer_ids.remove_if(match_id(item._id));
+  void msecTimerHandlerStruct::siftUp(size_t pos) {
+    if (pos == 0) { return; }
+    timer_entry entry = _timer_heap[pos];
+
+    while (pos > 0) {
+      const size_t parent = (pos - 1) / 2;
+
+      if (!isBefore(entry, _timer_heap[parent])) {
+        break;
+      }
+      place(std::move(_timer_heap[parent]), pos);
+      pos = parent;
+    }
+    place(std::move(entry), pos);
+  }
+
+  void msecTimerHandlerStruct::siftDown(size_t pos) {
+    const size_t size = _timer_heap.size();
+    timer_entry  entry = _timer_heap[pos];
+
+    while (true) {
+      size_t child = 2 * pos + 1;
+
+      if (child >= size) {
+        break;
+      }
+
+      if (((child + 1) < size) && isBefore(_timer_heap[child + 1], _timer_heap[child])) {
+        ++child;
+      }
+
+      if (!isBefore(_timer_heap[child], entry)) {
+        break;
+      }
+      place(std::move(_timer_heap[child]), pos);
+      pos = child;
+    }
+    place(std::move(entry), pos);
+  }
+
+  bool msecTimerHandlerStruct::reserve() {
+    const size_t size = _timer_heap.size();
+
+    if (size >= MSEC_TIMER_HANDLER_MAX_SIZE) {
+      return false;
+    }
+
+    // Keep the index at most half full.
+    if ((2 * (size + 1)) > _timer_index.size()) {
+      _timer_heap.reserve(2 * size);
+      rebuildIndex(2 * _timer_index.size());
+    }
+    return true;
+  }
+
+  void msecTimerHandlerStruct::rebuildIndex(size_t nrSlots) {
+    _timer_index.assign(nrSlots, 0);
+
+    for (size_t pos = 0; pos < _timer_heap.size(); ++pos) {
+      const uint16_t slot = findSlot(_timer_heap[pos]._id);
+      _timer_index[slot]       = pos + 1;
+      _timer_heap[pos]._slot   = slot;
+    }
   }
 
   void msecTimerHandlerStruct::recordIdle() {
@@ -3,11 +3,27 @@
 
 
 #include "../../ESPEasy_common.h"
-#include <list>
-
-#include "../DataStructs/timer_id_couple.h"
-
-
+#include <vector>
+
+
+// Initial nr of timers which can be scheduled without allocating memory.
+// The timer heap only grows (doubling its size) when more timers are set.
+#ifndef MSEC_TIMER_HANDLER_INITIAL_SIZE
+  # ifdef ESP32
+    #  define MSEC_TIMER_HANDLER_INITIAL_SIZE  128
+  # else
+    #  define MSEC_TIMER_HANDLER_INITIAL_SIZE  64
+  # endif // ifdef ESP32
+#endif // ifndef MSEC_TIMER_HANDLER_INITIAL_SIZE
+
+
+/*********************************************************************************************\
+* TimerHandler Used by the Scheduler
+*
+* Timers are kept in a binary min-heap, ordered by their set time.
+* An open addressing hash table maps the timer ID to its position in the heap,
+* so setting, rescheduling and removing a timer is O(log n) without memory allocations.
+\*********************************************************************************************/
 struct msecTimerHandlerStruct {
   msecTimerHandlerStruct();
 
@@ -22,6 +38,9 @@ struct msecTimerHandlerStruct {
   // Return 0 if no item has reached timeout moment.
   unsigned long getNextId(unsigned long& timer);
 
+  // Check if the first timer has reached its timeout, without removing it.
+  bool          isTimerDue() const;
+
   // Check if a give ID is scheduled and if so, return the set timer.
   // N.B. the ID is the mixed ID.
   bool   getTimerForId(unsigned long  id,
@@ -35,13 +54,42 @@ struct msecTimerHandlerStruct {
 
 private:
 
-  void insert(const timer_id_couple& item);
+  struct timer_entry {
+    unsigned long _id;
+    unsigned long _timer;
+
+    // Insertion order, used to order timers set for the same time.
+    uint32_t _sequence;
+
+    // Slot in the hash table
+    uint16_t _slot;
+  };
+
+  // Return true when a must be handled before b
+  static bool isBefore(const timer_entry& a,
+                       const timer_entry& b);
+
+  // Return the hash table slot holding the id, or the empty slot where it should be stored.
+  uint16_t    findSlot(unsigned long id) const;
 
-  void remove(const timer_id_couple& item);
+  void        removeAt(size_t pos);
 
-  void recordIdle();
+  // Store element at position pos in the heap and update its index.
+  void        place(timer_entry&& entry,
+                    size_t        pos);
 
-  void recordRunning();
+  void        siftUp(size_t pos);
+
+  void        siftDown(size_t pos);
+
+  // Make sure there is room for at least one more timer
+  bool        reserve();
+
+  void        rebuildIndex(size_t nrSlots);
+
+  void        recordIdle();
+
+  void        recordRunning();
 
   // Statistics
   unsigned long get_called;
@@ -56,8 +104,13 @@ private:
   bool          is_idle;
   bool          eco_mode;
 
-  // The list of set timers
-  std::list<timer_id_couple>_timer_ids;
+  uint32_t _sequence = 0;
+
+  // The set timers, as binary heap
+  std::vector<timer_entry>_timer_heap;
+
+  // Hash table with heap position + 1 of the set timers (0 = empty slot)
+  std::vector<uint16_t>_timer_index;
 };
 
 #endif // HELPERS_MSECTIMERHANDLERSTRUCT_H
@@ -110,8 +110,33 @@ void P012_data_struct::lcdWrite(const String& text, uint8_t col, uint8_t row) {
 
 // Perform some specific changes for LCD display
 // https://www.letscontrolit.com/forum/viewtopic.php?t=2368
+void P012_data_struct::loadLineTemplates(taskIndex_t taskIndex) {
+  if (lineTemplatesLoaded) {
+    return;
+  }
+
+  // FIXME TD-er: This is a huge stack allocated object.
+  char deviceTemplate[P12_Nlines][P12_Nchars];
+
+  LoadCustomTaskSettings(taskIndex, reinterpret_cast<uint8_t *>(&deviceTemplate), sizeof(deviceTemplate));
+
+  for (uint8_t x = 0; x < P12_Nlines; x++) {
+    // Make sure the string is terminated
+    deviceTemplate[x][P12_Nchars - 1] = 0;
+    lineTemplates[x].set(String(deviceTemplate[x]));
+  }
+  lineTemplatesLoaded = true;
+}
+
 String P012_data_struct::P012_parseTemplate(String& tmpString, uint8_t lineSize) {
-  String result            = parseTemplate_padded(tmpString, lineSize);
+  return P012_convertLCDchars(parseTemplate_padded(tmpString, lineSize));
+}
+
+String P012_data_struct::P012_parseTemplate(CompiledTemplate& lineTemplate, uint8_t lineSize) {
+  return P012_convertLCDchars(lineTemplate.render(lineSize));
+}
+
+String P012_data_struct::P012_convertLCDchars(String result) const {
   const char degree[3]     = { 0xc2, 0xb0, 0 }; // Unicode degree symbol
   const char degree_lcd[2] = { 0xdf, 0 };       // P012_LCD degree symbol
 
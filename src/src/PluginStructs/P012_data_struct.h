@@ -7,6 +7,11 @@
 
 # include <LiquidCrystal_I2C.h>
 
+# include "../Helpers/CompiledTemplate.h"
+
+# define P12_Nlines 4 // The number of different lines which can be displayed
+# define P12_Nchars 80
+
 struct P012_data_struct : public PluginTaskData_base {
   P012_data_struct(uint8_t addr,
                    uint8_t lcd_size,
@@ -25,9 +30,19 @@ struct P012_data_struct : public PluginTaskData_base {
                 uint8_t       col,
                 uint8_t       row);
 
+  // Load the line templates from the custom task settings.
+  // Only loaded once, as the task data is created again when the settings are saved.
+  void   loadLineTemplates(taskIndex_t taskIndex);
+
   String P012_parseTemplate(String& tmpString,
                             uint8_t lineSize);
 
+  String P012_parseTemplate(CompiledTemplate& lineTemplate,
+                            uint8_t           lineSize);
+
+  // Replace unicode characters by the LCD specific characters
+  String P012_convertLCDchars(String result) const;
+
   void   createCustomChars();
 
 
@@ -36,6 +51,9 @@ struct P012_data_struct : public PluginTaskData_base {
   int               Plugin_012_rows = 2;
   int               Plugin_012_mode = 1;
   uint8_t           displayTimer    = 0;
+
+  CompiledTemplate lineTemplates[P12_Nlines];
+  bool             lineTemplatesLoaded = false;
 };
 
 #endif // ifdef USES_P012
@@ -241,6 +241,15 @@ String P023_data_struct::parseTemplate(String& tmpString, uint8_t lineSize) {
   return result;
 }
 
+String P023_data_struct::parseTemplate(CompiledTemplate& lineTemplate, uint8_t lineSize) {
+  String result             = lineTemplate.render(lineSize);
+  const char degree[3]      = { 0xc2, 0xb0, 0 }; // Unicode degree symbol
+  const char degree_oled[2] = { 0x7F, 0 };       // P023_OLED degree symbol
+
+  result.replace(degree, degree_oled);
+  return result;
+}
+
 void P023_data_struct::resetDisplay() {
   displayOff();
   clearDisplay();
@@ -257,14 +266,19 @@ void P023_data_struct::StartUp_OLED(struct EventStruct *event) {
   // clearDisplay(); // Why clear twice?
   // displayOn();
 
+  String strings[P23_Nlines];
+
   LoadCustomTaskSettings(event->TaskIndex, strings, P23_Nlines, P23_Nchars);
+
+  for (uint8_t x = 0; x < P23_Nlines; ++x) {
+    lineTemplates[x].set(strings[x]);
+  }
 }
 
 bool P023_data_struct::plugin_read(struct EventStruct *event) {
-  for (uint8_t x = 0; x < 8; ++x) {
-    if (strings[x].length()) {
-      String tmp             = strings[x];
-      const String newString = parseTemplate(tmp, 16);
+  for (uint8_t x = 0; x < P23_Nlines; ++x) {
+    if (lineTemplates[x].source().length()) {
+      const String newString = parseTemplate(lineTemplates[x], 16);
 
       sendStrXY(newString.c_str(), x, 0);
       currentLines[x] = newString;
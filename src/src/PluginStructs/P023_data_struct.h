@@ -3,6 +3,7 @@
 
 #include "../../_Plugin_Helper.h"
 #ifdef USES_P023
+# include "../Helpers/CompiledTemplate.h"
 # include "../Helpers/OLed_helper.h"
 
 
@@ -36,6 +37,8 @@ struct P023_data_struct : public PluginTaskData_base {
 
   String parseTemplate(String& tmpString,
                        uint8_t lineSize);
+  String parseTemplate(CompiledTemplate& lineTemplate,
+                       uint8_t           lineSize);
 
   void   resetDisplay();
 
@@ -92,7 +95,7 @@ struct P023_data_struct : public PluginTaskData_base {
 
 private:
 
-  String strings[P23_Nlines]{};
+  CompiledTemplate lineTemplates[P23_Nlines]{};
   String currentLines[P23_Nlines]{};
 };
 
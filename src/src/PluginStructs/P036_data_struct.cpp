@@ -2192,7 +2192,14 @@ String P036_data_struct::P36_parseTemplate(String& tmpString, uint8_t lineIdx) {
   if (tmpString.length() == 0) {
     return EMPTY_STRING;
   }
-  String result = parseTemplate_padded(tmpString, 20);
+  String result;
+
+  if (lineIdx < P36_Nlines) {
+    lineTemplates[lineIdx].set(tmpString);
+    result = lineTemplates[lineIdx].render(20);
+  } else {
+    result = parseTemplate_padded(tmpString, 20);
+  }
 
   result.trim();
 
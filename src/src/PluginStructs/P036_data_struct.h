@@ -3,6 +3,7 @@
 
 #include "../../_Plugin_Helper.h"
 #ifdef USES_P036
+# include "../Helpers/CompiledTemplate.h"
 # include "../Helpers/OLed_helper.h"
 
 # include <SSD1306.h>
@@ -480,6 +481,9 @@ public:
   // CustomTaskSettings
   P036_LineContent *LineContent = nullptr;
 
+  // Compiled line templates, recompiled when the line content is changed
+  CompiledTemplate lineTemplates[P36_Nlines]{};
+
   int8_t lastWiFiState   = 0;
   bool   bDisplayingLogo = false;
 
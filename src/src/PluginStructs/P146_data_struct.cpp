@@ -264,6 +264,10 @@ uint32_t P146_data_struct::sendCSVInBulk(taskIndex_t P146_TaskIndex, uint32_t ma
   while (!done) {
     if (ESP.getFreeHeap() < 5000) {
       done = true;
+    } else if ((nrChunks != 0) && Scheduler.sliceBudgetExceeded()) {
+      // Reading from the cache files takes too long, send what we have now.
+      // Remaining lines will be read for the next message.
+      done = true;
     } else {
       if (!dumper->createCSVLine()) {
         done = true;
@@ -9,6 +9,7 @@
 # include "../WebServer/Markup_Buttons.h"
 # include "../WebServer/Markup_Forms.h"
 
+# include "../ControllerQueue/DelayQueueElements.h"
 # include "../DataStructs/ESPEasy_EventStruct.h"
 
 # include "../ESPEasyCore/Controller.h"
@@ -357,11 +358,48 @@ void handle_controllers_ControllerSettingsPage(controllerIndex_t controllerindex
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MAX_QUEUE_DEPTH);
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MAX_RETRIES);
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_FULL_QUEUE_ACTION);
+            # if FEATURE_CONTROLLER_QUEUE_SPILL
+            addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_SPILL_BUDGET);
+            {
+              const ControllerDelayHandlerStruct *delayHandler = getControllerDelayHandler(controllerindex);
+
+              if ((delayHandler != nullptr) && (!delayHandler->spill.empty() || (delayHandler->spill.getNrDropped() != 0))) {
+                addRowLabel(F("Queued on Flash"));
+                addHtml(strformat(
+                  F("%u messages (%u bytes in %u files, %u writes, %u dropped)"),
+                  static_cast<unsigned>(delayHandler->spill.size()),
+                  static_cast<unsigned>(delayHandler->spill.getFlashSize()),
+                  delayHandler->spill.getNrSegments(),
+                  delayHandler->spill.getNrFlashWrites(),
+                  delayHandler->spill.getNrDropped()));
+              }
+            }
+            # endif // if FEATURE_CONTROLLER_QUEUE_SPILL
 
             if (proto.allowsExpire) {
               addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_ALLOW_EXPIRE);
             }
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_DEDUPLICATE);
+
+            if (proto.allowsBatchSend) {
+              addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_BATCH_SEND);
+            }
+            addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_ADAPTIVE_SEND_RATE);
+
+            if (ControllerSettings->adaptiveSendRate()) {
+              const ControllerDelayHandlerStruct *delayHandler = getControllerDelayHandler(controllerindex);
+
+              if (delayHandler != nullptr) {
+                addRowLabel(F("Effective Send Rate"));
+                addHtml(strformat(
+                  F("%.2f msg/sec (interval: %u msec, max. %u per run, avg. send: %u msec)"),
+                  delayHandler->getEffectiveSendRate(),
+                  delayHandler->getEffectiveTimeBetweenMessages(),
+                  static_cast<unsigned>(delayHandler->getBatchSize()),
+                  delayHandler->getAvgSendDuration()));
+                addFormNote(F("Updated on load of this page"));
+              }
+            }
           }
 
           if (proto.usesCheckReply) {
@@ -67,27 +67,24 @@ void handle_log_JSON() {
     addHtml(F("],\n"));
   }
   addHtml(F("\"Entries\": ["));
-  bool logLinesAvailable       = true;
   int  nrEntries               = 0;
   unsigned long firstTimeStamp = 0;
   unsigned long lastTimeStamp  = 0;
-
-  while (logLinesAvailable) {
-    String message;
-    uint8_t loglevel;
-    if (Logging.getNext(logLinesAvailable, lastTimeStamp, message, loglevel)) {
-      addHtml('{');
-      stream_next_json_object_value(F("timestamp"), lastTimeStamp);
-      stream_next_json_object_value(F("text"),  std::move(message));
-      stream_last_json_object_value(F("level"), loglevel);
-      if (logLinesAvailable) {
-        addHtml(',', '\n');
-      }
-      if (nrEntries == 0) {
-        firstTimeStamp = lastTimeStamp;
-      }
-      ++nrEntries;
+  const uint8_t logLevel       = Settings.WebLogLevel;
+  LogEntry_t    entry;
+
+  while (Logging.getNext(LogConsumer_e::WebLog, logLevel, entry)) {
+    if (nrEntries == 0) {
+      firstTimeStamp = entry._timestamp;
+    } else {
+      addHtml(',', '\n');
     }
+    lastTimeStamp = entry._timestamp;
+    addHtml('{');
+    stream_next_json_object_value(F("timestamp"), lastTimeStamp);
+    stream_next_json_object_value(F("text"),      entry._message);
+    stream_last_json_object_value(F("level"),     entry._loglevel);
+    ++nrEntries;
 
     // Do we need to do something here and maybe limit number of lines at once?
   }
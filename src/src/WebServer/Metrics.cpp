@@ -6,6 +6,8 @@
 #include "../ESPEasyCore/ESPEasyWifi.h"
 #include "../../_Plugin_Helper.h"
 #include "../Helpers/ESPEasyStatistics.h"
+#include "../DataStructs/SchedulerTimerStats.h"
+#include "../Globals/HTTPClientPool.h"
 #include "../Static/WebStaticData.h"
 
 #ifdef WEBSERVER_METRICS
@@ -85,6 +87,18 @@ void handle_metrics() {
   // devices
   handle_metrics_devices();
 
+# if FEATURE_HTTP_CLIENT
+
+  // HTTP client connections
+  handle_metrics_http_client();
+# endif // if FEATURE_HTTP_CLIENT
+
+# if FEATURE_TIMING_STATS
+
+  // scheduler timers
+  handle_metrics_scheduler();
+# endif // if FEATURE_TIMING_STATS
+
   TXBuffer.endStream();
 }
 
@@ -135,4 +149,106 @@ void handle_metrics_devices() {
   }
 }
 
+# if FEATURE_HTTP_CLIENT
+void handle_metrics_http_client() {
+  // Requests sent using a new or a kept open (keep-alive) connection
+  addHtml(F("# HELP espeasy_http_client_requests_total Number of HTTP client requests per connection type\n"));
+  addHtml(F("# TYPE espeasy_http_client_requests_total counter\n"));
+  addHtml(F("espeasy_http_client_requests_total{connection=\"new\"} "));
+  addHtmlInt(httpClientPool.getNrRequests() - httpClientPool.getNrReused());
+  addHtml('\n');
+  addHtml(F("espeasy_http_client_requests_total{connection=\"reused\"} "));
+  addHtmlInt(httpClientPool.getNrReused());
+  addHtml('\n');
+
+  addHtml(F("# HELP espeasy_http_client_connections Number of HTTP client connections kept open\n"));
+  addHtml(F("# TYPE espeasy_http_client_connections gauge\n"));
+  addHtml(F("espeasy_http_client_connections "));
+  addHtmlInt(static_cast<uint32_t>(httpClientPool.getNrConnections()));
+  addHtml('\n');
+}
+
+# endif // if FEATURE_HTTP_CLIENT
+
+# if FEATURE_TIMING_STATS
+void handle_metrics_scheduler() {
+  if (!Settings.EnableTimingStats() || schedulerTimerStats.empty()) { return; }
+
+  // Lateness of scheduled timers, as histogram
+  addHtml(F("# HELP espeasy_scheduler_lateness_msec How late a scheduler timer was handled in milliseconds\n"));
+  addHtml(F("# TYPE espeasy_scheduler_lateness_msec histogram\n"));
+
+  for (auto& x : schedulerTimerStats) {
+    const String label = concat(F("timer=\""), getSchedulerTimerStatsName(x.first)) + '"';
+    uint32_t     count = 0;
+
+    for (uint8_t bucket = 0; bucket < SCHEDULER_LATENESS_NR_BUCKETS; ++bucket) {
+      // Prometheus histogram buckets are cumulative
+      count += x.second.getBucketCount(bucket);
+      const uint32_t upperBound = SchedulerTimerStats::getBucketUpperBound(bucket);
+      addHtml(F("espeasy_scheduler_lateness_msec_bucket{"));
+      addHtml(label);
+      addHtml(F(",le=\""));
+
+      if (upperBound == UINT32_MAX) {
+        addHtml(F("+Inf"));
+      } else {
+        addHtmlInt(upperBound);
+      }
+      addHtml(F("\"} "));
+      addHtmlInt(count);
+      addHtml('\n');
+    }
+    addHtml(F("espeasy_scheduler_lateness_msec_sum{"));
+    addHtml(label);
+    addHtml(F("} "));
+    addHtmlInt(x.second.getLatenessTotal());
+    addHtml('\n');
+    addHtml(F("espeasy_scheduler_lateness_msec_count{"));
+    addHtml(label);
+    addHtml(F("} "));
+    addHtmlInt(x.second.getCount());
+    addHtml('\n');
+  }
+
+  // Execution time of the timer handlers
+  addHtml(F("# HELP espeasy_scheduler_exec_usec Execution time of scheduler timer handlers in microseconds\n"));
+  addHtml(F("# TYPE espeasy_scheduler_exec_usec summary\n"));
+
+  for (auto& x : schedulerTimerStats) {
+    const String label = concat(F("timer=\""), getSchedulerTimerStatsName(x.first)) + '"';
+    uint64_t     minVal, maxVal;
+    const uint32_t count = x.second.getExecStats().getMinMax(minVal, maxVal);
+
+    addHtml(F("espeasy_scheduler_exec_usec_sum{"));
+    addHtml(label);
+    addHtml(F("} "));
+    addHtmlInt(static_cast<uint64_t>(x.second.getExecStats().getAvg() * count));
+    addHtml('\n');
+    addHtml(F("espeasy_scheduler_exec_usec_count{"));
+    addHtml(label);
+    addHtml(F("} "));
+    addHtmlInt(count);
+    addHtml('\n');
+  }
+
+  // Max. execution time is not part of a summary, thus a separate metric
+  addHtml(F("# HELP espeasy_scheduler_exec_usec_max Max. execution time of scheduler timer handlers in microseconds\n"));
+  addHtml(F("# TYPE espeasy_scheduler_exec_usec_max gauge\n"));
+
+  for (auto& x : schedulerTimerStats) {
+    const String label = concat(F("timer=\""), getSchedulerTimerStatsName(x.first)) + '"';
+    uint64_t     minVal, maxVal;
+    x.second.getExecStats().getMinMax(minVal, maxVal);
+
+    addHtml(F("espeasy_scheduler_exec_usec_max{"));
+    addHtml(label);
+    addHtml(F("} "));
+    addHtmlInt(maxVal);
+    addHtml('\n');
+  }
+}
+
+# endif // if FEATURE_TIMING_STATS
+
 #endif // WEBSERVER_METRICS
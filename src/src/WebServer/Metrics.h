@@ -8,6 +8,14 @@
 void handle_metrics();
 void handle_metrics_devices();
 
+# if FEATURE_HTTP_CLIENT
+void handle_metrics_http_client();
+# endif // if FEATURE_HTTP_CLIENT
+
+# if FEATURE_TIMING_STATS
+void handle_metrics_scheduler();
+# endif // if FEATURE_TIMING_STATS
+
 #endif    // ifdef WEBSERVER_METRICS
 
 #endif
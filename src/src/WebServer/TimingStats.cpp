@@ -9,11 +9,17 @@
 
 #include "../DataTypes/ESPEasy_plugin_functions.h"
 
+#include "../Globals/Cache.h"
 #include "../Globals/ESPEasy_time.h"
+#include "../Globals/HTTPClientPool.h"
 #include "../Globals/RamTracker.h"
+#include "../Globals/SettingsWriteBack.h"
 
 #include "../Globals/Device.h"
 
+#include "../DataStructs/SchedulerTimerStats.h"
+
+#include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/_Plugin_init.h"
 
 
@@ -50,6 +56,48 @@ void handle_timingstats() {
   addRowLabel(F("Time span"));
   addHtmlFloat(timespan);
   addHtml(F(" sec"));
+  #if FEATURE_HTTP_CLIENT
+  addRowLabel(F("HTTP connection reuse"));
+  addHtml(strformat(
+    F("%u of %u requests (%.1f %%), %u kept open"),
+    static_cast<unsigned>(httpClientPool.getNrReused()),
+    static_cast<unsigned>(httpClientPool.getNrRequests()),
+    httpClientPool.getReuseRatio(),
+    static_cast<unsigned>(httpClientPool.getNrConnections())));
+  #endif // if FEATURE_HTTP_CLIENT
+  {
+    const uint32_t nrHits  = Cache.extraTaskSettings_lru.getNrHits();
+    const uint32_t nrLoads = nrHits + Cache.extraTaskSettings_lru.getNrMisses();
+
+    addRowLabel(F("Task settings cache"));
+    addHtml(strformat(
+      F("%u of %u loads cached (%.1f %%), %u of %u slots used"),
+      static_cast<unsigned>(nrHits),
+      static_cast<unsigned>(nrLoads),
+      nrLoads == 0 ? 0.0f : (100.0f * nrHits) / nrLoads,
+      static_cast<unsigned>(Cache.extraTaskSettings_lru.getNrSlotsUsed()),
+      static_cast<unsigned>(Cache.extraTaskSettings_lru.getNrSlots())));
+  }
+  {
+    const uint32_t nrWritten = getSaveToFilePagesWritten();
+    const uint32_t nrPages   = nrWritten + getSaveToFilePagesSkipped();
+
+    addRowLabel(F("Save File pages"));
+    addHtml(strformat(
+      F("%u of %u pages written (%.1f %%), page size %u"),
+      static_cast<unsigned>(nrWritten),
+      static_cast<unsigned>(nrPages),
+      nrPages == 0 ? 0.0f : (100.0f * nrWritten) / nrPages,
+      static_cast<unsigned>(getSaveToFilePageSize())));
+  }
+  #if FEATURE_SETTINGS_WRITE_BACK
+  addRowLabel(F("Settings write-back"));
+  addHtml(strformat(
+    F("%u saves in %u file writes, %u bytes pending"),
+    static_cast<unsigned>(settingsWriteBack.getNrSaves()),
+    static_cast<unsigned>(settingsWriteBack.getNrCommits()),
+    static_cast<unsigned>(settingsWriteBack.getPendingBytes())));
+  #endif // if FEATURE_SETTINGS_WRITE_BACK
   addRowLabel(F("*"));
   addHtml(F("Duty cycle based on average < 1 msec is highly unreliable"));
   html_end_table();
@@ -168,6 +216,7 @@ long stream_timing_statistics(bool clearStats) {
     pluginStats.clear();
     controllerStats.clear();
     miscStats.clear();
+    schedulerTimerStats.clear();
     timingstats_last_reset = millis();
   }
   return timeSinceLastReset;
@@ -0,0 +1,573 @@
+// Link stubs for the parts of the firmware not compiled into the native rules benchmark.
+// Only the functions referenced from the compiled sources are implemented here,
+// with the minimal behavior needed to run the rules engine on a host.
+
+#include "bench_stubs.h"
+
+#include "../../../src/_Plugin_Helper.h"
+
+#include "Commands/Common.h"
+#include "Commands/ExecuteCommand.h"
+#include "Commands/InternalCommands_decoder.h"
+#include "Commands/Rules.h"
+#include "CustomBuild/CompiletimeDefines.h"
+#include "DataStructs/ProtocolStruct.h"
+#include "DataStructs/TimingStats.h"
+#include "ESPEasyCore/Controller.h"
+#include "ESPEasyCore/ESPEasy_backgroundtasks.h"
+#include "ESPEasyCore/ESPEasy_Log.h"
+#include "ESPEasyCore/ESPEasyNetwork.h"
+#include "ESPEasyCore/Serial.h"
+#include "Globals/CPlugins.h"
+#include "Globals/ESPEasy_time.h"
+#include "Globals/MQTT.h"
+#include "Globals/NetworkState.h"
+#include "Globals/Plugins.h"
+#include "Globals/Statistics.h"
+#include "Globals/WiFi_AP_Candidates.h"
+#include "Helpers/_CPlugin_init.h"
+#include "Helpers/ESPEasy_NVS_Helper.h"
+#include "Helpers/ESPEasy_Storage.h"
+#include "Helpers/Hardware_device_info.h"
+#include "Helpers/Misc.h"
+#include "Helpers/StringGenerator_GPIO.h"
+#include "Helpers/StringParser.h"
+#include "Helpers/StringProvider.h"
+#include "Helpers/SystemVariables.h"
+
+#include <chrono>
+#include <new>
+
+/*********************************************************************************************\
+* Benchmark bookkeeping
+\*********************************************************************************************/
+BenchAllocStats bench_alloc_stats;
+uint8_t bench_log_level = 0;
+std::map<String, uint32_t> bench_command_count;
+std::map<int, unsigned long> bench_rules_timers;
+
+static unsigned long bench_millis = 0;
+
+void bench_set_millis(unsigned long value)
+{
+  bench_millis = value;
+}
+
+void bench_advance_millis(unsigned long msec)
+{
+  bench_millis += msec;
+}
+
+void bench_count_alloc(size_t size)
+{
+  ++bench_alloc_stats.allocCount;
+  bench_alloc_stats.allocBytes += size;
+}
+
+void bench_count_free()
+{
+  ++bench_alloc_stats.freeCount;
+}
+
+void* operator new(size_t size)
+{
+  void *ptr = malloc(size);
+
+  if (ptr == nullptr) { throw std::bad_alloc(); }
+  bench_count_alloc(size);
+  return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+  if (ptr != nullptr) {
+    bench_count_free();
+    free(ptr);
+  }
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+  operator delete(ptr);
+}
+
+/*********************************************************************************************\
+* Arduino core
+\*********************************************************************************************/
+const String emptyString;
+const String EMPTY_STRING;
+EspClass     ESP;
+WiFiClass    WiFi;
+
+unsigned long millis()
+{
+  return bench_millis;
+}
+
+unsigned long micros()
+{
+  return static_cast<unsigned long>(esp_timer_get_time());
+}
+
+int64_t esp_timer_get_time()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void delay(unsigned long ms) {}
+
+void yield() {}
+
+long random(long howbig)
+{
+  return howbig == 0 ? 0 : rand() % howbig;
+}
+
+long random(long howsmall, long howbig)
+{
+  return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall);
+}
+
+uint32_t EspClass::getFreeHeap()
+{
+  return 100000;
+}
+
+uint32_t EspClass::getMaxAllocHeap()
+{
+  return 100000;
+}
+
+uint32_t EspClass::getCycleCount()
+{
+  return static_cast<uint32_t>(esp_timer_get_time());
+}
+
+void* special_calloc(size_t num, size_t size)
+{
+  return calloc(num, size);
+}
+
+bool UsePSRAM()
+{
+  return false;
+}
+
+/*********************************************************************************************\
+* File system, maps the root of the ESPEasy file system onto a host directory
+\*********************************************************************************************/
+uint32_t bench_fs_open_count = 0;
+uint32_t bench_fs_read_count = 0;
+
+static std::string bench_fs_root = ".";
+
+void bench_fs_set_root(const char *path)
+{
+  bench_fs_root = path;
+}
+
+std::string bench_fs_path(const char *path)
+{
+  std::string res = bench_fs_root;
+
+  if (path[0] != '/') { res += '/'; }
+  res += path;
+  return res;
+}
+
+fs::FS ESPEASY_FS;
+
+bool fileExists(const __FlashStringHelper *fname)
+{
+  return fileExists(String(fname));
+}
+
+bool fileExists(const String& fname)
+{
+  return ESPEASY_FS.exists(fname);
+}
+
+fs::File tryOpenFile(const String& fname, const String& mode, FileDestination_e destination)
+{
+  START_TIMER;
+  fs::File f = ESPEASY_FS.open(fname, mode.c_str());
+  STOP_TIMER(TRY_OPEN_FILE);
+  return f;
+}
+
+String LoadTaskSettings(taskIndex_t TaskIndex)
+{
+  ExtraTaskSettings.clear();
+  ExtraTaskSettings.TaskIndex = TaskIndex;
+  return EMPTY_STRING;
+}
+
+/*********************************************************************************************\
+* Logging
+\*********************************************************************************************/
+bool loglevelActiveFor(uint8_t logLevel)
+{
+  return logLevel <= bench_log_level;
+}
+
+void addLog(uint8_t logLevel, const __FlashStringHelper *str)
+{
+  addLog(logLevel, String(str));
+}
+
+void addLog(uint8_t logLevel, const char *line)
+{
+  addLog(logLevel, String(line));
+}
+
+void addLog(uint8_t logLevel, const String& string)
+{
+  if (loglevelActiveFor(logLevel)) {
+    fprintf(stderr, "%lu : %s\n", millis(), string.c_str());
+  }
+}
+
+void addLog(uint8_t logLevel, String&& string)
+{
+  addLog(logLevel, static_cast<const String&>(string));
+}
+
+void addToLogMove(uint8_t logLevel, String&& string)
+{
+  addLog(logLevel, static_cast<const String&>(string));
+}
+
+void addToLog(uint8_t logLevel, const LogFormat_t& logFormat)
+{
+  if (loglevelActiveFor(logLevel)) {
+    String line;
+    LogFormat_t::render(logFormat.data(), logFormat.size(), line);
+    fprintf(stderr, "%lu : %s\n", millis(), line.c_str());
+  }
+}
+
+void serialPrint(const __FlashStringHelper *text) {}
+
+void serialPrint(const String& text) {}
+
+void serialPrintln(const __FlashStringHelper *text) {}
+
+void serialPrintln(const String& text) {}
+
+void serialPrintln() {}
+
+/*********************************************************************************************\
+* Command handling
+* Only the commands used in the benchmark rules are executed, all others are just counted.
+\*********************************************************************************************/
+ExecuteCommandArgs::ExecuteCommandArgs(EventValueSource::Enum source, const char *Line)
+  : _source(source), _Line(Line) {}
+
+ExecuteCommandArgs::ExecuteCommandArgs(EventValueSource::Enum source, const String& Line)
+  : _source(source), _Line(Line) {}
+
+ExecuteCommandArgs::ExecuteCommandArgs(EventValueSource::Enum source, String&& Line)
+  : _source(source), _Line(std::move(Line)) {}
+
+bool ExecuteCommand_all(ExecuteCommandArgs&& args, bool addToQueue)
+{
+  const String cmd = parseString(args._Line, 1);
+
+  ++bench_command_count[cmd];
+
+  // Same preparation as done in ExecuteCommand()
+  args._Line = parseTemplate(args._Line);
+  struct EventStruct TempEvent;
+
+  parseCommandString(&TempEvent, args._Line);
+  TempEvent.Source = args._source;
+
+  switch (match_ESPEasy_internal_command(cmd)) {
+    case ESPEasy_cmd_e::let:
+      Command_Rules_Let(&TempEvent, args._Line.c_str());
+      break;
+    case ESPEasy_cmd_e::event:
+      Command_Rules_Events(&TempEvent, args._Line.c_str());
+      break;
+    case ESPEasy_cmd_e::asyncevent:
+      Command_Rules_Async_Events(&TempEvent, args._Line.c_str());
+      break;
+    case ESPEasy_cmd_e::timerset:
+
+      if (TempEvent.Par2 == 0) {
+        bench_rules_timers.erase(TempEvent.Par1);
+      } else {
+        bench_rules_timers[TempEvent.Par1] = millis() + 1000ul * TempEvent.Par2;
+      }
+      break;
+    default:
+      break;
+  }
+  return true;
+}
+
+const __FlashStringHelper* return_command_success_flashstr()
+{
+  return F("\nOK");
+}
+
+const __FlashStringHelper* return_command_failed_flashstr()
+{
+  return F("\nFailed");
+}
+
+String Command_GetORSetBool(struct EventStruct *event,
+                            const __FlashStringHelper *targetDescription,
+                            const char *Line,
+                            bool *value,
+                            int arg)
+{
+  return EMPTY_STRING;
+}
+
+bool SourceNeedsStatusUpdate(EventValueSource::Enum eventSource)
+{
+  return false;
+}
+
+void backgroundtasks() {}
+
+/*********************************************************************************************\
+* Tasks, plugins and controllers
+* No tasks or controllers are configured in the benchmark.
+\*********************************************************************************************/
+bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
+{
+  return false;
+}
+
+int getValueCountForTask(taskIndex_t taskIndex)
+{
+  return 0;
+}
+
+int checkDeviceVTypeForTask(struct EventStruct *event)
+{
+  return -1;
+}
+
+deviceIndex_t getDeviceIndex_from_TaskIndex(taskIndex_t taskIndex)
+{
+  return INVALID_DEVICE_INDEX;
+}
+
+bool validDeviceIndex(deviceIndex_t index)
+{
+  return false;
+}
+
+String getTaskDeviceName(taskIndex_t TaskIndex)
+{
+  return EMPTY_STRING;
+}
+
+String getTaskValueName(taskIndex_t TaskIndex, uint8_t TaskValueIndex)
+{
+  return EMPTY_STRING;
+}
+
+protocolIndex_t getProtocolIndex_from_ControllerIndex(controllerIndex_t index)
+{
+  return INVALID_PROTOCOL_INDEX;
+}
+
+bool validProtocolIndex(protocolIndex_t index)
+{
+  return false;
+}
+
+bool validCPluginID(cpluginID_t cpluginID)
+{
+  return false;
+}
+
+ProtocolStruct& getProtocolStruct(protocolIndex_t protocolIndex)
+{
+  static ProtocolStruct dummy;
+
+  return dummy;
+}
+
+bool getGPIOPinStateValues(String& str)
+{
+  return false;
+}
+
+/*********************************************************************************************\
+* System state, used by the system variables
+\*********************************************************************************************/
+bool MQTTclient_connected      = false;
+bool P037_MQTTImport_connected = false;
+bool statusNTPInitialized      = false;
+uint8_t lastBootCause          = BOOT_CAUSE_MANUAL_REBOOT;
+
+String getValue(LabelType::Enum label)
+{
+  return EMPTY_STRING;
+}
+
+IPAddress NetworkLocalIP()
+{
+  return IPAddress(192, 168, 1, 2);
+}
+
+uint32_t getChipId()
+{
+  return 0x123456;
+}
+
+float getCPUload()
+{
+  return 0.0f;
+}
+
+int getUptimeMinutes()
+{
+  return millis() / 60000;
+}
+
+const __FlashStringHelper* get_build_date()
+{
+  return F(__DATE__);
+}
+
+const __FlashStringHelper* get_build_time()
+{
+  return F(__TIME__);
+}
+
+String formatSystemBuildNr(uint16_t buildNr)
+{
+  return String(buildNr);
+}
+
+String formatUnitToIPAddress(uint8_t unit, uint8_t formatCode)
+{
+  return EMPTY_STRING;
+}
+
+String getNameForUnit(uint8_t unit)
+{
+  return EMPTY_STRING;
+}
+
+long getAgeForUnit(uint8_t unit)
+{
+  return 0;
+}
+
+uint16_t getBuildnrForUnit(uint8_t unit)
+{
+  return 0;
+}
+
+float getLoadForUnit(uint8_t unit)
+{
+  return 0.0f;
+}
+
+uint8_t getTypeForUnit(uint8_t unit)
+{
+  return 0;
+}
+
+const __FlashStringHelper* getTypeStringForUnit(uint8_t unit)
+{
+  return F("");
+}
+
+ESPEasySerialPort ESPeasySerialType::getSerialType(ESPEasySerialPort typeHint, int receivePin, int transmitPin)
+{
+  return typeHint;
+}
+
+WiFi_AP_Candidate::WiFi_AP_Candidate() {}
+
+WiFi_AP_CandidatesList::WiFi_AP_CandidatesList() {}
+
+WiFi_AP_CandidatesList::~WiFi_AP_CandidatesList() {}
+
+void WiFi_AP_CandidatesList::clearCache() {}
+
+ESPEasy_NVS_Helper::~ESPEasy_NVS_Helper() {}
+
+bool ESPEasy_NVS_Helper::begin(const String& nvs_namespace, bool readOnly)
+{
+  return false;
+}
+
+bool ESPEasy_NVS_Helper::getPreference(const String& key, uint32_t& value)
+{
+  return false;
+}
+
+void ESPEasy_NVS_Helper::setPreference(const String& key, const uint32_t& value) {}
+
+/*********************************************************************************************\
+* Time, the virtual clock starts at midnight
+\*********************************************************************************************/
+ESPEasy_time::ESPEasy_time() {}
+
+uint32_t ESPEasy_time::getUnixTime() const
+{
+  return 1700000000ul + millis() / 1000;
+}
+
+String ESPEasy_time::month_str() const
+{
+  return F("Jan");
+}
+
+String ESPEasy_time::weekday_str() const
+{
+  return F("Mon");
+}
+
+String ESPEasy_time::getTimeString(char delimiter, bool show_seconds, char hour_prefix) const
+{
+  const unsigned long sec = millis() / 1000;
+  char buf[16];
+
+  if (show_seconds) {
+    snprintf(buf, sizeof(buf), "%02lu%c%02lu%c%02lu", (sec / 3600) % 24, delimiter, (sec / 60) % 60, delimiter, sec % 60);
+  } else {
+    snprintf(buf, sizeof(buf), "%02lu%c%02lu", (sec / 3600) % 24, delimiter, (sec / 60) % 60);
+  }
+  return String(buf);
+}
+
+String ESPEasy_time::getTimeString_ampm(char delimiter, bool show_seconds, char hour_prefix) const
+{
+  return getTimeString(delimiter, show_seconds, hour_prefix);
+}
+
+String ESPEasy_time::getDateTimeString_ampm(char dateDelimiter, char timeDelimiter, char dateTimeDelimiter) const
+{
+  return getTimeString(timeDelimiter);
+}
+
+String ESPEasy_time::getTimeZoneOffsetString()
+{
+  return F("+00:00");
+}
+
+int ESPEasy_time::getSecOffset(const String& format)
+{
+  return 0;
+}
+
+String ESPEasy_time::getSunriseTimeString(char delimiter, int secOffset) const
+{
+  return F("06:00");
+}
+
+String ESPEasy_time::getSunsetTimeString(char delimiter, int secOffset) const
+{
+  return F("18:00");
+}
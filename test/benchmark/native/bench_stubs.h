@@ -0,0 +1,33 @@
+#ifndef BENCH_STUBS_H
+#define BENCH_STUBS_H
+
+#include <Arduino.h>
+
+#include <map>
+
+// Interface between the benchmark driver and the link stubs in bench_stubs.cpp
+
+// Virtual clock used by millis()
+void bench_set_millis(unsigned long value);
+void bench_advance_millis(unsigned long msec);
+
+// Heap allocations done via operator new and the String class.
+struct BenchAllocStats {
+  uint64_t allocCount = 0;
+  uint64_t allocBytes = 0;
+  uint64_t freeCount  = 0;
+};
+
+extern BenchAllocStats bench_alloc_stats;
+
+// Log lines are only printed to stderr when at or below this log level.
+extern uint8_t bench_log_level;
+
+// Commands executed by the rules, keyed by lower case command name.
+extern std::map<String, uint32_t> bench_command_count;
+
+// Timers set via "TimerSet", keyed by timer nr, value is the virtual time
+// at which the timer expires.
+extern std::map<int, unsigned long> bench_rules_timers;
+
+#endif // ifndef BENCH_STUBS_H
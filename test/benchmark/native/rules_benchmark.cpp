@@ -0,0 +1,247 @@
+// Host-native benchmark of the rules engine.
+//
+// Replays a mix of events on a virtual clock against the given rules files:
+// - Rules#Timer events for timers set via "TimerSet" in the rules
+// - Clock#Time events once per (virtual) minute
+// - Task value events (via the event queue), e.g. Bench#Value=21.5
+// - Events handled by the test rules in test/benchmark (GPIO#2, Test=...)
+//
+// Reports the number of processed events per second, heap allocations per event
+// and the TimingStats collected by the firmware code.
+
+#include "bench_stubs.h"
+
+#include <FS.h>
+
+#include "DataStructs/TimingStats.h"
+#include "DataTypes/ESPEasyFileType.h"
+#include "ESPEasyCore/ESPEasyRules.h"
+#include "Globals/Cache.h"
+#include "Globals/EventQueue.h"
+#include "Globals/Settings.h"
+
+#include <chrono>
+#include <getopt.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <vector>
+
+#define BENCH_DEFAULT_NR_EVENTS  20000
+#define BENCH_TIME_STEP_MSEC     100
+
+static void usage(const char *name)
+{
+  fprintf(stderr,
+          "Usage: %s [-n nr_events] [-l loglevel] [-u] rules1.txt [rules2.txt ...]\n"
+          "  -n  Number of events to process (default %d)\n"
+          "  -l  Print log lines up to this log level to stderr (default 0 = none)\n"
+          "  -u  Do not use rules caching\n",
+          name, BENCH_DEFAULT_NR_EVENTS);
+}
+
+// Copy the rules files to a temporary directory, using the file names ESPEasy uses.
+static bool setupFileSystem(const std::vector<const char *>& rulesFiles, std::string& fsRoot)
+{
+  char tmpl[] = "/tmp/espeasy_rules_bench_XXXXXX";
+
+  if (mkdtemp(tmpl) == nullptr) {
+    perror("mkdtemp");
+    return false;
+  }
+  fsRoot = tmpl;
+  bench_fs_set_root(tmpl);
+
+  for (size_t i = 0; i < rulesFiles.size() && i < RULESETS_MAX; ++i) {
+    FILE *in = fopen(rulesFiles[i], "rb");
+
+    if (in == nullptr) {
+      perror(rulesFiles[i]);
+      return false;
+    }
+    FILE *out = fopen(bench_fs_path(getRulesFileName(i).c_str()).c_str(), "wb");
+
+    if (out == nullptr) {
+      perror("fopen");
+      fclose(in);
+      return false;
+    }
+    char   buf[512];
+    size_t len;
+
+    while ((len = fread(buf, 1, sizeof(buf), in)) > 0) {
+      fwrite(buf, 1, len, out);
+    }
+    fclose(in);
+    fclose(out);
+  }
+  return true;
+}
+
+static void cleanupFileSystem(const std::string& fsRoot)
+{
+  for (uint8_t i = 0; i < RULESETS_MAX; ++i) {
+    unlink(bench_fs_path(getRulesFileName(i).c_str()).c_str());
+  }
+  rmdir(fsRoot.c_str());
+}
+
+static uint32_t nrRulesProcessingCalls()
+{
+  auto it = miscStats.find(TimingStatsElements::RULES_PROCESSING);
+
+  if (it == miscStats.end()) { return 0; }
+  uint64_t minVal, maxVal;
+
+  return it->second.getMinMax(minVal, maxVal);
+}
+
+// Generate the events for the current (virtual) time step
+static void generateEvents(unsigned long now)
+{
+  // Expired rules timers, processed immediately like the scheduler does.
+  for (auto it = bench_rules_timers.begin(); it != bench_rules_timers.end();) {
+    if (static_cast<long>(now - it->second) >= 0) {
+      String event = F("Rules#Timer=");
+      event += it->first;
+      event += F(",1");
+      it = bench_rules_timers.erase(it);
+      rulesProcessing(event);
+    } else {
+      ++it;
+    }
+  }
+
+  if ((now % 60000) == 0) {
+    // Processed immediately, like done in PeriodicalActions
+    const unsigned long minutes = now / 60000;
+    char buf[32];
+    snprintf(buf, sizeof(buf), "Clock#Time=Mon,%02lu:%02lu", (minutes / 60) % 24, minutes % 60);
+    rulesProcessing(String(buf));
+  }
+
+  if ((now % 1000) == 0) {
+    // Task value events, like sent via createRuleEvents()
+    const unsigned long sec = now / 1000;
+    String event            = F("Bench#Value=");
+    event += String(20.0 + (sec % 50) / 10.0, 2);
+    eventQueue.addMove(std::move(event));
+
+    event  = F("Bench#Counter=");
+    event += sec;
+    eventQueue.addMove(std::move(event));
+  }
+
+  if ((now % 5000) == 0) {
+    const unsigned long step = now / 5000;
+    String event             = F("GPIO#2=");
+    event += step % 2;
+    eventQueue.addMove(std::move(event));
+
+    event  = F("Test=");
+    event += 9 + (step % 3);
+    eventQueue.addMove(std::move(event));
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  uint32_t nrEvents     = BENCH_DEFAULT_NR_EVENTS;
+  bool     rulesCaching = true;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "n:l:uh")) != -1) {
+    switch (opt) {
+      case 'n': nrEvents        = strtoul(optarg, nullptr, 10); break;
+      case 'l': bench_log_level = atoi(optarg); break;
+      case 'u': rulesCaching    = false; break;
+      default:
+        usage(argv[0]);
+        return 1;
+    }
+  }
+
+  if (optind >= argc) {
+    usage(argv[0]);
+    return 1;
+  }
+  std::vector<const char *> rulesFiles(argv + optind, argv + argc);
+  std::string fsRoot;
+
+  if (!setupFileSystem(rulesFiles, fsRoot)) {
+    return 1;
+  }
+
+  Settings.UseRules = true;
+  Settings.OldRulesEngine(true);
+  Settings.EnableRulesCaching(rulesCaching);
+  Settings.EnableTimingStats(true);
+
+  // Initialization, reading the rules files
+  auto start = std::chrono::steady_clock::now();
+
+  checkRuleSets();
+  const double init_usec = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+  miscStats.clear();
+
+  const BenchAllocStats allocStart = bench_alloc_stats;
+  const uint32_t fsReadStart       = bench_fs_read_count;
+
+  eventQueue.add(F("StartTest1"));
+  eventQueue.add(F("StartTest2"));
+  eventQueue.add(F("StartTest3"));
+
+  start = std::chrono::steady_clock::now();
+  unsigned long now = 0;
+
+  while (nrRulesProcessingCalls() < nrEvents) {
+    bench_set_millis(now);
+    generateEvents(now);
+
+    while (processNextEvent()) {}
+    now += BENCH_TIME_STEP_MSEC;
+  }
+  const double run_usec = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  const uint32_t processed = nrRulesProcessingCalls();
+  const uint64_t allocs    = bench_alloc_stats.allocCount - allocStart.allocCount;
+  const uint64_t allocated = bench_alloc_stats.allocBytes - allocStart.allocBytes;
+
+  printf("Rules files          : %zu (%s)\n", rulesFiles.size(), rulesCaching ? "cached" : "not cached");
+  printf("Init (read rules)    : %.0f usec\n", init_usec);
+  printf("Virtual time         : %.1f sec\n", now / 1000.0);
+  printf("Events processed     : %u\n", processed);
+  printf("Run time             : %.0f usec\n", run_usec);
+  printf("Events per second    : %.0f\n", processed / (run_usec / 1000000.0));
+  printf("Allocations per event: %.1f (%.0f bytes)\n",
+         static_cast<double>(allocs) / processed,
+         static_cast<double>(allocated) / processed);
+  printf("File reads per event : %.1f\n", static_cast<double>(bench_fs_read_count - fsReadStart) / processed);
+  printf("\n");
+
+  printf("%-40s %10s %10s %10s %10s %12s\n", "TimingStats", "count", "avg usec", "min usec", "max usec", "total usec");
+
+  for (auto it = miscStats.begin(); it != miscStats.end(); ++it) {
+    uint64_t minVal, maxVal;
+    const uint32_t count = it->second.getMinMax(minVal, maxVal);
+
+    if (count > 0) {
+      printf("%-40s %10u %10.1f %10llu %10llu %12.0f\n",
+             getMiscStatsName(it->first).c_str(),
+             count,
+             it->second.getAvg(),
+             static_cast<unsigned long long>(minVal),
+             static_cast<unsigned long long>(maxVal),
+             it->second.getAvg() * count);
+    }
+  }
+  printf("\n");
+
+  printf("%-40s %10s\n", "Commands", "count");
+
+  for (auto it = bench_command_count.begin(); it != bench_command_count.end(); ++it) {
+    printf("%-40s %10u\n", it->first.c_str(), it->second);
+  }
+
+  cleanupFileSystem(fsRoot);
+  return 0;
+}
@@ -0,0 +1,747 @@
+#ifndef BENCH_STUB_ARDUINO_H
+#define BENCH_STUB_ARDUINO_H
+
+// Minimal host replacement of the Arduino core, just enough to compile the
+// rules engine sources for the native rules benchmark.
+// The String class mimics the memory behavior of the ESP cores
+// (small string optimization, heap allocation on growth) so allocation counts
+// are representative.
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <math.h>
+#include <strings.h>
+#include <climits>
+#include <string>
+#include <utility>
+
+#define PROGMEM
+#define ICACHE_RAM_ATTR
+#define IRAM_ATTR
+#define PGM_P       const char *
+#define PSTR(s)     (s)
+#define FPSTR(p)    (reinterpret_cast<const __FlashStringHelper *>(p))
+#define F(s)        (reinterpret_cast<const __FlashStringHelper *>(PSTR(s)))
+
+#define pgm_read_byte(addr)  (*reinterpret_cast<const uint8_t *>(addr))
+#define pgm_read_word(addr)  (*reinterpret_cast<const uint16_t *>(addr))
+#define pgm_read_dword(addr) (*reinterpret_cast<const uint32_t *>(addr))
+#define pgm_read_ptr(addr)   (*reinterpret_cast<const void * const *>(addr))
+#define strlen_P    strlen
+#define strcmp_P    strcmp
+#define strncmp_P   strncmp
+#define strcasecmp_P strcasecmp
+#define strncasecmp_P strncasecmp
+#define strcpy_P    strcpy
+#define strncpy_P   strncpy
+#define strstr_P    strstr
+#define memcpy_P    memcpy
+#define sprintf_P   sprintf
+#define snprintf_P  snprintf
+#define vsnprintf_P vsnprintf
+
+#define HEX 16
+#define DEC 10
+#define OCT 8
+#define BIN 2
+
+#define LOW  0
+#define HIGH 1
+
+#ifndef PI
+# define PI 3.1415926535897932384626433832795
+#endif // ifndef PI
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define degrees(rad) ((rad) * RAD_TO_DEG)
+#define radians(deg) ((deg) * DEG_TO_RAD)
+
+#define bitRead(value, bit)            (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)             ((value) |= (1UL << (bit)))
+#define bitClear(value, bit)           ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define lowByte(w)                     ((uint8_t)((w) & 0xff))
+#define highByte(w)                    ((uint8_t)((w) >> 8))
+
+typedef uint8_t byte;
+typedef bool    boolean;
+typedef uint16_t word;
+
+using std::min;
+using std::max;
+
+template<typename T, typename L, typename H>
+inline auto constrain(T x, L lo, H hi) -> decltype(x + lo + hi) {
+  return x < lo ? lo : (x > hi ? hi : x);
+}
+
+inline uint16_t makeWord(uint8_t h, uint8_t l) {
+  return (static_cast<uint16_t>(h) << 8) | l;
+}
+
+// Virtual clock, advanced by the benchmark driver.
+unsigned long millis();
+unsigned long micros();
+void          delay(unsigned long ms);
+void          yield();
+int64_t       esp_timer_get_time();
+long          random(long howbig);
+long          random(long howsmall,
+                     long howbig);
+
+// Allocation counters, maintained by the benchmark driver.
+void bench_count_alloc(size_t size);
+void bench_count_free();
+
+class __FlashStringHelper;
+
+class String {
+public:
+
+  String() {
+    init();
+  }
+
+  String(const char *cstr) {
+    init();
+
+    if (cstr) { copy(cstr, strlen(cstr)); }
+  }
+
+  String(const char *cstr, unsigned int length) {
+    init();
+
+    if (cstr) { copy(cstr, length); }
+  }
+
+  String(const __FlashStringHelper *str) : String(reinterpret_cast<const char *>(str)) {}
+
+  String(const String& str) {
+    init();
+    copy(str.c_str(), str.length());
+  }
+
+  String(String&& rval) noexcept {
+    init();
+    move(rval);
+  }
+
+  explicit String(char c) {
+    init();
+    char buf[2] = { c, 0 };
+    copy(buf, 1);
+  }
+
+  explicit String(unsigned char value, unsigned char base = 10) : String(static_cast<unsigned long>(value), base) {}
+  explicit String(int value, unsigned char base = 10) : String(static_cast<long>(value), base) {}
+  explicit String(unsigned int value, unsigned char base = 10) : String(static_cast<unsigned long>(value), base) {}
+
+  explicit String(long value, unsigned char base = 10) {
+    init();
+    char buf[2 + 8 * sizeof(long)];
+
+    if (base == 10) {
+      snprintf(buf, sizeof(buf), "%ld", value);
+    } else {
+      toBase(static_cast<unsigned long>(value), base, buf);
+    }
+    copy(buf, strlen(buf));
+  }
+
+  explicit String(unsigned long value, unsigned char base = 10) {
+    init();
+    char buf[1 + 8 * sizeof(unsigned long)];
+    toBase(value, base, buf);
+    copy(buf, strlen(buf));
+  }
+
+  explicit String(long long value) {
+    init();
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%lld", value);
+    copy(buf, strlen(buf));
+  }
+
+  explicit String(unsigned long long value) {
+    init();
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%llu", value);
+    copy(buf, strlen(buf));
+  }
+
+  explicit String(float value, unsigned char decimalPlaces = 2) : String(static_cast<double>(value), decimalPlaces) {}
+
+  explicit String(double value, unsigned char decimalPlaces = 2) {
+    init();
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
+    copy(buf, strlen(buf));
+  }
+
+  ~String() {
+    invalidate();
+  }
+
+  bool reserve(unsigned int size) {
+    if (size <= capacity()) { return true; }
+    return changeBuffer(size);
+  }
+
+  unsigned int length() const {
+    return _len;
+  }
+
+  bool isEmpty() const {
+    return _len == 0;
+  }
+
+  void clear() {
+    setLen(0);
+  }
+
+  String& operator=(const String& rhs) {
+    if (this != &rhs) { copy(rhs.c_str(), rhs.length()); }
+    return *this;
+  }
+
+  String& operator=(String&& rval) noexcept {
+    if (this != &rval) { move(rval); }
+    return *this;
+  }
+
+  String& operator=(const char *cstr) {
+    if (cstr) { copy(cstr, strlen(cstr)); }
+    else { setLen(0); }
+    return *this;
+  }
+
+  String& operator=(const __FlashStringHelper *str) {
+    return operator=(reinterpret_cast<const char *>(str));
+  }
+
+  String& operator=(char c) {
+    char buf[2] = { c, 0 };
+    copy(buf, 1);
+    return *this;
+  }
+
+  bool concat(const String& str)                  { return concat(str.c_str(), str.length()); }
+  bool concat(const char *cstr)                   { return cstr ? concat(cstr, strlen(cstr)) : false; }
+  bool concat(const char *cstr, unsigned int length);
+  bool concat(const __FlashStringHelper *str)     { return concat(reinterpret_cast<const char *>(str)); }
+  bool concat(char c)                             { return concat(&c, 1); }
+  bool concat(unsigned char num)                  { return concat(String(num)); }
+  bool concat(int num)                            { return concat(String(num)); }
+  bool concat(unsigned int num)                   { return concat(String(num)); }
+  bool concat(long num)                           { return concat(String(num)); }
+  bool concat(unsigned long num)                  { return concat(String(num)); }
+  bool concat(long long num)                      { return concat(String(num)); }
+  bool concat(unsigned long long num)             { return concat(String(num)); }
+  bool concat(float num)                          { return concat(String(num)); }
+  bool concat(double num)                         { return concat(String(num)); }
+
+  template<typename T>
+  String& operator+=(const T& rhs) {
+    concat(rhs);
+    return *this;
+  }
+
+  String& operator+=(const char *cstr) {
+    concat(cstr);
+    return *this;
+  }
+
+  friend String operator+(const String& lhs, const String& rhs)                  { String r(lhs); r.concat(rhs); return r; }
+  friend String operator+(String&& lhs, const String& rhs)                       { lhs.concat(rhs); return std::move(lhs); }
+  friend String operator+(const String& lhs, const char *rhs)                    { String r(lhs); r.concat(rhs); return r; }
+  friend String operator+(String&& lhs, const char *rhs)                         { lhs.concat(rhs); return std::move(lhs); }
+  friend String operator+(const String& lhs, const __FlashStringHelper *rhs)     { String r(lhs); r.concat(rhs); return r; }
+  friend String operator+(String&& lhs, const __FlashStringHelper *rhs)          { lhs.concat(rhs); return std::move(lhs); }
+  friend String operator+(const String& lhs, char rhs)                           { String r(lhs); r.concat(rhs); return r; }
+  friend String operator+(String&& lhs, char rhs)                                { lhs.concat(rhs); return std::move(lhs); }
+  friend String operator+(const String& lhs, int rhs)                            { String r(lhs); r.concat(rhs); return r; }
+  friend String operator+(const String& lhs, unsigned int rhs)                   { String r(lhs); r.concat(rhs); return r; }
+  friend String operator+(const String& lhs, long rhs)                           { String r(lhs); r.concat(rhs); return r; }
+  friend String operator+(const String& lhs, unsigned long rhs)                  { String r(lhs); r.concat(rhs); return r; }
+  friend String operator+(const String& lhs, float rhs)                          { String r(lhs); r.concat(rhs); return r; }
+  friend String operator+(const String& lhs, double rhs)                         { String r(lhs); r.concat(rhs); return r; }
+  friend String operator+(const char *lhs, const String& rhs)                    { String r(lhs); r.concat(rhs); return r; }
+  friend String operator+(const __FlashStringHelper *lhs, const String& rhs)     { String r(lhs); r.concat(rhs); return r; }
+  friend String operator+(char lhs, const String& rhs)                           { String r(lhs); r.concat(rhs); return r; }
+
+  int compareTo(const String& s) const {
+    return strcmp(c_str(), s.c_str());
+  }
+
+  bool equals(const String& s) const {
+    return _len == s._len && compareTo(s) == 0;
+  }
+
+  bool equals(const char *cstr) const {
+    return strcmp(c_str(), cstr ? cstr : "") == 0;
+  }
+
+  bool equals(const __FlashStringHelper *s) const {
+    return equals(reinterpret_cast<const char *>(s));
+  }
+
+  bool equalsIgnoreCase(const String& s) const {
+    return _len == s._len && strcasecmp(c_str(), s.c_str()) == 0;
+  }
+
+  bool equalsIgnoreCase(const __FlashStringHelper *s) const {
+    return strcasecmp(c_str(), reinterpret_cast<const char *>(s)) == 0;
+  }
+
+  bool equalsConstantTime(const String& s) const { return equals(s); }
+
+  bool operator==(const String& rhs) const              { return equals(rhs); }
+  bool operator==(const char *cstr) const               { return equals(cstr); }
+  bool operator==(const __FlashStringHelper *rhs) const { return equals(rhs); }
+  bool operator!=(const String& rhs) const              { return !equals(rhs); }
+  bool operator!=(const char *cstr) const               { return !equals(cstr); }
+  bool operator!=(const __FlashStringHelper *rhs) const { return !equals(rhs); }
+  bool operator<(const String& rhs) const               { return compareTo(rhs) < 0; }
+  bool operator>(const String& rhs) const               { return compareTo(rhs) > 0; }
+  bool operator<=(const String& rhs) const              { return compareTo(rhs) <= 0; }
+  bool operator>=(const String& rhs) const              { return compareTo(rhs) >= 0; }
+
+  bool startsWith(const String& prefix) const {
+    return startsWith(prefix, 0);
+  }
+
+  bool startsWith(const String& prefix, unsigned int offset) const {
+    if ((offset + prefix._len) > _len) { return false; }
+    return strncmp(c_str() + offset, prefix.c_str(), prefix._len) == 0;
+  }
+
+  bool startsWith(const __FlashStringHelper *prefix) const { return startsWith(String(prefix)); }
+
+  bool endsWith(const String& suffix) const {
+    if (_len < suffix._len) { return false; }
+    return strcmp(c_str() + _len - suffix._len, suffix.c_str()) == 0;
+  }
+
+  bool endsWith(const __FlashStringHelper *suffix) const { return endsWith(String(suffix)); }
+
+  char charAt(unsigned int index) const {
+    return operator[](index);
+  }
+
+  void setCharAt(unsigned int index, char c) {
+    if (index < _len) { wbuffer()[index] = c; }
+  }
+
+  char operator[](unsigned int index) const {
+    if (index >= _len) { return 0; }
+    return c_str()[index];
+  }
+
+  char& operator[](unsigned int index) {
+    static char dummy_writable_char;
+
+    if (index >= _len) {
+      dummy_writable_char = 0;
+      return dummy_writable_char;
+    }
+    return wbuffer()[index];
+  }
+
+  void getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index = 0) const {
+    if (!bufsize || !buf) { return; }
+
+    if (index >= _len) {
+      buf[0] = 0;
+      return;
+    }
+    unsigned int n = bufsize - 1;
+
+    if (n > _len - index) { n = _len - index; }
+    memcpy(buf, c_str() + index, n);
+    buf[n] = 0;
+  }
+
+  void toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const {
+    getBytes(reinterpret_cast<unsigned char *>(buf), bufsize, index);
+  }
+
+  const char* c_str() const {
+    return _heap ? _ptr : _sso;
+  }
+
+  char* begin() {
+    return wbuffer();
+  }
+
+  char* end() {
+    return wbuffer() + _len;
+  }
+
+  const char* begin() const {
+    return c_str();
+  }
+
+  const char* end() const {
+    return c_str() + _len;
+  }
+
+  int indexOf(char ch, unsigned int fromIndex = 0) const {
+    if (fromIndex >= _len) { return -1; }
+    const char *temp = strchr(c_str() + fromIndex, ch);
+
+    if (temp == nullptr) { return -1; }
+    return temp - c_str();
+  }
+
+  int indexOf(const String& str, unsigned int fromIndex = 0) const {
+    if (fromIndex >= _len) { return -1; }
+    const char *found = strstr(c_str() + fromIndex, str.c_str());
+
+    if (found == nullptr) { return -1; }
+    return found - c_str();
+  }
+
+  int indexOf(const __FlashStringHelper *str, unsigned int fromIndex = 0) const {
+    return indexOf(String(str), fromIndex);
+  }
+
+  int indexOf(const char *str, unsigned int fromIndex = 0) const {
+    return indexOf(String(str), fromIndex);
+  }
+
+  int lastIndexOf(char ch) const {
+    return lastIndexOf(ch, _len - 1);
+  }
+
+  int lastIndexOf(char ch, unsigned int fromIndex) const {
+    if (fromIndex >= _len) { return -1; }
+
+    for (int i = fromIndex; i >= 0; --i) {
+      if (c_str()[i] == ch) { return i; }
+    }
+    return -1;
+  }
+
+  int lastIndexOf(const String& str) const {
+    return lastIndexOf(str, _len - str._len);
+  }
+
+  int lastIndexOf(const String& str, unsigned int fromIndex) const {
+    if ((str._len == 0) || (_len == 0) || (str._len > _len)) { return -1; }
+
+    if (fromIndex >= _len) { fromIndex = _len - 1; }
+    int found = -1;
+
+    for (const char *p = c_str(); p <= c_str() + fromIndex; p++) {
+      p = strstr(p, str.c_str());
+
+      if (!p) { break; }
+
+      if (static_cast<unsigned int>(p - c_str()) <= fromIndex) { found = p - c_str(); }
+    }
+    return found;
+  }
+
+  String substring(unsigned int beginIndex) const {
+    return substring(beginIndex, _len);
+  }
+
+  String substring(unsigned int left, unsigned int right) const {
+    if (left > right) { std::swap(left, right); }
+
+    if (left >= _len) { return String(); }
+
+    if (right > _len) { right = _len; }
+    return String(c_str() + left, right - left);
+  }
+
+  void replace(char find, char replace) {
+    for (char *p = begin(); p != end(); ++p) {
+      if (*p == find) { *p = replace; }
+    }
+  }
+
+  void replace(const String& find, const String& replace);
+  void replace(const __FlashStringHelper *find, const String& replace) { this->replace(String(find), replace); }
+  void replace(const __FlashStringHelper *find, const __FlashStringHelper *replace) { this->replace(String(find), String(replace)); }
+  void replace(const String& find, const __FlashStringHelper *replace) { this->replace(find, String(replace)); }
+  void replace(const char *find, const String& replace) { this->replace(String(find), replace); }
+  void replace(const char *find, const char *replace) { this->replace(String(find), String(replace)); }
+
+  void remove(unsigned int index) {
+    remove(index, static_cast<unsigned int>(-1));
+  }
+
+  void remove(unsigned int index, unsigned int count) {
+    if (index >= _len) { return; }
+
+    if (count <= 0) { return; }
+
+    if (count > _len - index) { count = _len - index; }
+    char *writeTo = wbuffer() + index;
+    memmove(writeTo, wbuffer() + index + count, _len - index - count);
+    setLen(_len - count);
+  }
+
+  void toLowerCase() {
+    for (char *p = begin(); p != end(); ++p) { *p = tolower(*p); }
+  }
+
+  void toUpperCase() {
+    for (char *p = begin(); p != end(); ++p) { *p = toupper(*p); }
+  }
+
+  void trim() {
+    if (_len == 0) { return; }
+    const char *buf   = c_str();
+    const char *begin = buf;
+
+    while (isspace(*begin)) { begin++; }
+    const char *end = buf + _len - 1;
+
+    while (isspace(*end) && end >= begin) { end--; }
+    unsigned int newlen = end + 1 - begin;
+
+    if (begin > buf) { memmove(wbuffer(), begin, newlen); }
+    setLen(newlen);
+  }
+
+  long toInt() const {
+    return atol(c_str());
+  }
+
+  float toFloat() const {
+    return static_cast<float>(atof(c_str()));
+  }
+
+  double toDouble() const {
+    return atof(c_str());
+  }
+
+private:
+
+  // Same small string optimization size as used in the ESP cores on 32-bit.
+  enum { SSO_SIZE = 12 };
+
+  void init() {
+    _heap   = false;
+    _len    = 0;
+    _cap    = 0;
+    _ptr    = nullptr;
+    _sso[0] = 0;
+  }
+
+  void invalidate() {
+    if (_heap) {
+      free(_ptr);
+      bench_count_free();
+    }
+    init();
+  }
+
+  unsigned int capacity() const {
+    return _heap ? _cap : SSO_SIZE - 1;
+  }
+
+  char* wbuffer() {
+    return _heap ? _ptr : _sso;
+  }
+
+  void setLen(unsigned int len) {
+    _len           = len;
+    wbuffer()[len] = 0;
+  }
+
+  bool changeBuffer(unsigned int maxStrLen) {
+    if (maxStrLen < SSO_SIZE) {
+      if (_heap) {
+        char tmp[SSO_SIZE];
+        memcpy(tmp, _ptr, std::min<unsigned int>(_len, maxStrLen) + 1);
+        free(_ptr);
+        bench_count_free();
+        _heap = false;
+        memcpy(_sso, tmp, SSO_SIZE);
+      }
+      return true;
+    }
+
+    // Same rounding as the ESP cores, to mimic their memory usage.
+    const size_t newSize = (maxStrLen + 16) & (~0xf);
+    char *newbuffer      = static_cast<char *>(malloc(newSize));
+
+    if (!newbuffer) { return false; }
+    bench_count_alloc(newSize);
+    memcpy(newbuffer, c_str(), _len + 1);
+
+    if (_heap) {
+      free(_ptr);
+      bench_count_free();
+    }
+    _ptr  = newbuffer;
+    _cap  = newSize - 1;
+    _heap = true;
+    return true;
+  }
+
+  void copy(const char *cstr, unsigned int length) {
+    if (!reserve(length)) {
+      invalidate();
+      return;
+    }
+    memmove(wbuffer(), cstr, length);
+    setLen(length);
+  }
+
+  void move(String& rhs) {
+    invalidate();
+
+    if (rhs._heap) {
+      _heap = true;
+      _ptr  = rhs._ptr;
+      _cap  = rhs._cap;
+      _len  = rhs._len;
+      rhs.init();
+    } else {
+      memcpy(_sso, rhs._sso, SSO_SIZE);
+      _len = rhs._len;
+      rhs.init();
+    }
+  }
+
+  static void toBase(unsigned long value, unsigned char base, char *buf) {
+    char tmp[1 + 8 * sizeof(unsigned long)];
+    int  i = 0;
+
+    if (base < 2) { base = 10; }
+
+    do {
+      const int d = value % base;
+      tmp[i++] = d < 10 ? '0' + d : 'a' + d - 10;
+      value   /= base;
+    } while (value);
+
+    for (int j = 0; j < i; ++j) { buf[j] = tmp[i - 1 - j]; }
+    buf[i] = 0;
+  }
+
+  char        *_ptr;
+  unsigned int _len;
+  unsigned int _cap;
+  bool         _heap;
+  char         _sso[SSO_SIZE];
+};
+
+inline bool String::concat(const char *cstr, unsigned int length) {
+  if (length == 0) { return true; }
+  const unsigned int newlen = _len + length;
+
+  if (!cstr) { return false; }
+
+  // The source may be part of this string.
+  if ((cstr >= c_str()) && (cstr < c_str() + _len)) {
+    const size_t offset = cstr - c_str();
+
+    if (!reserve(newlen)) { return false; }
+    memmove(wbuffer() + _len, c_str() + offset, length);
+  } else {
+    if (!reserve(newlen)) { return false; }
+    memmove(wbuffer() + _len, cstr, length);
+  }
+  setLen(newlen);
+  return true;
+}
+
+inline void String::replace(const String& find, const String& replace) {
+  if ((_len == 0) || (find._len == 0)) { return; }
+  String result;
+  int    index = 0;
+  int    found;
+
+  while ((found = indexOf(find, index)) >= 0) {
+    result.concat(c_str() + index, found - index);
+    result.concat(replace);
+    index = found + find._len;
+  }
+
+  if (index == 0) { return; }
+  result.concat(c_str() + index, _len - index);
+  *this = std::move(result);
+}
+
+class Print {
+public:
+
+  virtual ~Print() {}
+
+  virtual size_t write(uint8_t c) {
+    return 1;
+  }
+
+  virtual size_t write(const uint8_t *buffer, size_t size) {
+    return size;
+  }
+
+  size_t print(const String& s)                  { return s.length(); }
+  size_t print(const char *s)                    { return strlen(s); }
+  size_t print(const __FlashStringHelper *s)     { return strlen(reinterpret_cast<const char *>(s)); }
+  size_t print(char)                             { return 1; }
+  size_t println(const String& s)                { return s.length() + 2; }
+  size_t println(const char *s)                  { return strlen(s) + 2; }
+  size_t println(const __FlashStringHelper *s)   { return strlen(reinterpret_cast<const char *>(s)) + 2; }
+  size_t println()                               { return 2; }
+};
+
+class Stream : public Print {
+public:
+
+  virtual int available() {
+    return 0;
+  }
+
+  virtual int read() {
+    return -1;
+  }
+
+  virtual int peek() {
+    return -1;
+  }
+};
+
+extern const String emptyString;
+
+inline char* dtostrf(double number, signed char width, unsigned char prec, char *s) {
+  sprintf(s, "%*.*f", width, prec, number);
+  return s;
+}
+
+class EspClass {
+public:
+
+  uint32_t getFreeHeap();
+  uint32_t getMaxAllocHeap();
+  uint32_t getCycleCount();
+};
+
+extern EspClass ESP;
+
+inline bool isDigit(int c)         { return isdigit(c); }
+inline bool isAlpha(int c)         { return isalpha(c); }
+inline bool isAlphaNumeric(int c)  { return isalnum(c); }
+inline bool isSpace(int c)         { return isspace(c); }
+inline bool isWhitespace(int c)    { return c == ' ' || c == '\t'; }
+inline bool isPunct(int c)         { return ispunct(c); }
+inline bool isHexadecimalDigit(int c) { return isxdigit(c); }
+inline bool isUpperCase(int c)     { return isupper(c); }
+inline bool isLowerCase(int c)     { return islower(c); }
+inline bool isPrintable(int c)     { return isprint(c); }
+inline bool isAscii(int c)         { return (c & ~0x7f) == 0; }
+
+#endif // ifndef BENCH_STUB_ARDUINO_H
@@ -0,0 +1,5 @@
+#pragma once
+
+#include <ESPEasySerialType.h>
+
+class ESPeasySerial : public Stream {};
@@ -0,0 +1,138 @@
+#pragma once
+
+// Host file system stub for the native rules benchmark.
+// Files are mapped onto a directory on the host, set via bench_fs_set_root().
+
+#include <Arduino.h>
+
+#include <memory>
+
+void        bench_fs_set_root(const char *path);
+std::string bench_fs_path(const char *path);
+
+// Counters maintained by the file system stub.
+extern uint32_t bench_fs_open_count;
+extern uint32_t bench_fs_read_count;
+
+namespace fs {
+enum SeekMode {
+  SeekSet = 0,
+  SeekCur = 1,
+  SeekEnd = 2
+};
+
+class File : public Stream {
+public:
+
+  File() {}
+
+  explicit File(FILE *f, const char *name) : _f(f, [](FILE *p) { fclose(p); }), _name(name) {
+    ++bench_fs_open_count;
+  }
+
+  size_t write(uint8_t c) override {
+    return write(&c, 1);
+  }
+
+  size_t write(const uint8_t *buf, size_t size) override {
+    return _f ? fwrite(buf, 1, size, _f.get()) : 0;
+  }
+
+  int available() override {
+    if (!_f) { return 0; }
+    return static_cast<int>(size() - position());
+  }
+
+  int read() override {
+    if (!_f) { return -1; }
+    ++bench_fs_read_count;
+    return fgetc(_f.get());
+  }
+
+  size_t read(uint8_t *buf, size_t size) {
+    if (!_f) { return 0; }
+    ++bench_fs_read_count;
+    return fread(buf, 1, size, _f.get());
+  }
+
+  int peek() override {
+    if (!_f) { return -1; }
+    const int c = fgetc(_f.get());
+
+    if (c != EOF) { ungetc(c, _f.get()); }
+    return c;
+  }
+
+  bool seek(uint32_t pos, SeekMode mode = SeekSet) {
+    return _f && fseek(_f.get(), pos, mode == SeekSet ? SEEK_SET : (mode == SeekCur ? SEEK_CUR : SEEK_END)) == 0;
+  }
+
+  size_t position() const {
+    return _f ? ftell(_f.get()) : 0;
+  }
+
+  size_t size() const {
+    if (!_f) { return 0; }
+    const long cur = ftell(_f.get());
+    fseek(_f.get(), 0, SEEK_END);
+    const long res = ftell(_f.get());
+    fseek(_f.get(), cur, SEEK_SET);
+    return res;
+  }
+
+  void flush() {
+    if (_f) { fflush(_f.get()); }
+  }
+
+  void close() {
+    _f.reset();
+  }
+
+  const char* name() const {
+    return _name.c_str();
+  }
+
+  explicit operator bool() const {
+    return static_cast<bool>(_f);
+  }
+
+private:
+
+  std::shared_ptr<FILE> _f;
+  String _name;
+};
+
+class FS {
+public:
+
+  File open(const String& path, const char *mode) {
+    FILE *f = fopen(bench_fs_path(path.c_str()).c_str(), mode);
+
+    if (f == nullptr) { return File(); }
+    return File(f, path.c_str());
+  }
+
+  bool exists(const String& path) {
+    FILE *f = fopen(bench_fs_path(path.c_str()).c_str(), "r");
+
+    if (f == nullptr) { return false; }
+    fclose(f);
+    return true;
+  }
+
+  bool remove(const String& path) {
+    return ::remove(bench_fs_path(path.c_str()).c_str()) == 0;
+  }
+
+  bool rename(const String& from, const String& to) {
+    return ::rename(bench_fs_path(from.c_str()).c_str(), bench_fs_path(to.c_str()).c_str()) == 0;
+  }
+};
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+using fs::SeekMode;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Arduino.h>
+
+class IPAddress {
+public:
+
+  IPAddress() : _address(0) {}
+
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+    _bytes[0] = a;
+    _bytes[1] = b;
+    _bytes[2] = c;
+    _bytes[3] = d;
+  }
+
+  IPAddress(uint32_t address) : _address(address) {}
+
+  IPAddress(const uint8_t *address) {
+    memcpy(_bytes, address, 4);
+  }
+
+  operator uint32_t() const {
+    return _address;
+  }
+
+  uint8_t operator[](int index) const {
+    return _bytes[index];
+  }
+
+  uint8_t& operator[](int index) {
+    return _bytes[index];
+  }
+
+  bool fromString(const String& address) {
+    unsigned int a, b, c, d;
+
+    if (sscanf(address.c_str(), "%u.%u.%u.%u", &a, &b, &c, &d) != 4) { return false; }
+    *this = IPAddress(a, b, c, d);
+    return true;
+  }
+
+  String toString() const {
+    char buf[16];
+
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", _bytes[0], _bytes[1], _bytes[2], _bytes[3]);
+    return String(buf);
+  }
+
+private:
+
+  union {
+    uint8_t  _bytes[4];
+    uint32_t _address;
+  };
+};
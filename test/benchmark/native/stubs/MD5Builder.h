@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Not a real MD5 implementation.
+// Only used to detect changes in (cached) settings, so any hash will do.
+class MD5Builder {
+public:
+
+  void begin() {
+    memset(_hash, 0, sizeof(_hash));
+    _pos = 0;
+  }
+
+  void add(const uint8_t *data, uint16_t len) {
+    for (uint16_t i = 0; i < len; ++i) {
+      _hash[_pos % 16] = (_hash[_pos % 16] * 31) ^ data[i];
+      ++_pos;
+    }
+  }
+
+  void add(const char *data) {
+    add(reinterpret_cast<const uint8_t *>(data), strlen(data));
+  }
+
+  void add(const String& data) {
+    add(data.c_str());
+  }
+
+  void calculate() {}
+
+  void getBytes(uint8_t *output) const {
+    memcpy(output, _hash, sizeof(_hash));
+  }
+
+private:
+
+  uint8_t  _hash[16]{};
+  uint32_t _pos = 0;
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <IPAddress.h>
+#include <WiFiClient.h>
+#include <WiFiGeneric.h>
+#include <WiFiUdp.h>
+
+class WiFiClass {
+public:
+
+  String BSSIDstr() {
+    return String(F("00:00:00:00:00:00"));
+  }
+
+  String SSID() {
+    return String(F("bench"));
+  }
+
+  int32_t channel() {
+    return 1;
+  }
+
+  int8_t RSSI() {
+    return -60;
+  }
+};
+
+extern WiFiClass WiFi;
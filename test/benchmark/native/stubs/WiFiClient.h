@@ -0,0 +1,29 @@
+#pragma once
+
+#include <IPAddress.h>
+
+class WiFiClient : public Stream {
+public:
+
+  virtual ~WiFiClient() {}
+
+  int connect(const char *host, uint16_t port) {
+    return 0;
+  }
+
+  int connect(IPAddress ip, uint16_t port) {
+    return 0;
+  }
+
+  uint8_t connected() {
+    return 0;
+  }
+
+  void stop() {}
+
+  void setTimeout(unsigned long) {}
+
+  explicit operator bool() {
+    return false;
+  }
+};
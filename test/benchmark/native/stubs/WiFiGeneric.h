@@ -0,0 +1,13 @@
+#pragma once
+
+#include <Arduino.h>
+
+typedef size_t WiFiEventId_t;
+
+typedef struct {
+  char    cc[3];
+  uint8_t schan;
+  uint8_t nchan;
+  int8_t  max_tx_power;
+  uint8_t policy;
+} wifi_country_t;
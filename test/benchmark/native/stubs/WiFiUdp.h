@@ -0,0 +1,13 @@
+#pragma once
+
+#include <IPAddress.h>
+
+class WiFiUDP : public Stream {
+public:
+
+  uint8_t begin(uint16_t port) {
+    return 0;
+  }
+
+  void stop() {}
+};
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "../hal/gpio_types.h"
+
+#define GPIO_IS_VALID_GPIO(gpio_num)        ((gpio_num >= 0) && (gpio_num < 40))
+#define GPIO_IS_VALID_OUTPUT_GPIO(gpio_num) ((gpio_num >= 0) && (gpio_num < 34))
@@ -0,0 +1,8 @@
+#pragma once
+
+typedef enum {
+  ADC_ATTEN_DB_0   = 0,
+  ADC_ATTEN_DB_2_5 = 1,
+  ADC_ATTEN_DB_6   = 2,
+  ADC_ATTEN_DB_11  = 3,
+} adc_atten_t;
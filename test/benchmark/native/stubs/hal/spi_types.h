@@ -0,0 +1,8 @@
+#pragma once
+
+typedef enum {
+  SPI1_HOST = 0,
+  SPI2_HOST = 1,
+  SPI3_HOST = 2,
+  SPI_HOST_MAX
+} spi_host_device_t;
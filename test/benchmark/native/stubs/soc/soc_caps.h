@@ -0,0 +1,4 @@
+#pragma once
+
+#define SOC_UART_NUM      3
+#define SOC_UART_FIFO_LEN 128